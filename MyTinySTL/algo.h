@@ -2414,7 +2414,8 @@ void unchecked_insertion_sort(RandomIter first, RandomIter last)
 {
   for (auto i = first; i != last; ++i)
   {
-    mystl::unchecked_linear_insert(i, *i);
+    auto value = *i;
+    mystl::unchecked_linear_insert(i, value);
   }
 }
 
@@ -2528,7 +2529,8 @@ void unchecked_insertion_sort(RandomIter first, RandomIter last,
 {
   for (auto i = first; i != last; ++i)
   {
-    mystl::unchecked_linear_insert(i, *i, comp);
+    auto value = *i;
+    mystl::unchecked_linear_insert(i, value, comp);
   }
 }
 
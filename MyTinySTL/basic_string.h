@@ -2051,6 +2051,79 @@ bool operator>=(const basic_string<CharType, CharTraits>& lhs,
   return lhs.compare(rhs) >= 0;
 }
 
+// 与 C 风格字符串比较，不构造临时的 basic_string
+template <class CharType, class CharTraits>
+bool operator==(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+  return lhs.compare(rhs) == 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator!=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+  return lhs.compare(rhs) != 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+  return lhs.compare(rhs) < 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+  return lhs.compare(rhs) <= 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+  return lhs.compare(rhs) > 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>=(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs)
+{
+  return lhs.compare(rhs) >= 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator==(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+  return rhs.compare(lhs) == 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator!=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+  return rhs.compare(lhs) != 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+  return rhs.compare(lhs) > 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator<=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+  return rhs.compare(lhs) >= 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+  return rhs.compare(lhs) < 0;
+}
+
+template <class CharType, class CharTraits>
+bool operator>=(const CharType* lhs, const basic_string<CharType, CharTraits>& rhs)
+{
+  return rhs.compare(lhs) <= 0;
+}
+
 // 重载 mystl 的 swap
 template <class CharType, class CharTraits>
 void swap(basic_string<CharType, CharTraits>& lhs,
@@ -2060,14 +2133,23 @@ void swap(basic_string<CharType, CharTraits>& lhs,
 }
 
 // 特化 mystl::hash
+// 同时接受 C 风格字符串，两者内容相同时哈希值相同，配合 equal_to<void> 可以做异构查找
 template <class CharType, class CharTraits>
 struct hash<basic_string<CharType, CharTraits>>
 {
-  size_t operator()(const basic_string<CharType, CharTraits>& str)
+  typedef int  is_transparent;
+  typedef void is_avalanching;
+
+  size_t operator()(const basic_string<CharType, CharTraits>& str) const
   {
-    return bitwise_hash((const unsigned char*)str.c_str(),
+    return bitwise_hash((const unsigned char*)str.begin(),
                         str.size() * sizeof(CharType));
   }
+  size_t operator()(const CharType* str) const
+  {
+    return bitwise_hash((const unsigned char*)str,
+                        CharTraits::length(str) * sizeof(CharType));
+  }
 };
 
 } // namespace mystl
@@ -0,0 +1,1352 @@
+#ifndef MYTINYSTL_BTREE_H_
+#define MYTINYSTL_BTREE_H_
+
+// 这个头文件包含一个模板类 btree
+// btree : B 树，btree_map / btree_set 的底层机制
+
+// notes:
+//
+// 每个节点连续存放多个元素，节点大小按缓存行设置（默认 256 字节），查找时每层只访问一个节点，
+// 比 rb_tree 每个元素一个节点的方式缓存命中率更高，每个元素的额外空间也更少。
+// 元素同时存放在叶节点与内部节点中，插入总在叶节点进行，节点满时一分为二，中间元素上移；
+// 删除后节点过空时与兄弟节点合并或从兄弟节点借元素。
+// 插入和删除会移动节点内的元素，因此会使所有迭代器失效，erase 返回指向下一元素的迭代器。
+
+#include <initializer_list>
+
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "type_traits.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// B 树节点的目标大小（字节）
+#ifndef BTREE_NODE_BYTES
+#define BTREE_NODE_BYTES 256
+#endif
+
+template <class T> struct btree_node;
+template <class T> struct btree_internal_node;
+
+// btree value traits
+
+template <class T, bool>
+struct btree_value_traits_imp
+{
+  typedef T key_type;
+  typedef T mapped_type;
+  typedef T value_type;
+
+  template <class Ty>
+  static const key_type& get_key(const Ty& value)
+  {
+    return value;
+  }
+
+  template <class Ty>
+  static const value_type& get_value(const Ty& value)
+  {
+    return value;
+  }
+};
+
+template <class T>
+struct btree_value_traits_imp<T, true>
+{
+  typedef typename std::remove_cv<typename T::first_type>::type key_type;
+  typedef typename T::second_type                               mapped_type;
+  typedef T                                                     value_type;
+
+  template <class Ty>
+  static const key_type& get_key(const Ty& value)
+  {
+    return value.first;
+  }
+
+  template <class Ty>
+  static const value_type& get_value(const Ty& value)
+  {
+    return value;
+  }
+};
+
+template <class T>
+struct btree_value_traits
+{
+  static constexpr bool is_map = mystl::is_pair<T>::value;
+
+  typedef btree_value_traits_imp<T, is_map> value_traits_type;
+
+  typedef typename value_traits_type::key_type    key_type;
+  typedef typename value_traits_type::mapped_type mapped_type;
+  typedef typename value_traits_type::value_type  value_type;
+
+  template <class Ty>
+  static const key_type& get_key(const Ty& value)
+  {
+    return value_traits_type::get_key(value);
+  }
+
+  template <class Ty>
+  static const value_type& get_value(const Ty& value)
+  {
+    return value_traits_type::get_value(value);
+  }
+};
+
+// 每个节点最多存放的元素个数，至少为 3
+template <class T>
+struct btree_node_slots
+{
+  static constexpr size_t header = sizeof(void*) * 2;
+  static constexpr size_t value = BTREE_NODE_BYTES >= header + 3 * sizeof(T)
+    ? (BTREE_NODE_BYTES - header) / sizeof(T) : 3;
+  static_assert(value < 65536, "btree node slots must fit in unsigned short");
+};
+
+// btree 的节点设计，叶节点只有元素，内部节点另有 slots + 1 个子节点指针
+
+template <class T>
+struct btree_node
+{
+  typedef btree_node<T>*          node_ptr;
+  typedef btree_internal_node<T>* internal_ptr;
+
+  static constexpr size_t slots = btree_node_slots<T>::value;
+
+  node_ptr       parent;    // 父节点，根节点为 nullptr
+  unsigned short position;  // 在父节点中的下标
+  unsigned short count;     // 元素个数
+  bool           leaf;      // 是否为叶节点
+  alignas(T) unsigned char storage[slots * sizeof(T)];
+
+  T*        value_ptr(size_t i) { return reinterpret_cast<T*>(storage) + i; }
+  T&        value(size_t i)     { return *value_ptr(i); }
+  node_ptr& child(size_t i)     { return static_cast<internal_ptr>(this)->children[i]; }
+
+  // 设置第 i 个子节点，并更新子节点的父节点与下标
+  void set_child(size_t i, node_ptr c)
+  {
+    child(i) = c;
+    c->parent = this;
+    c->position = static_cast<unsigned short>(i);
+  }
+};
+
+template <class T>
+struct btree_internal_node : public btree_node<T>
+{
+  btree_node<T>* children[btree_node<T>::slots + 1];
+};
+
+// btree 的迭代器设计，由节点与节点内的下标组成，end() 为最右叶节点的尾后位置
+
+template <class T>
+struct btree_iterator_base :public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+  typedef btree_node<T>* node_ptr;
+
+  node_ptr node;      // 所在节点
+  int      position;  // 节点内的下标
+
+  btree_iterator_base() :node(nullptr), position(0) {}
+  btree_iterator_base(node_ptr x, int i) :node(x), position(i) {}
+
+  // 使迭代器前进
+  void inc()
+  {
+    if (node->leaf && ++position < node->count)
+      return;
+    if (node->leaf)
+    { // 叶节点已走完，向上找到第一个还有后继元素的祖先
+      btree_iterator_base save = *this;
+      while (position == node->count && node->parent != nullptr)
+      {
+        position = node->position;
+        node = node->parent;
+      }
+      if (position == node->count)  // 已是最后一个元素，回到 end()
+        *this = save;
+    }
+    else
+    { // 内部节点，后继为右子树的最左元素
+      node = node->child(position + 1);
+      while (!node->leaf)
+        node = node->child(0);
+      position = 0;
+    }
+  }
+
+  // 使迭代器后退
+  void dec()
+  {
+    if (node->leaf && --position >= 0)
+      return;
+    if (node->leaf)
+    {
+      btree_iterator_base save = *this;
+      while (position < 0 && node->parent != nullptr)
+      {
+        position = node->position - 1;
+        node = node->parent;
+      }
+      if (position < 0)
+        *this = save;
+    }
+    else
+    { // 内部节点，前驱为左子树的最右元素
+      node = node->child(position);
+      while (!node->leaf)
+        node = node->child(node->count);
+      position = node->count - 1;
+    }
+  }
+
+  bool operator==(const btree_iterator_base& rhs) const
+  { return node == rhs.node && position == rhs.position; }
+  bool operator!=(const btree_iterator_base& rhs) const
+  { return !(*this == rhs); }
+};
+
+template <class T>
+struct btree_const_iterator;
+
+template <class T>
+struct btree_iterator :public btree_iterator_base<T>
+{
+  typedef T                         value_type;
+  typedef T*                        pointer;
+  typedef T&                        reference;
+  typedef btree_node<T>*            node_ptr;
+
+  typedef btree_iterator<T>         iterator;
+  typedef btree_const_iterator<T>   const_iterator;
+  typedef iterator                  self;
+
+  using btree_iterator_base<T>::node;
+  using btree_iterator_base<T>::position;
+
+  // 构造函数
+  btree_iterator() {}
+  btree_iterator(node_ptr x, int i) :btree_iterator_base<T>(x, i) {}
+  btree_iterator(const const_iterator& rhs) :btree_iterator_base<T>(rhs.node, rhs.position) {}
+
+  // 重载操作符
+  reference operator*()  const { return node->value(position); }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    this->inc();
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp(*this);
+    this->inc();
+    return tmp;
+  }
+  self& operator--()
+  {
+    this->dec();
+    return *this;
+  }
+  self operator--(int)
+  {
+    self tmp(*this);
+    this->dec();
+    return tmp;
+  }
+};
+
+template <class T>
+struct btree_const_iterator :public btree_iterator_base<T>
+{
+  typedef T                         value_type;
+  typedef const T*                  pointer;
+  typedef const T&                  reference;
+  typedef btree_node<T>*            node_ptr;
+
+  typedef btree_iterator<T>         iterator;
+  typedef btree_const_iterator<T>   const_iterator;
+  typedef const_iterator            self;
+
+  using btree_iterator_base<T>::node;
+  using btree_iterator_base<T>::position;
+
+  // 构造函数
+  btree_const_iterator() {}
+  btree_const_iterator(node_ptr x, int i) :btree_iterator_base<T>(x, i) {}
+  btree_const_iterator(const iterator& rhs) :btree_iterator_base<T>(rhs.node, rhs.position) {}
+
+  // 重载操作符
+  reference operator*()  const { return node->value(position); }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    this->inc();
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp(*this);
+    this->inc();
+    return tmp;
+  }
+  self& operator--()
+  {
+    this->dec();
+    return *this;
+  }
+  self operator--(int)
+  {
+    self tmp(*this);
+    this->dec();
+    return tmp;
+  }
+};
+
+// 模板类 btree
+// 参数一代表数据类型，参数二代表键值比较类型
+template <class T, class Compare>
+class btree
+{
+public:
+  // btree 的嵌套型别定义
+
+  typedef btree_value_traits<T>                    value_traits;
+
+  typedef btree_node<T>                            node_type;
+  typedef btree_node<T>*                           node_ptr;
+  typedef btree_internal_node<T>                   internal_type;
+  typedef typename value_traits::key_type          key_type;
+  typedef typename value_traits::mapped_type       mapped_type;
+  typedef typename value_traits::value_type        value_type;
+  typedef Compare                                  key_compare;
+
+  typedef mystl::allocator<T>                      allocator_type;
+  typedef mystl::allocator<T>                      data_allocator;
+  typedef mystl::allocator<node_type>              leaf_allocator;
+  typedef mystl::allocator<internal_type>          internal_allocator;
+
+  typedef typename allocator_type::pointer         pointer;
+  typedef typename allocator_type::const_pointer   const_pointer;
+  typedef typename allocator_type::reference       reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::size_type       size_type;
+  typedef typename allocator_type::difference_type difference_type;
+
+  typedef btree_iterator<T>                        iterator;
+  typedef btree_const_iterator<T>                  const_iterator;
+  typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+  static constexpr size_type slots      = node_type::slots;
+  static constexpr size_type min_values = slots / 2;
+
+  allocator_type get_allocator() const { return allocator_type(); }
+  key_compare    key_comp()      const { return key_comp_; }
+
+private:
+  node_ptr    root_;       // 根节点
+  node_ptr    leftmost_;   // 最左叶节点
+  node_ptr    rightmost_;  // 最右叶节点
+  size_type   size_;       // 元素个数
+  key_compare key_comp_;   // 键值比较的准则
+
+public:
+  // 构造、复制、析构函数
+  btree()
+    :root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), key_comp_() {}
+
+  btree(const btree& rhs);
+  btree(btree&& rhs) noexcept;
+
+  btree& operator=(const btree& rhs);
+  btree& operator=(btree&& rhs);
+
+  ~btree() { clear(); }
+
+public:
+  // 迭代器相关操作
+
+  iterator               begin()         noexcept
+  { return iterator(leftmost_, 0); }
+  const_iterator         begin()   const noexcept
+  { return const_iterator(leftmost_, 0); }
+  iterator               end()           noexcept
+  { return iterator(rightmost_, rightmost_ == nullptr ? 0 : rightmost_->count); }
+  const_iterator         end()     const noexcept
+  { return const_iterator(rightmost_, rightmost_ == nullptr ? 0 : rightmost_->count); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关操作
+
+  bool      empty()    const noexcept { return size_ == 0; }
+  size_type size()     const noexcept { return size_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+  // 插入删除相关操作
+
+  // emplace
+
+  template <class ...Args>
+  iterator  emplace_multi(Args&& ...args);
+
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace_unique(Args&& ...args);
+
+  template <class ...Args>
+  iterator  emplace_multi_use_hint(iterator hint, Args&& ...args);
+
+  template <class ...Args>
+  iterator  emplace_unique_use_hint(iterator hint, Args&& ...args);
+
+  // insert
+
+  iterator  insert_multi(const value_type& value);
+  iterator  insert_multi(value_type&& value)
+  {
+    return emplace_multi(mystl::move(value));
+  }
+
+  iterator  insert_multi(iterator hint, const value_type& value)
+  {
+    return emplace_multi_use_hint(hint, value);
+  }
+  iterator  insert_multi(iterator hint, value_type&& value)
+  {
+    return emplace_multi_use_hint(hint, mystl::move(value));
+  }
+
+  template <class InputIterator>
+  void      insert_multi(InputIterator first, InputIterator last)
+  {
+    for (; first != last; ++first)
+      insert_multi(end(), *first);
+  }
+
+  mystl::pair<iterator, bool> insert_unique(const value_type& value);
+  mystl::pair<iterator, bool> insert_unique(value_type&& value)
+  {
+    return emplace_unique(mystl::move(value));
+  }
+
+  iterator  insert_unique(iterator hint, const value_type& value)
+  {
+    return emplace_unique_use_hint(hint, value);
+  }
+  iterator  insert_unique(iterator hint, value_type&& value)
+  {
+    return emplace_unique_use_hint(hint, mystl::move(value));
+  }
+
+  template <class InputIterator>
+  void      insert_unique(InputIterator first, InputIterator last)
+  {
+    for (; first != last; ++first)
+      insert_unique(end(), *first);
+  }
+
+  // erase
+
+  iterator  erase(iterator hint);
+
+  size_type erase_multi(const key_type& key);
+  size_type erase_unique(const key_type& key);
+
+  iterator  erase(iterator first, iterator last);
+
+  void      clear();
+
+  // btree 相关操作
+
+  iterator       find(const key_type& key)
+  {
+    iterator it = lower_bound(key);
+    return (it == end() || key_comp_(key, value_traits::get_key(*it))) ? end() : it;
+  }
+  const_iterator find(const key_type& key) const
+  {
+    const_iterator it = lower_bound(key);
+    return (it == end() || key_comp_(key, value_traits::get_key(*it))) ? end() : it;
+  }
+
+  size_type      count_multi(const key_type& key) const
+  {
+    auto p = equal_range_multi(key);
+    return static_cast<size_type>(mystl::distance(p.first, p.second));
+  }
+  size_type      count_unique(const key_type& key) const
+  {
+    return find(key) != end() ? 1 : 0;
+  }
+
+  iterator       lower_bound(const key_type& key)
+  {
+    auto it = lower_bound_pos(key);
+    return iterator(it.node, it.position);
+  }
+  const_iterator lower_bound(const key_type& key) const
+  {
+    auto it = lower_bound_pos(key);
+    return const_iterator(it.node, it.position);
+  }
+
+  iterator       upper_bound(const key_type& key)
+  {
+    auto it = upper_bound_pos(key);
+    return iterator(it.node, it.position);
+  }
+  const_iterator upper_bound(const key_type& key) const
+  {
+    auto it = upper_bound_pos(key);
+    return const_iterator(it.node, it.position);
+  }
+
+  mystl::pair<iterator, iterator>
+  equal_range_multi(const key_type& key)
+  {
+    return mystl::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+  }
+  mystl::pair<const_iterator, const_iterator>
+  equal_range_multi(const key_type& key) const
+  {
+    return mystl::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+  }
+
+  mystl::pair<iterator, iterator>
+  equal_range_unique(const key_type& key)
+  {
+    iterator it = find(key);
+    auto next = it;
+    return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
+  }
+  mystl::pair<const_iterator, const_iterator>
+  equal_range_unique(const key_type& key) const
+  {
+    const_iterator it = find(key);
+    auto next = it;
+    return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
+  }
+
+  void swap(btree& rhs) noexcept;
+
+private:
+  typedef btree_iterator_base<T> base_iterator;
+
+  // node related
+  node_ptr create_leaf_node();
+  node_ptr create_internal_node();
+  void     destroy_node(node_ptr x);
+  void     erase_since(node_ptr x);
+  node_ptr copy_from(node_ptr x, node_ptr p);
+
+  // 元素在节点间的搬移：在 dst 处移动构造 src 的元素，再析构 src
+  static void move_value(T* dst, T* src)
+  {
+    data_allocator::construct(dst, mystl::move(*src));
+    data_allocator::destroy(src);
+  }
+
+  // search
+  size_type     node_lower_bound(node_ptr x, const key_type& key) const;
+  size_type     node_upper_bound(node_ptr x, const key_type& key) const;
+  base_iterator lower_bound_pos(const key_type& key) const;
+  base_iterator upper_bound_pos(const key_type& key) const;
+
+  // insert
+  template <class ...Args>
+  iterator insert_at(base_iterator pos, Args&& ...args);
+  void     split(base_iterator& pos);
+
+  // erase
+  base_iterator rebalance_after_erase(base_iterator pos);
+  bool          merge_or_rebalance(base_iterator& pos);
+  void          merge_nodes(node_ptr left, node_ptr right);
+  void          rebalance_right_to_left(node_ptr left, node_ptr right, size_type n);
+  void          rebalance_left_to_right(node_ptr left, node_ptr right, size_type n);
+  void          shrink_root();
+};
+
+/*****************************************************************************************/
+
+// 复制构造函数
+template <class T, class Compare>
+btree<T, Compare>::
+btree(const btree& rhs)
+  :root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), key_comp_(rhs.key_comp_)
+{
+  if (rhs.root_ != nullptr)
+  {
+    root_ = copy_from(rhs.root_, nullptr);
+    leftmost_ = root_;
+    while (!leftmost_->leaf)
+      leftmost_ = leftmost_->child(0);
+    rightmost_ = root_;
+    while (!rightmost_->leaf)
+      rightmost_ = rightmost_->child(rightmost_->count);
+    size_ = rhs.size_;
+  }
+}
+
+// 移动构造函数
+template <class T, class Compare>
+btree<T, Compare>::
+btree(btree&& rhs) noexcept
+  :root_(rhs.root_), leftmost_(rhs.leftmost_), rightmost_(rhs.rightmost_),
+  size_(rhs.size_), key_comp_(rhs.key_comp_)
+{
+  rhs.root_ = rhs.leftmost_ = rhs.rightmost_ = nullptr;
+  rhs.size_ = 0;
+}
+
+// 复制赋值操作符
+template <class T, class Compare>
+btree<T, Compare>&
+btree<T, Compare>::
+operator=(const btree& rhs)
+{
+  if (this != &rhs)
+  {
+    btree tmp(rhs);
+    swap(tmp);
+  }
+  return *this;
+}
+
+// 移动赋值操作符
+template <class T, class Compare>
+btree<T, Compare>&
+btree<T, Compare>::
+operator=(btree&& rhs)
+{
+  if (this != &rhs)
+  {
+    clear();
+    swap(rhs);
+  }
+  return *this;
+}
+
+// 就地插入元素，键值允许重复
+template <class T, class Compare>
+template <class ...Args>
+typename btree<T, Compare>::iterator
+btree<T, Compare>::
+emplace_multi(Args&& ...args)
+{
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "btree<T, Comp>'s size too big");
+  value_type value(mystl::forward<Args>(args)...);
+  return insert_at(upper_bound_pos(value_traits::get_key(value)), mystl::move(value));
+}
+
+// 就地插入元素，键值不允许重复
+template <class T, class Compare>
+template <class ...Args>
+mystl::pair<typename btree<T, Compare>::iterator, bool>
+btree<T, Compare>::
+emplace_unique(Args&& ...args)
+{
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "btree<T, Comp>'s size too big");
+  value_type value(mystl::forward<Args>(args)...);
+  auto pos = lower_bound_pos(value_traits::get_key(value));
+  if (pos != end() && !key_comp_(value_traits::get_key(value),
+                                 value_traits::get_key(pos.node->value(pos.position))))
+  { // 键值已存在
+    return mystl::make_pair(iterator(pos.node, pos.position), false);
+  }
+  return mystl::make_pair(insert_at(pos, mystl::move(value)), true);
+}
+
+// 就地插入元素，键值允许重复，若 hint 正好是插入位置则不再查找
+template <class T, class Compare>
+template <class ...Args>
+typename btree<T, Compare>::iterator
+btree<T, Compare>::
+emplace_multi_use_hint(iterator hint, Args&& ...args)
+{
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "btree<T, Comp>'s size too big");
+  value_type value(mystl::forward<Args>(args)...);
+  const key_type& key = value_traits::get_key(value);
+  auto before = hint;
+  if ((hint == end() || !key_comp_(value_traits::get_key(*hint), key)) &&
+      (hint == begin() || !key_comp_(key, value_traits::get_key(*--before))))
+  { // prev <= value <= hint
+    return insert_at(hint, mystl::move(value));
+  }
+  return insert_at(upper_bound_pos(key), mystl::move(value));
+}
+
+// 就地插入元素，键值不允许重复，若 hint 正好是插入位置则不再查找
+template <class T, class Compare>
+template <class ...Args>
+typename btree<T, Compare>::iterator
+btree<T, Compare>::
+emplace_unique_use_hint(iterator hint, Args&& ...args)
+{
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "btree<T, Comp>'s size too big");
+  value_type value(mystl::forward<Args>(args)...);
+  const key_type& key = value_traits::get_key(value);
+  auto before = hint;
+  if ((hint == end() || key_comp_(key, value_traits::get_key(*hint))) &&
+      (hint == begin() || key_comp_(value_traits::get_key(*--before), key)))
+  { // prev < value < hint
+    return insert_at(hint, mystl::move(value));
+  }
+  auto pos = lower_bound_pos(key);
+  if (pos != end() && !key_comp_(key, value_traits::get_key(pos.node->value(pos.position))))
+    return iterator(pos.node, pos.position);
+  return insert_at(pos, mystl::move(value));
+}
+
+// 插入元素，节点键值允许重复
+template <class T, class Compare>
+typename btree<T, Compare>::iterator
+btree<T, Compare>::
+insert_multi(const value_type& value)
+{
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "btree<T, Comp>'s size too big");
+  return insert_at(upper_bound_pos(value_traits::get_key(value)), value);
+}
+
+// 插入新值，节点键值不允许重复，返回一个 pair，若插入成功，pair 的第二参数为 true，否则为 false
+template <class T, class Compare>
+mystl::pair<typename btree<T, Compare>::iterator, bool>
+btree<T, Compare>::
+insert_unique(const value_type& value)
+{
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "btree<T, Comp>'s size too big");
+  auto pos = lower_bound_pos(value_traits::get_key(value));
+  if (pos != end() && !key_comp_(value_traits::get_key(value),
+                                 value_traits::get_key(pos.node->value(pos.position))))
+  {
+    return mystl::make_pair(iterator(pos.node, pos.position), false);
+  }
+  return mystl::make_pair(insert_at(pos, value), true);
+}
+
+// 删除 hint 位置的元素，返回指向下一元素的迭代器
+template <class T, class Compare>
+typename btree<T, Compare>::iterator
+btree<T, Compare>::
+erase(iterator hint)
+{
+  MYSTL_DEBUG(hint != end());
+  base_iterator pos(hint.node, hint.position);
+  const bool internal = !pos.node->leaf;
+  if (internal)
+  { // 内部节点的元素用左子树的最大元素（一定在叶节点中）顶替，转为删除叶节点的元素
+    base_iterator target = pos;
+    pos.dec();
+    data_allocator::destroy(target.node->value_ptr(target.position));
+    move_value(target.node->value_ptr(target.position), pos.node->value_ptr(pos.position));
+  }
+  else
+  {
+    data_allocator::destroy(pos.node->value_ptr(pos.position));
+  }
+  // 叶节点中 pos 之后的元素左移
+  node_ptr x = pos.node;
+  for (size_type i = pos.position + 1; i < x->count; ++i)
+    move_value(x->value_ptr(i - 1), x->value_ptr(i));
+  --x->count;
+  --size_;
+
+  pos = rebalance_after_erase(pos);
+  if (internal)  // 此时 pos 指向顶替上去的前驱元素
+    pos.inc();
+  return iterator(pos.node, pos.position);
+}
+
+// 删除键值等于 key 的元素，返回删除的个数
+template <class T, class Compare>
+typename btree<T, Compare>::size_type
+btree<T, Compare>::
+erase_multi(const key_type& key)
+{
+  auto p = equal_range_multi(key);
+  size_type n = mystl::distance(p.first, p.second);
+  erase(p.first, p.second);
+  return n;
+}
+
+// 删除键值等于 key 的元素，返回删除的个数
+template <class T, class Compare>
+typename btree<T, Compare>::size_type
+btree<T, Compare>::
+erase_unique(const key_type& key)
+{
+  auto it = find(key);
+  if (it != end())
+  {
+    erase(it);
+    return 1;
+  }
+  return 0;
+}
+
+// 删除[first, last)区间内的元素，删除会使 last 失效，因此按个数删除
+template <class T, class Compare>
+typename btree<T, Compare>::iterator
+btree<T, Compare>::
+erase(iterator first, iterator last)
+{
+  if (first == begin() && last == end())
+  {
+    clear();
+    return end();
+  }
+  for (size_type n = mystl::distance(first, last); n > 0; --n)
+    first = erase(first);
+  return first;
+}
+
+// 清空 btree
+template <class T, class Compare>
+void btree<T, Compare>::
+clear()
+{
+  if (root_ != nullptr)
+  {
+    erase_since(root_);
+    root_ = leftmost_ = rightmost_ = nullptr;
+    size_ = 0;
+  }
+}
+
+// 交换 btree
+template <class T, class Compare>
+void btree<T, Compare>::
+swap(btree& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    mystl::swap(root_, rhs.root_);
+    mystl::swap(leftmost_, rhs.leftmost_);
+    mystl::swap(rightmost_, rhs.rightmost_);
+    mystl::swap(size_, rhs.size_);
+    mystl::swap(key_comp_, rhs.key_comp_);
+  }
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 创建一个空的叶节点
+template <class T, class Compare>
+typename btree<T, Compare>::node_ptr
+btree<T, Compare>::
+create_leaf_node()
+{
+  node_ptr x = leaf_allocator::allocate(1);
+  x->parent = nullptr;
+  x->position = 0;
+  x->count = 0;
+  x->leaf = true;
+  return x;
+}
+
+// 创建一个空的内部节点
+template <class T, class Compare>
+typename btree<T, Compare>::node_ptr
+btree<T, Compare>::
+create_internal_node()
+{
+  node_ptr x = internal_allocator::allocate(1);
+  x->parent = nullptr;
+  x->position = 0;
+  x->count = 0;
+  x->leaf = false;
+  return x;
+}
+
+// 析构节点内的元素并释放节点
+template <class T, class Compare>
+void btree<T, Compare>::
+destroy_node(node_ptr x)
+{
+  data_allocator::destroy(x->value_ptr(0), x->value_ptr(x->count));
+  if (x->leaf)
+    leaf_allocator::deallocate(x);
+  else
+    internal_allocator::deallocate(static_cast<internal_type*>(x));
+}
+
+// 删除以 x 为根的子树
+template <class T, class Compare>
+void btree<T, Compare>::
+erase_since(node_ptr x)
+{
+  if (!x->leaf)
+  {
+    for (size_type i = 0; i <= x->count; ++i)
+      erase_since(x->child(i));
+  }
+  destroy_node(x);
+}
+
+// 复制以 x 为根的子树，p 为新子树的父节点
+template <class T, class Compare>
+typename btree<T, Compare>::node_ptr
+btree<T, Compare>::
+copy_from(node_ptr x, node_ptr p)
+{
+  node_ptr y = x->leaf ? create_leaf_node() : create_internal_node();
+  y->parent = p;
+  y->position = x->position;
+  size_type children = 0;
+  try
+  {
+    for (; y->count < x->count; ++y->count)
+      data_allocator::construct(y->value_ptr(y->count), x->value(y->count));
+    if (!x->leaf)
+    {
+      for (; children <= x->count; ++children)
+        y->child(children) = copy_from(x->child(children), y);
+    }
+  }
+  catch (...)
+  {
+    for (size_type i = 0; i < children; ++i)
+      erase_since(y->child(i));
+    destroy_node(y);
+    throw;
+  }
+  return y;
+}
+
+// 在节点 x 内二分查找第一个不小于 key 的位置
+template <class T, class Compare>
+typename btree<T, Compare>::size_type
+btree<T, Compare>::
+node_lower_bound(node_ptr x, const key_type& key) const
+{
+  size_type lo = 0, hi = x->count;
+  while (lo < hi)
+  {
+    const size_type mid = (lo + hi) / 2;
+    if (key_comp_(value_traits::get_key(x->value(mid)), key))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// 在节点 x 内二分查找第一个大于 key 的位置
+template <class T, class Compare>
+typename btree<T, Compare>::size_type
+btree<T, Compare>::
+node_upper_bound(node_ptr x, const key_type& key) const
+{
+  size_type lo = 0, hi = x->count;
+  while (lo < hi)
+  {
+    const size_type mid = (lo + hi) / 2;
+    if (key_comp_(key, value_traits::get_key(x->value(mid))))
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+// 从根节点向下查找，每层记录节点内的 lower_bound，最深一层有效的位置即为结果
+template <class T, class Compare>
+typename btree<T, Compare>::base_iterator
+btree<T, Compare>::
+lower_bound_pos(const key_type& key) const
+{
+  if (root_ == nullptr)
+    return base_iterator();
+  base_iterator res(rightmost_, rightmost_->count);
+  node_ptr x = root_;
+  for (;;)
+  {
+    const size_type i = node_lower_bound(x, key);
+    if (i < x->count)
+      res = base_iterator(x, static_cast<int>(i));
+    if (x->leaf)
+      break;
+    x = x->child(i);
+  }
+  return res;
+}
+
+template <class T, class Compare>
+typename btree<T, Compare>::base_iterator
+btree<T, Compare>::
+upper_bound_pos(const key_type& key) const
+{
+  if (root_ == nullptr)
+    return base_iterator();
+  base_iterator res(rightmost_, rightmost_->count);
+  node_ptr x = root_;
+  for (;;)
+  {
+    const size_type i = node_upper_bound(x, key);
+    if (i < x->count)
+      res = base_iterator(x, static_cast<int>(i));
+    if (x->leaf)
+      break;
+    x = x->child(i);
+  }
+  return res;
+}
+
+// 在 pos 之前插入元素，pos 位于内部节点时改为插在其前驱（一定在叶节点中）之后
+template <class T, class Compare>
+template <class ...Args>
+typename btree<T, Compare>::iterator
+btree<T, Compare>::
+insert_at(base_iterator pos, Args&& ...args)
+{
+  if (root_ == nullptr)
+  {
+    root_ = leftmost_ = rightmost_ = create_leaf_node();
+    pos = base_iterator(root_, 0);
+  }
+  else if (!pos.node->leaf)
+  {
+    pos.dec();
+    ++pos.position;
+  }
+  if (pos.node->count == slots)
+    split(pos);
+
+  node_ptr x = pos.node;
+  const size_type i = pos.position;
+  if (i == x->count)
+  {
+    data_allocator::construct(x->value_ptr(i), mystl::forward<Args>(args)...);
+  }
+  else
+  {
+    value_type tmp(mystl::forward<Args>(args)...);
+    for (size_type j = x->count; j > i; --j)
+      move_value(x->value_ptr(j), x->value_ptr(j - 1));
+    data_allocator::construct(x->value_ptr(i), mystl::move(tmp));
+  }
+  ++x->count;
+  ++size_;
+  return iterator(pos.node, pos.position);
+}
+
+// 拆分 pos 所在的满节点，中间元素上移到父节点，并调整 pos 使其仍指向插入位置
+// 插入点在节点首尾时不均分，使顺序插入得到的节点接近全满
+template <class T, class Compare>
+void btree<T, Compare>::
+split(base_iterator& pos)
+{
+  node_ptr x = pos.node;
+  if (x->parent == nullptr)
+  { // 拆分根节点，树高加一
+    node_ptr r = create_internal_node();
+    r->set_child(0, x);
+    root_ = r;
+  }
+  else if (x->parent->count == slots)
+  { // 父节点也满了，先拆分父节点
+    base_iterator ppos(x->parent, x->position);
+    split(ppos);
+  }
+
+  size_type rcount;  // 移到新节点的元素个数
+  if (pos.position == 0)
+    rcount = slots - 1;
+  else if (pos.position == static_cast<int>(slots))
+    rcount = 0;
+  else
+    rcount = slots / 2;
+  const size_type lcount = slots - rcount;  // 含上移的中间元素
+
+  node_ptr y = x->leaf ? create_leaf_node() : create_internal_node();
+  for (size_type i = 0; i < rcount; ++i)
+    move_value(y->value_ptr(i), x->value_ptr(lcount + i));
+  if (!x->leaf)
+  {
+    for (size_type i = 0; i <= rcount; ++i)
+      y->set_child(i, x->child(lcount + i));
+  }
+  y->count = static_cast<unsigned short>(rcount);
+  x->count = static_cast<unsigned short>(lcount - 1);
+
+  // 中间元素与新节点插入父节点
+  node_ptr p = x->parent;
+  const size_type at = x->position;
+  for (size_type i = p->count; i > at; --i)
+  {
+    move_value(p->value_ptr(i), p->value_ptr(i - 1));
+    p->set_child(i + 1, p->child(i));
+  }
+  move_value(p->value_ptr(at), x->value_ptr(lcount - 1));
+  p->set_child(at + 1, y);
+  ++p->count;
+
+  if (x == rightmost_)
+    rightmost_ = y;
+  if (pos.position > x->count)
+  {
+    pos.node = y;
+    pos.position -= x->count + 1;
+  }
+}
+
+// 删除元素后自下而上修复过空的节点，返回被删元素之后的位置
+template <class T, class Compare>
+typename btree<T, Compare>::base_iterator
+btree<T, Compare>::
+rebalance_after_erase(base_iterator pos)
+{
+  base_iterator res = pos;
+  bool first = true;
+  for (;;)
+  {
+    if (pos.node == root_)
+    {
+      shrink_root();
+      if (root_ == nullptr)
+        return base_iterator();
+      break;
+    }
+    if (pos.node->count >= min_values)
+      break;
+    const bool merged = merge_or_rebalance(pos);
+    if (first)
+    { // 第一轮调整的是叶节点，res 随之更新
+      res = pos;
+      first = false;
+    }
+    if (!merged)
+      break;
+    pos = base_iterator(pos.node->parent, pos.node->position);
+  }
+  if (res.position == res.node->count)
+  { // 指向节点尾后，前进到下一元素
+    --res.position;
+    res.inc();
+  }
+  return res;
+}
+
+// 与兄弟节点合并，或从兄弟节点借元素，返回是否发生了合并
+template <class T, class Compare>
+bool btree<T, Compare>::
+merge_or_rebalance(base_iterator& pos)
+{
+  node_ptr x = pos.node;
+  node_ptr p = x->parent;
+  if (x->position > 0)
+  { // 尝试与左兄弟合并
+    node_ptr left = p->child(x->position - 1);
+    if (static_cast<size_type>(left->count) + x->count + 1 <= slots)
+    {
+      pos.position += 1 + left->count;
+      merge_nodes(left, x);
+      pos.node = left;
+      return true;
+    }
+  }
+  if (x->position < p->count)
+  {
+    node_ptr right = p->child(x->position + 1);
+    if (static_cast<size_type>(x->count) + right->count + 1 <= slots)
+    { // 尝试与右兄弟合并
+      merge_nodes(x, right);
+      return true;
+    }
+    if (right->count > min_values)
+    { // 从右兄弟借元素
+      size_type n = (right->count - x->count) / 2;
+      n = mystl::min(n, static_cast<size_type>(right->count - 1));
+      rebalance_right_to_left(x, right, n);
+      return false;
+    }
+  }
+  if (x->position > 0)
+  {
+    node_ptr left = p->child(x->position - 1);
+    if (left->count > min_values)
+    { // 从左兄弟借元素
+      size_type n = (left->count - x->count) / 2;
+      n = mystl::min(n, static_cast<size_type>(left->count - 1));
+      rebalance_left_to_right(left, x, n);
+      pos.position += static_cast<int>(n);
+      return false;
+    }
+  }
+  return false;
+}
+
+// 把父节点中的分隔元素与 right 的全部内容并入 left，并释放 right
+template <class T, class Compare>
+void btree<T, Compare>::
+merge_nodes(node_ptr left, node_ptr right)
+{
+  node_ptr p = left->parent;
+  const size_type at = left->position;
+  const size_type lcount = left->count;
+  move_value(left->value_ptr(lcount), p->value_ptr(at));
+  for (size_type i = 0; i < right->count; ++i)
+    move_value(left->value_ptr(lcount + 1 + i), right->value_ptr(i));
+  if (!left->leaf)
+  {
+    for (size_type i = 0; i <= right->count; ++i)
+      left->set_child(lcount + 1 + i, right->child(i));
+  }
+  left->count = static_cast<unsigned short>(lcount + 1 + right->count);
+
+  // 从父节点中移除分隔元素与 right
+  for (size_type i = at + 1; i < p->count; ++i)
+  {
+    move_value(p->value_ptr(i - 1), p->value_ptr(i));
+    p->set_child(i, p->child(i + 1));
+  }
+  --p->count;
+
+  if (right == rightmost_)
+    rightmost_ = left;
+  right->count = 0;
+  destroy_node(right);
+}
+
+// 经由父节点把 right 的前 n 个元素移到 left 的尾部
+template <class T, class Compare>
+void btree<T, Compare>::
+rebalance_right_to_left(node_ptr left, node_ptr right, size_type n)
+{
+  node_ptr p = left->parent;
+  const size_type at = left->position;
+  const size_type lcount = left->count;
+  move_value(left->value_ptr(lcount), p->value_ptr(at));
+  for (size_type i = 0; i + 1 < n; ++i)
+    move_value(left->value_ptr(lcount + 1 + i), right->value_ptr(i));
+  move_value(p->value_ptr(at), right->value_ptr(n - 1));
+  for (size_type i = n; i < right->count; ++i)
+    move_value(right->value_ptr(i - n), right->value_ptr(i));
+  if (!left->leaf)
+  {
+    for (size_type i = 0; i < n; ++i)
+      left->set_child(lcount + 1 + i, right->child(i));
+    for (size_type i = n; i <= right->count; ++i)
+      right->set_child(i - n, right->child(i));
+  }
+  left->count = static_cast<unsigned short>(lcount + n);
+  right->count = static_cast<unsigned short>(right->count - n);
+}
+
+// 经由父节点把 left 的后 n 个元素移到 right 的头部
+template <class T, class Compare>
+void btree<T, Compare>::
+rebalance_left_to_right(node_ptr left, node_ptr right, size_type n)
+{
+  node_ptr p = left->parent;
+  const size_type at = left->position;
+  const size_type lcount = left->count;
+  for (size_type i = right->count; i > 0; --i)
+    move_value(right->value_ptr(i - 1 + n), right->value_ptr(i - 1));
+  move_value(right->value_ptr(n - 1), p->value_ptr(at));
+  for (size_type i = 0; i + 1 < n; ++i)
+    move_value(right->value_ptr(i), left->value_ptr(lcount - n + 1 + i));
+  move_value(p->value_ptr(at), left->value_ptr(lcount - n));
+  if (!left->leaf)
+  {
+    for (size_type i = right->count + 1; i > 0; --i)
+      right->set_child(i - 1 + n, right->child(i - 1));
+    for (size_type i = 0; i < n; ++i)
+      right->set_child(i, left->child(lcount - n + 1 + i));
+  }
+  left->count = static_cast<unsigned short>(lcount - n);
+  right->count = static_cast<unsigned short>(right->count + n);
+}
+
+// 根节点为空时降低树高，树为空时释放根节点
+template <class T, class Compare>
+void btree<T, Compare>::
+shrink_root()
+{
+  if (root_->count != 0)
+    return;
+  node_ptr old = root_;
+  if (old->leaf)
+  {
+    root_ = leftmost_ = rightmost_ = nullptr;
+  }
+  else
+  {
+    root_ = old->child(0);
+    root_->parent = nullptr;
+    root_->position = 0;
+  }
+  destroy_node(old);
+}
+
+// 重载比较操作符
+template <class T, class Compare>
+bool operator==(const btree<T, Compare>& lhs, const btree<T, Compare>& rhs)
+{
+  return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Compare>
+bool operator<(const btree<T, Compare>& lhs, const btree<T, Compare>& rhs)
+{
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Compare>
+bool operator!=(const btree<T, Compare>& lhs, const btree<T, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class T, class Compare>
+bool operator>(const btree<T, Compare>& lhs, const btree<T, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class T, class Compare>
+bool operator<=(const btree<T, Compare>& lhs, const btree<T, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class T, class Compare>
+bool operator>=(const btree<T, Compare>& lhs, const btree<T, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T, class Compare>
+void swap(btree<T, Compare>& lhs, btree<T, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_BTREE_H_
+
@@ -0,0 +1,926 @@
+#ifndef MYTINYSTL_CONCURRENT_MAP_H_
+#define MYTINYSTL_CONCURRENT_MAP_H_
+
+// 这个头文件包含一个模板类 concurrent_map
+// concurrent_map : 可供多个线程同时读写的映射，底层为跳表，键值不允许重复
+
+// notes:
+//
+// concurrent_map 采用 lazy skip list：查找与遍历不加锁，插入与删除只锁住待修改位置在各层的前驱，
+// 因此不同位置上的写操作可以并行进行，不会像全局互斥锁那样把所有写线程串行化
+// 删除分两步：先在节点上打删除标记（逻辑删除），再把它从各层链表中摘下（物理删除）
+// 被摘下的节点可能仍被其它线程访问，所以不会立即释放，而是按基于 epoch 的方式回收：
+//   * 每个操作在执行期间登记自己所处的全局 epoch，guard 对象可以把登记延长到它的整个生命期
+//   * 被摘下的节点按摘下时的 epoch 放入三个回收链表之一
+//   * 每删除 CONCURRENT_MAP_RECLAIM_INTERVAL 个元素尝试推进一次全局 epoch，
+//     只有所有登记中的线程都处于当前 epoch 时才能推进，推进后释放两个 epoch 之前摘下的节点
+// 因此持续删除的长期共享容器占用的内存有界；长时间持有 guard 的线程会推迟回收
+//
+// 迭代器按键值升序遍历并跳过已删除的元素，但它不是某一时刻的快照：
+// 遍历期间其它线程插入或删除的元素可能被看到，也可能看不到
+// 元素被删除后，指向它的迭代器与引用只在持有 guard 期间保持有效，
+// 所以有其它线程可能删除元素时，遍历或保存迭代器、引用需要在同一线程持有 guard：
+//   { concurrent_map<K, T>::guard g(m); for (auto& x : m) ...; }
+//
+// 线程安全：
+//   * 以下函数可以被多个线程同时调用：
+//     insert, emplace, erase, find, count, contains, lower_bound, upper_bound,
+//     begin, end, size, empty 以及迭代器的遍历
+//   * reclaim, clear, swap 与析构要求此时没有其它线程访问容器
+//   * 容器只保证自身结构的正确，多个线程同时修改同一元素的 mapped 值需要调用者自行同步
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <new>
+#include <initializer_list>
+
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// 跳表的最大层数，每个节点以 1/4 的概率比前一层多一层，默认值足以容纳上亿个元素
+#ifndef CONCURRENT_MAP_MAX_LEVEL
+#define CONCURRENT_MAP_MAX_LEVEL 16
+#endif
+
+// 每删除多少个元素尝试推进一次 epoch 并回收节点，没有线程长期持有 guard 时，
+// 等待释放的节点数大约不超过它的三倍
+#ifndef CONCURRENT_MAP_RECLAIM_INTERVAL
+#define CONCURRENT_MAP_RECLAIM_INTERVAL 64
+#endif
+
+// concurrent_map 的节点
+// 各层的 next 指针紧跟在节点之后存放，个数等于 top_level；头节点不构造 value
+template <class T>
+struct concurrent_map_node
+{
+  typedef concurrent_map_node<T>*  node_ptr;
+  typedef std::atomic<node_ptr>    link_type;
+
+  union { T value; };
+  node_ptr          retired_next;  // 回收链表中的下一个节点
+  int               top_level;     // 节点的层数
+  std::atomic<bool> marked;        // 是否已被逻辑删除
+  std::atomic<bool> fully_linked;  // 是否已接入所有层
+  std::atomic<bool> locked;
+
+  explicit concurrent_map_node(int level) noexcept
+    :retired_next(nullptr), top_level(level), marked(false), fully_linked(false), locked(false)
+  {
+    for (int i = 0; i < level; ++i)
+      ::new (static_cast<void*>(next() + i)) link_type(nullptr);
+  }
+  ~concurrent_map_node() {}
+
+  link_type* next() noexcept
+  {
+    return reinterpret_cast<link_type*>(this + 1);
+  }
+
+  // 节点已完整插入且没有被删除
+  bool is_live() const noexcept
+  {
+    return fully_linked.load(std::memory_order_acquire) &&
+          !marked.load(std::memory_order_acquire);
+  }
+
+  // 自旋锁，争用时让出时间片
+  void lock() noexcept
+  {
+    while (locked.exchange(true, std::memory_order_acquire))
+    {
+      while (locked.load(std::memory_order_relaxed))
+        std::this_thread::yield();
+    }
+  }
+  void unlock() noexcept
+  {
+    locked.store(false, std::memory_order_release);
+  }
+
+  // 从 p 开始找到第一个有效节点
+  static node_ptr first_live(node_ptr p) noexcept
+  {
+    while (p != nullptr && !p->is_live())
+      p = p->next()[0].load(std::memory_order_acquire);
+    return p;
+  }
+};
+
+// concurrent_map 的迭代器，只能前进
+template <class T>
+struct concurrent_map_iterator_base :public mystl::iterator<mystl::forward_iterator_tag, T>
+{
+  typedef concurrent_map_node<T>*  node_ptr;
+
+  node_ptr node;  // 指向节点本身，为 nullptr 时表示 end
+
+  concurrent_map_iterator_base() :node(nullptr) {}
+
+  // 使迭代器前进，跳过已删除的节点
+  void inc()
+  {
+    node = concurrent_map_node<T>::first_live(node->next()[0].load(std::memory_order_acquire));
+  }
+
+  bool operator==(const concurrent_map_iterator_base& rhs) const { return node == rhs.node; }
+  bool operator!=(const concurrent_map_iterator_base& rhs) const { return node != rhs.node; }
+};
+
+template <class T>
+struct concurrent_map_const_iterator;
+
+template <class T>
+struct concurrent_map_iterator :public concurrent_map_iterator_base<T>
+{
+  typedef T                                   value_type;
+  typedef T*                                  pointer;
+  typedef T&                                  reference;
+  typedef concurrent_map_node<T>*             node_ptr;
+  typedef concurrent_map_iterator<T>          self;
+
+  using concurrent_map_iterator_base<T>::node;
+
+  // 构造函数
+  concurrent_map_iterator() {}
+  concurrent_map_iterator(node_ptr x) { node = x; }
+
+  // 重载操作符
+  reference operator*()  const { return node->value; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    this->inc();
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp(*this);
+    this->inc();
+    return tmp;
+  }
+};
+
+template <class T>
+struct concurrent_map_const_iterator :public concurrent_map_iterator_base<T>
+{
+  typedef T                                   value_type;
+  typedef const T*                            pointer;
+  typedef const T&                            reference;
+  typedef concurrent_map_node<T>*             node_ptr;
+  typedef concurrent_map_const_iterator<T>    self;
+
+  using concurrent_map_iterator_base<T>::node;
+
+  // 构造函数
+  concurrent_map_const_iterator() {}
+  concurrent_map_const_iterator(node_ptr x) { node = x; }
+  concurrent_map_const_iterator(const concurrent_map_iterator<T>& rhs) { node = rhs.node; }
+
+  // 重载操作符
+  reference operator*()  const { return node->value; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    this->inc();
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp(*this);
+    this->inc();
+    return tmp;
+  }
+};
+
+// 模板类 concurrent_map，键值不允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl::less
+template <class Key, class T, class Compare = mystl::less<Key>>
+class concurrent_map
+{
+public:
+  // concurrent_map 的型别定义
+  typedef Key                        key_type;
+  typedef T                          mapped_type;
+  typedef mystl::pair<const Key, T>  value_type;
+  typedef Compare                    key_compare;
+
+  typedef value_type*                        pointer;
+  typedef const value_type*                  const_pointer;
+  typedef value_type&                        reference;
+  typedef const value_type&                  const_reference;
+  typedef concurrent_map_iterator<value_type>       iterator;
+  typedef concurrent_map_const_iterator<value_type> const_iterator;
+  typedef size_t                             size_type;
+  typedef ptrdiff_t                          difference_type;
+  typedef mystl::allocator<value_type>       allocator_type;
+
+private:
+  typedef concurrent_map_node<value_type>    node_type;
+  typedef node_type*                         node_ptr;
+
+  static constexpr int max_level = CONCURRENT_MAP_MAX_LEVEL;
+
+  // 一个线程的 epoch 登记，登记表只增不减，随容器析构释放
+  struct epoch_record
+  {
+    std::atomic<uint64_t> epoch;  // 登记时的全局 epoch 加一，0 表示未登记
+    std::atomic<bool>     used;   // 是否正被某个 guard 占用
+    epoch_record*         next;
+
+    epoch_record() noexcept :epoch(0), used(true), next(nullptr) {}
+  };
+
+public:
+  // 在生命期内登记当前线程，期间读到的节点、迭代器与引用不会被回收
+  class guard
+  {
+  public:
+    explicit guard(const concurrent_map& m) noexcept
+      :record_(m.enter()) {}
+    ~guard() { concurrent_map::leave(record_); }
+
+    guard(const guard&) = delete;
+    guard& operator=(const guard&) = delete;
+
+  private:
+    friend class concurrent_map;
+    epoch_record* record_;
+  };
+
+private:
+  node_ptr                       head_;         // 头节点，拥有全部 max_level 层
+  std::atomic<node_ptr>          retired_[3];   // 按摘下时的 epoch 存放的待释放节点
+  std::atomic<size_type>         retired_size_; // 待释放的节点数
+  std::atomic<size_type>         retire_tick_;  // 累计摘下的节点数，用于决定何时尝试回收
+  std::atomic<uint64_t>          epoch_;        // 全局 epoch
+  mutable std::atomic<epoch_record*> records_;  // 登记表
+  std::atomic<bool>              reclaiming_;   // 是否有线程正在推进 epoch
+  uint64_t                       id_;           // 容器的编号，不会重复，用于线程缓存登记
+  std::atomic<size_type>         size_;
+  key_compare                    comp_;
+
+public:
+  // 构造、析构函数
+  concurrent_map()
+    :head_(create_node(max_level)), retired_size_(0), retire_tick_(0), epoch_(0),
+     records_(nullptr), reclaiming_(false), id_(next_id()), size_(0), comp_()
+  {
+    for (auto& r : retired_)
+      r.store(nullptr, std::memory_order_relaxed);
+  }
+
+  template <class InputIterator>
+  concurrent_map(InputIterator first, InputIterator last)
+    :concurrent_map()
+  {
+    insert(first, last);
+  }
+
+  concurrent_map(std::initializer_list<value_type> ilist)
+    :concurrent_map()
+  {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // 多个线程共享的容器不需要复制，也不宜移动
+  concurrent_map(const concurrent_map&) = delete;
+  concurrent_map& operator=(const concurrent_map&) = delete;
+
+  ~concurrent_map()
+  {
+    clear();
+    destroy_node(head_);
+    for (auto r = records_.load(std::memory_order_acquire); r != nullptr; )
+    {
+      auto next = r->next;
+      delete r;
+      r = next;
+    }
+  }
+
+public:
+  // 相关接口
+  key_compare    key_comp()      const { return comp_; }
+  allocator_type get_allocator() const { return allocator_type(); }
+
+  // 迭代器相关
+  iterator       begin()         noexcept
+  {
+    guard g(*this);
+    return iterator(node_type::first_live(head_->next()[0].load(std::memory_order_acquire)));
+  }
+  const_iterator begin()   const noexcept
+  {
+    guard g(*this);
+    return const_iterator(node_type::first_live(head_->next()[0].load(std::memory_order_acquire)));
+  }
+  iterator       end()           noexcept
+  { return iterator(nullptr); }
+  const_iterator end()     const noexcept
+  { return const_iterator(nullptr); }
+
+  const_iterator cbegin()  const noexcept
+  { return begin(); }
+  const_iterator cend()    const noexcept
+  { return end(); }
+
+  // 容量相关，有其它线程同时修改时，结果只是某一时刻的近似值
+  bool      empty()    const noexcept { return size() == 0; }
+  size_type size()     const noexcept { return size_.load(std::memory_order_relaxed); }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(node_type); }
+
+  // 非标准接口：已删除、尚未释放的节点数
+  size_type retired_size() const noexcept
+  { return retired_size_.load(std::memory_order_relaxed); }
+
+  // 插入删除操作
+
+  template <class ...Args>
+  pair<iterator, bool> emplace(Args&& ...args)
+  {
+    value_type value(mystl::forward<Args>(args)...);
+    return insert(mystl::move(value));
+  }
+
+  pair<iterator, bool> insert(const value_type& value)
+  {
+    return insert_node(value.first, value);
+  }
+  pair<iterator, bool> insert(value_type&& value)
+  {
+    return insert_node(value.first, mystl::move(value));
+  }
+
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last)
+  {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+  void insert(std::initializer_list<value_type> ilist)
+  {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  size_type erase(const key_type& key);
+
+  // 删除 position 处的元素，返回它的下一个位置
+  iterator  erase(const_iterator position)
+  {
+    MYSTL_DEBUG(position != end());
+    guard g(*this);
+    iterator next(position.node);
+    ++next;
+    erase(position->first);
+    return next;
+  }
+
+  // 立即释放所有已删除的节点，以及清空容器，要求没有其它线程访问容器
+  void      reclaim() noexcept;
+  void      clear()   noexcept;
+
+  // concurrent_map 相关操作
+
+  iterator       find(const key_type& key)
+  { return iterator(find_node(key)); }
+  const_iterator find(const key_type& key)        const
+  { return const_iterator(find_node(key)); }
+
+  size_type      count(const key_type& key)       const
+  { return find_node(key) != nullptr ? 1 : 0; }
+  bool           contains(const key_type& key)    const
+  { return find_node(key) != nullptr; }
+
+  iterator       lower_bound(const key_type& key)
+  { return iterator(bound_node(key, false)); }
+  const_iterator lower_bound(const key_type& key) const
+  { return const_iterator(bound_node(key, false)); }
+
+  iterator       upper_bound(const key_type& key)
+  { return iterator(bound_node(key, true)); }
+  const_iterator upper_bound(const key_type& key) const
+  { return const_iterator(bound_node(key, true)); }
+
+  void swap(concurrent_map& rhs) noexcept;
+
+private:
+  // helper functions
+
+  // node
+  static node_ptr create_node(int level);
+  template <class ...Args>
+  static node_ptr create_node(int level, Args&& ...args);
+  static void     destroy_node(node_ptr p) noexcept;
+  static void     destroy_value_node(node_ptr p) noexcept;
+
+  static int      random_level() noexcept;
+
+  static const key_type& key_of(node_ptr p) noexcept { return p->value.first; }
+
+  // search
+  int      find_position(const key_type& key, node_ptr* preds, node_ptr* succs) const;
+  node_ptr find_node(const key_type& key) const;
+  node_ptr bound_node(const key_type& key, bool upper) const;
+
+  // insert / erase
+  template <class ...Args>
+  pair<iterator, bool> insert_node(const key_type& key, Args&& ...args);
+
+  static void unlock_preds(node_ptr* preds, int levels) noexcept;
+  void        retire(node_ptr p, const guard& g) noexcept;
+  static size_type destroy_list(node_ptr p) noexcept;
+
+  // epoch
+  static uint64_t      next_id() noexcept;
+  epoch_record*        enter() const noexcept;
+  static void          leave(epoch_record* r) noexcept;
+  epoch_record*        acquire_record() const noexcept;
+  void                 try_advance() noexcept;
+};
+
+/*****************************************************************************************/
+
+// 删除键值为 key 的元素，返回删除的个数
+template <class Key, class T, class Compare>
+typename concurrent_map<Key, T, Compare>::size_type
+concurrent_map<Key, T, Compare>::
+erase(const key_type& key)
+{
+  guard g(*this);
+  node_ptr preds[max_level];
+  node_ptr succs[max_level];
+  node_ptr victim = nullptr;
+  bool is_marked = false;
+  int top_level = -1;
+  while (true)
+  {
+    const int found = find_position(key, preds, succs);
+    if (found != -1)
+      victim = succs[found];
+    // 只删除已完整插入、且在它的最高层被找到的节点，否则它可能正在插入或已被其它线程删除
+    if (is_marked ||
+        (found != -1 && victim->fully_linked.load(std::memory_order_acquire) &&
+         victim->top_level - 1 == found && !victim->marked.load(std::memory_order_acquire)))
+    {
+      if (!is_marked)
+      { // 逻辑删除
+        top_level = victim->top_level;
+        victim->lock();
+        if (victim->marked.load(std::memory_order_relaxed))
+        {
+          victim->unlock();
+          return 0;
+        }
+        victim->marked.store(true, std::memory_order_release);
+        is_marked = true;
+      }
+      // 锁住各层前驱并确认它们仍然指向 victim，否则重新查找
+      int locked = 0;
+      bool valid = true;
+      for (; valid && locked < top_level; ++locked)
+      {
+        node_ptr pred = preds[locked];
+        if (locked == 0 || pred != preds[locked - 1])
+          pred->lock();
+        valid = !pred->marked.load(std::memory_order_acquire) &&
+          pred->next()[locked].load(std::memory_order_acquire) == victim;
+      }
+      if (!valid)
+      {
+        unlock_preds(preds, locked);
+        continue;
+      }
+      // 物理删除，自顶向下摘除，保证低层始终包含高层的节点
+      for (int level = top_level - 1; level >= 0; --level)
+      {
+        preds[level]->next()[level].store(
+          victim->next()[level].load(std::memory_order_acquire), std::memory_order_release);
+      }
+      victim->unlock();
+      unlock_preds(preds, top_level);
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      retire(victim, g);
+      return 1;
+    }
+    return 0;
+  }
+}
+
+// 释放所有回收链表中的节点
+template <class Key, class T, class Compare>
+void concurrent_map<Key, T, Compare>::
+reclaim() noexcept
+{
+  for (auto& r : retired_)
+  {
+    const auto n = destroy_list(r.exchange(nullptr, std::memory_order_acquire));
+    retired_size_.fetch_sub(n, std::memory_order_relaxed);
+  }
+}
+
+// 清空容器
+template <class Key, class T, class Compare>
+void concurrent_map<Key, T, Compare>::
+clear() noexcept
+{
+  node_ptr p = head_->next()[0].load(std::memory_order_acquire);
+  while (p != nullptr)
+  {
+    node_ptr next = p->next()[0].load(std::memory_order_relaxed);
+    destroy_value_node(p);
+    p = next;
+  }
+  for (int level = 0; level < max_level; ++level)
+    head_->next()[level].store(nullptr, std::memory_order_relaxed);
+  size_.store(0, std::memory_order_relaxed);
+  reclaim();
+}
+
+// 交换两个容器的内容
+template <class Key, class T, class Compare>
+void concurrent_map<Key, T, Compare>::
+swap(concurrent_map& rhs) noexcept
+{
+  if (this != &rhs)
+  { // 登记表与 epoch 留在各自的容器中，先释放待回收的节点，使它们不必交换
+    reclaim();
+    rhs.reclaim();
+    mystl::swap(head_, rhs.head_);
+    size_type n = size_.load(std::memory_order_relaxed);
+    size_.store(rhs.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    rhs.size_.store(n, std::memory_order_relaxed);
+    mystl::swap(comp_, rhs.comp_);
+  }
+}
+
+// 分配一个 level 层、不含 value 的节点
+template <class Key, class T, class Compare>
+typename concurrent_map<Key, T, Compare>::node_ptr
+concurrent_map<Key, T, Compare>::
+create_node(int level)
+{
+  void* p = ::operator new(sizeof(node_type) + level * sizeof(typename node_type::link_type));
+  return ::new (p) node_type(level);
+}
+
+// 分配一个 level 层的节点，并用 args 构造其中的 value
+template <class Key, class T, class Compare>
+template <class ...Args>
+typename concurrent_map<Key, T, Compare>::node_ptr
+concurrent_map<Key, T, Compare>::
+create_node(int level, Args&& ...args)
+{
+  node_ptr p = create_node(level);
+  try
+  {
+    mystl::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+  }
+  catch (...)
+  {
+    destroy_node(p);
+    throw;
+  }
+  return p;
+}
+
+// 释放节点，不析构 value
+template <class Key, class T, class Compare>
+void concurrent_map<Key, T, Compare>::
+destroy_node(node_ptr p) noexcept
+{
+  p->~node_type();
+  ::operator delete(static_cast<void*>(p));
+}
+
+// 析构 value 并释放节点
+template <class Key, class T, class Compare>
+void concurrent_map<Key, T, Compare>::
+destroy_value_node(node_ptr p) noexcept
+{
+  mystl::destroy(mystl::address_of(p->value));
+  destroy_node(p);
+}
+
+// 为新节点随机选取层数，每一层以 1/4 的概率继续增长
+template <class Key, class T, class Compare>
+int concurrent_map<Key, T, Compare>::
+random_level() noexcept
+{
+  static std::atomic<uint64_t> seed_source(0);
+  thread_local uint64_t state =
+    (seed_source.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9e3779b97f4a7c15ull;
+  // xorshift64
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  uint64_t r = state;
+  int level = 1;
+  while (level < max_level && (r & 3) == 0)
+  {
+    ++level;
+    r >>= 2;
+  }
+  return level;
+}
+
+// 自顶向下查找 key，preds / succs 记录每一层中 key 的前驱与后继
+// 返回找到 key 的最高层，没有找到时返回 -1
+template <class Key, class T, class Compare>
+int concurrent_map<Key, T, Compare>::
+find_position(const key_type& key, node_ptr* preds, node_ptr* succs) const
+{
+  int found = -1;
+  node_ptr pred = head_;
+  for (int level = max_level - 1; level >= 0; --level)
+  {
+    node_ptr curr = pred->next()[level].load(std::memory_order_acquire);
+    while (curr != nullptr && comp_(key_of(curr), key))
+    {
+      pred = curr;
+      curr = pred->next()[level].load(std::memory_order_acquire);
+    }
+    if (found == -1 && curr != nullptr && !comp_(key, key_of(curr)))
+      found = level;
+    preds[level] = pred;
+    succs[level] = curr;
+  }
+  return found;
+}
+
+// 查找键值为 key 的有效节点，不存在时返回 nullptr
+template <class Key, class T, class Compare>
+typename concurrent_map<Key, T, Compare>::node_ptr
+concurrent_map<Key, T, Compare>::
+find_node(const key_type& key) const
+{
+  guard g(*this);
+  node_ptr pred = head_;
+  node_ptr curr = nullptr;
+  for (int level = max_level - 1; level >= 0; --level)
+  {
+    curr = pred->next()[level].load(std::memory_order_acquire);
+    while (curr != nullptr && comp_(key_of(curr), key))
+    {
+      pred = curr;
+      curr = pred->next()[level].load(std::memory_order_acquire);
+    }
+    if (curr != nullptr && !comp_(key, key_of(curr)))
+      return curr->is_live() ? curr : nullptr;
+  }
+  return nullptr;
+}
+
+// 返回第一个不小于 key（upper 为 true 时为大于 key）的有效节点
+template <class Key, class T, class Compare>
+typename concurrent_map<Key, T, Compare>::node_ptr
+concurrent_map<Key, T, Compare>::
+bound_node(const key_type& key, bool upper) const
+{
+  guard g(*this);
+  node_ptr pred = head_;
+  node_ptr curr = nullptr;
+  for (int level = max_level - 1; level >= 0; --level)
+  {
+    curr = pred->next()[level].load(std::memory_order_acquire);
+    while (curr != nullptr && (upper ? !comp_(key, key_of(curr)) : comp_(key_of(curr), key)))
+    {
+      pred = curr;
+      curr = pred->next()[level].load(std::memory_order_acquire);
+    }
+  }
+  return node_type::first_live(curr);
+}
+
+// 插入键值为 key 的节点，节点的 value 由 args 构造，只有确定插入时才分配节点
+template <class Key, class T, class Compare>
+template <class ...Args>
+pair<typename concurrent_map<Key, T, Compare>::iterator, bool>
+concurrent_map<Key, T, Compare>::
+insert_node(const key_type& key, Args&& ...args)
+{
+  guard g(*this);
+  node_ptr preds[max_level];
+  node_ptr succs[max_level];
+  const int top_level = random_level();
+  while (true)
+  {
+    const int found = find_position(key, preds, succs);
+    if (found != -1)
+    {
+      node_ptr p = succs[found];
+      if (!p->marked.load(std::memory_order_acquire))
+      { // 已存在，等待它插入完成
+        while (!p->fully_linked.load(std::memory_order_acquire))
+          std::this_thread::yield();
+        return mystl::make_pair(iterator(p), false);
+      }
+      // 已存在的节点正在被删除，重新查找
+      continue;
+    }
+    // 锁住各层前驱并确认前驱与后继都没有被删除，且仍然相邻
+    int locked = 0;
+    bool valid = true;
+    for (; valid && locked < top_level; ++locked)
+    {
+      node_ptr pred = preds[locked];
+      node_ptr succ = succs[locked];
+      if (locked == 0 || pred != preds[locked - 1])
+        pred->lock();
+      valid = !pred->marked.load(std::memory_order_acquire) &&
+        (succ == nullptr || !succ->marked.load(std::memory_order_acquire)) &&
+        pred->next()[locked].load(std::memory_order_acquire) == succ;
+    }
+    if (!valid)
+    {
+      unlock_preds(preds, locked);
+      continue;
+    }
+    node_ptr np = nullptr;
+    try
+    {
+      np = create_node(top_level, mystl::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      unlock_preds(preds, top_level);
+      throw;
+    }
+    // 先设置新节点的后继，再自底向上接入各层
+    for (int level = 0; level < top_level; ++level)
+      np->next()[level].store(succs[level], std::memory_order_relaxed);
+    for (int level = 0; level < top_level; ++level)
+      preds[level]->next()[level].store(np, std::memory_order_release);
+    np->fully_linked.store(true, std::memory_order_release);
+    unlock_preds(preds, top_level);
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return mystl::make_pair(iterator(np), true);
+  }
+}
+
+// 解锁 preds[0, levels) 中的节点，相邻层相同的前驱只加过一次锁
+template <class Key, class T, class Compare>
+void concurrent_map<Key, T, Compare>::
+unlock_preds(node_ptr* preds, int levels) noexcept
+{
+  for (int level = 0; level < levels; ++level)
+  {
+    if (level == 0 || preds[level] != preds[level - 1])
+      preds[level]->unlock();
+  }
+}
+
+// 把已摘下的节点挂到 g 登记时的 epoch 对应的回收链表上，每隔一段时间尝试回收
+template <class Key, class T, class Compare>
+void concurrent_map<Key, T, Compare>::
+retire(node_ptr p, const guard& g) noexcept
+{
+  const uint64_t e = g.record_->epoch.load(std::memory_order_relaxed) - 1;
+  auto& list = retired_[e % 3];
+  node_ptr old = list.load(std::memory_order_relaxed);
+  do
+  {
+    p->retired_next = old;
+  } while (!list.compare_exchange_weak(old, p, std::memory_order_release,
+                                       std::memory_order_relaxed));
+  retired_size_.fetch_add(1, std::memory_order_relaxed);
+  if (retire_tick_.fetch_add(1, std::memory_order_relaxed) % CONCURRENT_MAP_RECLAIM_INTERVAL ==
+      CONCURRENT_MAP_RECLAIM_INTERVAL - 1)
+  {
+    try_advance();
+  }
+}
+
+// 释放回收链表 p 上的所有节点，返回释放的个数
+template <class Key, class T, class Compare>
+typename concurrent_map<Key, T, Compare>::size_type
+concurrent_map<Key, T, Compare>::
+destroy_list(node_ptr p) noexcept
+{
+  size_type n = 0;
+  while (p != nullptr)
+  {
+    node_ptr next = p->retired_next;
+    destroy_value_node(p);
+    p = next;
+    ++n;
+  }
+  return n;
+}
+
+// 为每个容器分配一个不重复的编号
+template <class Key, class T, class Compare>
+uint64_t concurrent_map<Key, T, Compare>::
+next_id() noexcept
+{
+  static std::atomic<uint64_t> id(0);
+  return id.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// 登记当前线程所处的全局 epoch
+// 登记与 try_advance 中的检查都是对 epoch 的读-改-写，二者在修改顺序中有先后：
+// 推进 epoch 的线程要么看到这次登记，要么这次登记与它同步，之后的读取不会再看到推进前已摘下的节点
+template <class Key, class T, class Compare>
+typename concurrent_map<Key, T, Compare>::epoch_record*
+concurrent_map<Key, T, Compare>::
+enter() const noexcept
+{
+  auto r = acquire_record();
+  r->epoch.exchange(epoch_.load(std::memory_order_acquire) + 1, std::memory_order_acq_rel);
+  return r;
+}
+
+// 取消登记
+template <class Key, class T, class Compare>
+void concurrent_map<Key, T, Compare>::
+leave(epoch_record* r) noexcept
+{
+  r->epoch.store(0, std::memory_order_release);
+  r->used.store(false, std::memory_order_release);
+}
+
+// 占用一个空闲的登记，优先使用本线程上次在这个容器中用过的登记，都被占用时新建一个
+template <class Key, class T, class Compare>
+typename concurrent_map<Key, T, Compare>::epoch_record*
+concurrent_map<Key, T, Compare>::
+acquire_record() const noexcept
+{
+  struct record_hint
+  {
+    uint64_t      id;
+    epoch_record* record;
+  };
+  thread_local record_hint hint = { 0, nullptr };
+  auto try_use = [](epoch_record* r) {
+    return !r->used.load(std::memory_order_relaxed) &&
+           !r->used.exchange(true, std::memory_order_acquire);
+  };
+  if (hint.id == id_ && try_use(hint.record))
+    return hint.record;
+  while (true)
+  {
+    for (auto r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next)
+    {
+      if (try_use(r))
+      {
+        hint = { id_, r };
+        return r;
+      }
+    }
+    auto r = new (std::nothrow) epoch_record;
+    if (r == nullptr)
+    { // 内存不足时等待其它线程让出登记
+      std::this_thread::yield();
+      continue;
+    }
+    r->next = records_.load(std::memory_order_relaxed);
+    while (!records_.compare_exchange_weak(r->next, r, std::memory_order_release,
+                                           std::memory_order_relaxed))
+      ;
+    hint = { id_, r };
+    return r;
+  }
+}
+
+// 所有登记中的线程都处于当前 epoch e 时，推进到 e + 1，并释放 e - 2 时摘下的节点
+// 这些节点在 epoch 变为 e 之前就已不在链表中，而此时登记的线程都是在那之后才开始读取的
+template <class Key, class T, class Compare>
+void concurrent_map<Key, T, Compare>::
+try_advance() noexcept
+{
+  if (reclaiming_.exchange(true, std::memory_order_acquire))
+    return;
+  const uint64_t e = epoch_.load(std::memory_order_relaxed);
+  for (auto r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next)
+  {
+    const auto v = r->epoch.fetch_add(0, std::memory_order_acq_rel);
+    if (v != 0 && v != e + 1)
+    {
+      reclaiming_.store(false, std::memory_order_release);
+      return;
+    }
+  }
+  // 在推进之前取走，推进之后才会有线程向这个链表中放入 e + 1 时摘下的节点
+  node_ptr list = retired_[(e + 1) % 3].exchange(nullptr, std::memory_order_acquire);
+  epoch_.store(e + 1, std::memory_order_release);
+  reclaiming_.store(false, std::memory_order_release);
+  retired_size_.fetch_sub(destroy_list(list), std::memory_order_relaxed);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Compare>
+void swap(concurrent_map<Key, T, Compare>& lhs, concurrent_map<Key, T, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_CONCURRENT_MAP_H_
+
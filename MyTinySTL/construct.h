@@ -31,6 +31,9 @@ void destroy_one(Tp* pointer, std::false_type) {
     }
 }
 
+template <typename Tp>
+void destroy(Tp* pointer);
+
 template <typename ForwardIter>
 void destroy_cat(ForwardIter, ForwardIter, std::true_type) {}
 
@@ -14,6 +14,10 @@
 //   * push_front
 //   * push_back
 //   * insert
+//
+// 迭代器失效：
+//   * shrink_to_fit 与 clear 会释放缓冲区并重新分配 map，使所有迭代器失效
+//   * 开启 DEQUE_AUTO_TRIM 时，pop_front / pop_back 也可能触发收缩，使所有迭代器失效
 
 #include <initializer_list>
 
@@ -40,12 +44,38 @@ namespace mystl
 #define DEQUE_MAP_INIT_SIZE 8
 #endif
 
+// 是否在 pop_front / pop_back 释放缓冲区时自动收缩 map
+// 开启后，当 map 中使用的节点不足 1 / DEQUE_TRIM_RATIO 时，会释放空闲缓冲区并压缩 map
+// 收缩会重新分配 map，此时所有迭代器失效，但指向剩余元素的指针和引用仍然有效
+#ifndef DEQUE_AUTO_TRIM
+#define DEQUE_AUTO_TRIM 0
+#endif
+
+#ifndef DEQUE_TRIM_RATIO
+#define DEQUE_TRIM_RATIO 4
+#endif
+
 template <class T>
 struct deque_buf_size
 {
   static constexpr size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
 };
 
+// 缓冲区大小为 2 的幂次时，用移位与掩码代替除法与取模
+template <size_t N>
+struct deque_buf_shift
+{
+  static constexpr bool   is_pow2 = N != 0 && (N & (N - 1)) == 0;
+  static constexpr size_t value = N <= 1 ? 0 : deque_buf_shift<N / 2>::value + 1;
+};
+
+template <>
+struct deque_buf_shift<0>
+{
+  static constexpr bool   is_pow2 = false;
+  static constexpr size_t value = 0;
+};
+
 // deque 的迭代器设计
 template <class T, class Ref, class Ptr>
 struct deque_iterator : public iterator<random_access_iterator_tag, T>
@@ -63,6 +93,9 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T>
   typedef T**          map_pointer;
 
   static const size_type buffer_size = deque_buf_size<T>::value;
+  static constexpr bool      buffer_pow2  = deque_buf_shift<buffer_size>::is_pow2;
+  static constexpr size_type buffer_shift = deque_buf_shift<buffer_size>::value;
+  static constexpr size_type buffer_mask  = buffer_size - 1;
 
   // 迭代器所含成员数据
   value_pointer cur;    // 指向所在缓冲区的当前元素
@@ -121,6 +154,8 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T>
 
   difference_type operator-(const self& x) const
   {
+    if (buffer_pow2)
+      return ((node - x.node) << buffer_shift) + (cur - first) - (x.cur - x.first);
     return static_cast<difference_type>(buffer_size) * (node - x.node)
       + (cur - first) - (x.cur - x.first);
   }
@@ -166,6 +201,11 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T>
     { // 仍在当前缓冲区
       cur += n;
     }
+    else if (buffer_pow2)
+    { // 算术右移即向下取整，低位即为缓冲区内的偏移
+      set_node(node + (offset >> buffer_shift));
+      cur = first + (offset & static_cast<difference_type>(buffer_mask));
+    }
     else
     { // 要跳到其他的缓冲区
       const auto node_offset = offset > 0
@@ -191,7 +231,15 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T>
     return tmp -= n;
   }
 
-  reference operator[](difference_type n) const { return *(*this + n); }
+  reference operator[](difference_type n) const
+  {
+    const auto offset = n + (cur - first);
+    if (offset >= 0 && offset < static_cast<difference_type>(buffer_size))
+      return cur[n];
+    if (buffer_pow2)  // 直接由 map 定位，无需构造临时迭代器
+      return node[offset >> buffer_shift][offset & static_cast<difference_type>(buffer_mask)];
+    return *(*this + n);
+  }
 
   // 重载比较操作符
   bool operator==(const self& rhs) const { return cur == rhs.cur; }
@@ -337,16 +385,20 @@ public:
   void      resize(size_type new_size, const value_type& value);
   void      shrink_to_fit() noexcept;
 
+  // 非标准接口：已分配的缓冲区能容纳的元素个数，以及 map 中指针的数目
+  size_type capacity() const noexcept;
+  size_type map_size() const noexcept  { return map_size_; }
+
   // 访问元素相关操作 
   reference       operator[](size_type n)
   {
     MYSTL_DEBUG(n < size());
-    return begin_[n];
+    return element_at(n);
   }
   const_reference operator[](size_type n) const
   {
     MYSTL_DEBUG(n < size());
-    return begin_[n];
+    return element_at(n);
   }
 
   reference       at(size_type n)      
@@ -441,6 +493,17 @@ public:
 private:
   // helper functions
 
+  // 以 begin_.node 为基准直接索引 map，避免构造迭代器
+  reference       element_at(size_type n)
+  {
+    const size_type offset = n + static_cast<size_type>(begin_.cur - begin_.first);
+    if (iterator::buffer_pow2)
+      return begin_.node[offset >> iterator::buffer_shift][offset & iterator::buffer_mask];
+    return begin_.node[offset / buffer_size][offset % buffer_size];
+  }
+  const_reference element_at(size_type n) const
+  { return const_cast<deque*>(this)->element_at(n); }
+
   // create node / destroy node
   map_pointer create_map(size_type size);
   void        create_buffer(map_pointer nstart, map_pointer nfinish);
@@ -476,6 +539,8 @@ private:
   void        require_capacity(size_type n, bool front);
   void        reallocate_map_at_front(size_type need);
   void        reallocate_map_at_back(size_type need);
+  void        trim_map() noexcept;
+  void        trim_if_need() noexcept;
 
 };
 
@@ -531,10 +596,12 @@ void deque<T>::resize(size_type new_size, const value_type& value)
   }
 }
 
-// 减小容器容量
+// 减小容器容量，释放未使用的缓冲区并压缩 map
 template <class T>
 void deque<T>::shrink_to_fit() noexcept
 {
+  if (map_ == nullptr)
+    return;
   // 至少会留下头部缓冲区
   for (auto cur = map_; cur < begin_.node; ++cur)
   {
@@ -546,6 +613,21 @@ void deque<T>::shrink_to_fit() noexcept
     data_allocator::deallocate(*cur, buffer_size);
     *cur = nullptr;
   }
+  trim_map();
+}
+
+// 统计 map 中已分配的缓冲区，需要遍历整个 map
+template <class T>
+typename deque<T>::size_type
+deque<T>::capacity() const noexcept
+{
+  size_type n = 0;
+  for (auto cur = map_; cur < map_ + map_size_; ++cur)
+  {
+    if (*cur != nullptr)
+      ++n;
+  }
+  return n * buffer_size;
 }
 
 // 在头部就地构建元素
@@ -667,6 +749,7 @@ void deque<T>::pop_front()
     data_allocator::destroy(begin_.cur);
     ++begin_;
     destroy_buffer(begin_.node - 1, begin_.node - 1);
+    trim_if_need();
   }
 }
 
@@ -685,6 +768,7 @@ void deque<T>::pop_back()
     --end_;
     data_allocator::destroy(end_.cur);
     destroy_buffer(end_.node + 1, end_.node + 1);
+    trim_if_need();
   }
 }
 
@@ -828,8 +912,9 @@ void deque<T>::clear()
   {
     mystl::destroy(begin_.cur, end_.cur);
   }
-  shrink_to_fit();
+  // 先让 end_ 回到头部缓冲区，shrink_to_fit 才会释放其余的缓冲区
   end_ = begin_;
+  shrink_to_fit();
 }
 
 // 交换两个 deque
@@ -1375,6 +1460,51 @@ void deque<T>::reallocate_map_at_back(size_type need_buffer)
   end_ = iterator(*(mid - 1) + (end_.cur - end_.first), mid - 1);
 }
 
+// trim_map 函数
+// 把正在使用的缓冲区搬到一块大小刚好的 map 中央，map 之外的缓冲区需已被释放
+template <class T>
+void deque<T>::trim_map() noexcept
+{
+  const size_type used = end_.node - begin_.node + 1;
+  const size_type new_map_size = mystl::max(static_cast<size_type>(DEQUE_MAP_INIT_SIZE),
+                                            used + 2);
+  if (new_map_size >= map_size_)
+    return;
+  map_pointer new_map = nullptr;
+  try
+  {
+    new_map = create_map(new_map_size);
+  }
+  catch (...)
+  { // 无法分配时保留原来的 map
+    return;
+  }
+  auto begin = new_map + (new_map_size - used) / 2;
+  for (auto begin1 = begin, begin2 = begin_.node; begin2 <= end_.node; ++begin1, ++begin2)
+    *begin1 = *begin2;
+
+  // 更新数据
+  map_allocator::deallocate(map_, map_size_);
+  map_ = new_map;
+  map_size_ = new_map_size;
+  begin_ = iterator(*begin + (begin_.cur - begin_.first), begin);
+  end_ = iterator(*(begin + used - 1) + (end_.cur - end_.first), begin + used - 1);
+}
+
+// trim_if_need 函数
+// 开启 DEQUE_AUTO_TRIM 时，若 map 的使用率过低则收缩
+template <class T>
+void deque<T>::trim_if_need() noexcept
+{
+#if DEQUE_AUTO_TRIM
+  const size_type used = end_.node - begin_.node + 1;
+  if (map_size_ > (DEQUE_MAP_INIT_SIZE << 1) && used * DEQUE_TRIM_RATIO < map_size_)
+  {
+    shrink_to_fit();
+  }
+#endif
+}
+
 // 重载比较操作符
 template <class T>
 bool operator==(const deque<T>& lhs, const deque<T>& rhs)
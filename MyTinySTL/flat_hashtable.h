@@ -0,0 +1,1081 @@
+#ifndef MYTINYSTL_FLAT_HASHTABLE_H_
+#define MYTINYSTL_FLAT_HASHTABLE_H_
+
+// 这个头文件包含一个模板类 flat_hashtable
+// flat_hashtable : 开放寻址的哈希表，flat_hash_map / flat_hash_set 的底层机制
+
+// notes:
+//
+// 元素直接存放在一个连续的槽数组中，不再为每个元素分配节点。每个槽对应一个控制字节：
+//   * 空位     : 0b10000000
+//   * 已删除   : 0b11111110
+//   * 哨兵     : 0b11111111，位于控制字节数组的末尾，遍历到它时结束
+//   * 有元素   : 0b0xxxxxxx，低 7 位为哈希值的低 7 位（h2）
+// 哈希值的其余高位（h1）决定探测的起点。查找时一次读入一组（SSE2 下为 16 个）控制字节，
+// 用一条比较指令找出 h2 相同的位置，只对这些位置比较键值，遇到含有空位的组即可停止。
+//
+// 容量总是 2^k - 1，控制字节数组的末尾复制了开头的 width - 1 个字节，因此从任意位置读一组都不会越界。
+// 负载因子上限固定为 7/8；删除元素时若它所在的位置从未使某组变满，则直接标记为空位，否则标记为已删除。
+//
+// 与 hashtable 的区别：
+//   * 只支持键值不允许重复的容器
+//   * 插入可能引起扩容，扩容会移动元素，使所有迭代器、指针与引用失效；删除只使被删元素的迭代器失效
+//   * 没有 bucket 接口与节点句柄
+//
+// 用户提供的哈希值会再经过一次混合，使 h1 与 h2 都依赖于哈希值的所有位
+
+#include <initializer_list>
+
+#include <cstdint>
+
+#include "algobase.h"
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "type_traits.h"
+#include "util.h"
+#include "exceptdef.h"
+
+// 是否使用 SSE2 指令一次匹配 16 个控制字节，否则逐字节匹配 8 个
+#ifndef FLAT_HASH_USE_SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_HASH_USE_SSE2 1
+#else
+#define FLAT_HASH_USE_SSE2 0
+#endif
+#endif
+
+#if FLAT_HASH_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace mystl
+{
+
+// 控制字节
+
+typedef signed char fh_ctrl_type;
+
+static constexpr fh_ctrl_type fh_empty    = -128;
+static constexpr fh_ctrl_type fh_deleted  = -2;
+static constexpr fh_ctrl_type fh_sentinel = -1;
+
+inline bool fh_is_full(fh_ctrl_type c) noexcept { return c >= 0; }
+
+inline size_t       fh_h1(size_t h) noexcept { return h >> 7; }
+inline fh_ctrl_type fh_h2(size_t h) noexcept { return static_cast<fh_ctrl_type>(h & 0x7f); }
+
+// 最低位的 1 所在的位置，要求 x 不为 0
+inline uint32_t fh_lowest_bit(uint32_t x) noexcept
+{
+#if __GNUC__ || __clang__
+  return static_cast<uint32_t>(__builtin_ctz(x));
+#else
+  uint32_t n = 0;
+  for (; (x & 1) == 0; x >>= 1)
+    ++n;
+  return n;
+#endif
+}
+
+// 最高位的 1 所在的位置，要求 x 不为 0
+inline uint32_t fh_highest_bit(uint32_t x) noexcept
+{
+#if __GNUC__ || __clang__
+  return 31 - static_cast<uint32_t>(__builtin_clz(x));
+#else
+  uint32_t n = 0;
+  for (; x >>= 1; )
+    ++n;
+  return n;
+#endif
+}
+
+// 一组控制字节的匹配结果，第 i 位为 1 表示组内第 i 个控制字节满足条件
+struct fh_bitmask
+{
+  uint32_t mask;
+
+  explicit fh_bitmask(uint32_t m) noexcept :mask(m) {}
+
+  explicit operator bool() const noexcept { return mask != 0; }
+
+  uint32_t lowest()  const noexcept { return fh_lowest_bit(mask); }
+  uint32_t highest() const noexcept { return fh_highest_bit(mask); }
+
+  // 去掉最低位的 1，用于依次访问所有匹配的位置
+  fh_bitmask& operator++() noexcept
+  {
+    mask &= mask - 1;
+    return *this;
+  }
+};
+
+// 一组控制字节
+#if FLAT_HASH_USE_SSE2
+
+struct fh_group
+{
+  static constexpr size_t width = 16;
+
+  __m128i ctrl;
+
+  explicit fh_group(const fh_ctrl_type* p) noexcept
+    :ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)))
+  {
+  }
+
+  fh_bitmask match(fh_ctrl_type h2) const noexcept
+  {
+    return fh_bitmask(static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))));
+  }
+
+  fh_bitmask match_empty() const noexcept
+  {
+    return match(fh_empty);
+  }
+
+  // 空位与已删除都小于哨兵
+  fh_bitmask match_empty_or_deleted() const noexcept
+  {
+    return fh_bitmask(static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(fh_sentinel), ctrl))));
+  }
+};
+
+#else
+
+struct fh_group
+{
+  static constexpr size_t width = 8;
+
+  fh_ctrl_type ctrl[width];
+
+  explicit fh_group(const fh_ctrl_type* p) noexcept
+  {
+    for (size_t i = 0; i < width; ++i)
+      ctrl[i] = p[i];
+  }
+
+  fh_bitmask match(fh_ctrl_type h2) const noexcept
+  {
+    uint32_t m = 0;
+    for (size_t i = 0; i < width; ++i)
+      m |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+    return fh_bitmask(m);
+  }
+
+  fh_bitmask match_empty() const noexcept
+  {
+    return match(fh_empty);
+  }
+
+  fh_bitmask match_empty_or_deleted() const noexcept
+  {
+    uint32_t m = 0;
+    for (size_t i = 0; i < width; ++i)
+      m |= static_cast<uint32_t>(ctrl[i] < fh_sentinel) << i;
+    return fh_bitmask(m);
+  }
+};
+
+#endif
+
+// 空表共用的控制字节：一个哨兵加上若干空位，不会被写入
+inline fh_ctrl_type* fh_empty_group() noexcept
+{
+  alignas(16) static const fh_ctrl_type group[16] = {
+    fh_sentinel, fh_empty, fh_empty, fh_empty, fh_empty, fh_empty, fh_empty, fh_empty,
+    fh_empty,    fh_empty, fh_empty, fh_empty, fh_empty, fh_empty, fh_empty, fh_empty
+  };
+  return const_cast<fh_ctrl_type*>(group);
+}
+
+// 探测序列：以组为单位做三角数探测，容量为 2^k - 1 时能访问到所有的组
+struct fh_probe_seq
+{
+  size_t mask;
+  size_t offset;
+  size_t index;
+
+  fh_probe_seq(size_t h1, size_t m) noexcept :mask(m), offset(h1 & m), index(0) {}
+
+  size_t offset_at(size_t i) const noexcept { return (offset + i) & mask; }
+
+  void next() noexcept
+  {
+    index += fh_group::width;
+    offset = (offset + index) & mask;
+  }
+};
+
+// value traits
+template <class T, bool>
+struct fh_value_traits_imp
+{
+  typedef T key_type;
+  typedef T mapped_type;
+  typedef T value_type;
+
+  template <class Ty>
+  static const key_type& get_key(const Ty& value)
+  {
+    return value;
+  }
+
+  template <class Ty>
+  static const value_type& get_value(const Ty& value)
+  {
+    return value;
+  }
+};
+
+template <class T>
+struct fh_value_traits_imp<T, true>
+{
+  typedef typename std::remove_cv<typename T::first_type>::type key_type;
+  typedef typename T::second_type                               mapped_type;
+  typedef T                                                     value_type;
+
+  template <class Ty>
+  static const key_type& get_key(const Ty& value)
+  {
+    return value.first;
+  }
+
+  template <class Ty>
+  static const value_type& get_value(const Ty& value)
+  {
+    return value;
+  }
+};
+
+template <class T>
+struct fh_value_traits
+{
+  static constexpr bool is_map = mystl::is_pair<T>::value;
+
+  typedef fh_value_traits_imp<T, is_map> value_traits_type;
+
+  typedef typename value_traits_type::key_type    key_type;
+  typedef typename value_traits_type::mapped_type mapped_type;
+  typedef typename value_traits_type::value_type  value_type;
+
+  template <class Ty>
+  static const key_type& get_key(const Ty& value)
+  {
+    return value_traits_type::get_key(value);
+  }
+
+  template <class Ty>
+  static const value_type& get_value(const Ty& value)
+  {
+    return value_traits_type::get_value(value);
+  }
+};
+
+// flat_hashtable 的迭代器设计
+
+template <class T>
+struct fh_iterator_base :public mystl::iterator<mystl::forward_iterator_tag, T>
+{
+  const fh_ctrl_type* ctrl;  // 指向当前元素的控制字节
+  T*                  slot;  // 指向当前元素
+
+  fh_iterator_base() :ctrl(nullptr), slot(nullptr) {}
+  fh_iterator_base(const fh_ctrl_type* c, T* s) :ctrl(c), slot(s) {}
+
+  // 跳过空位与已删除的位置，停在下一个元素或末尾的哨兵上
+  void skip_empty_or_deleted() noexcept
+  {
+    while (*ctrl < fh_sentinel)
+    {
+      const auto shift = fh_lowest_bit(fh_group(ctrl).match_empty_or_deleted().mask + 1);
+      ctrl += shift;
+      slot += shift;
+    }
+  }
+
+  void incr() noexcept
+  {
+    ++ctrl;
+    ++slot;
+    skip_empty_or_deleted();
+  }
+
+  bool operator==(const fh_iterator_base& rhs) const { return ctrl == rhs.ctrl; }
+  bool operator!=(const fh_iterator_base& rhs) const { return ctrl != rhs.ctrl; }
+};
+
+template <class T>
+struct fh_iterator :public fh_iterator_base<T>
+{
+  typedef fh_iterator_base<T> base;
+  typedef T*                  pointer;
+  typedef T&                  reference;
+  typedef fh_iterator<T>      self;
+
+  using base::slot;
+
+  fh_iterator() {}
+  fh_iterator(const fh_ctrl_type* c, T* s) :base(c, s) {}
+
+  reference operator*()  const { return *slot; }
+  pointer   operator->() const { return slot; }
+
+  self& operator++()
+  {
+    this->incr();
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp(*this);
+    this->incr();
+    return tmp;
+  }
+};
+
+template <class T>
+struct fh_const_iterator :public fh_iterator_base<T>
+{
+  typedef fh_iterator_base<T> base;
+  typedef const T*            pointer;
+  typedef const T&            reference;
+  typedef fh_const_iterator<T> self;
+
+  using base::slot;
+
+  fh_const_iterator() {}
+  fh_const_iterator(const fh_ctrl_type* c, T* s) :base(c, s) {}
+  fh_const_iterator(const fh_iterator<T>& rhs) :base(rhs.ctrl, rhs.slot) {}
+
+  reference operator*()  const { return *slot; }
+  pointer   operator->() const { return slot; }
+
+  self& operator++()
+  {
+    this->incr();
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp(*this);
+    this->incr();
+    return tmp;
+  }
+};
+
+// 模板类 flat_hashtable
+// 参数一代表数据类型，参数二代表哈希函数，参数三代表键值相等的比较函数
+template <class T, class Hash, class KeyEqual>
+class flat_hashtable
+{
+public:
+  // flat_hashtable 的型别定义
+  typedef fh_value_traits<T>                          value_traits;
+  typedef typename value_traits::key_type             key_type;
+  typedef typename value_traits::mapped_type          mapped_type;
+  typedef typename value_traits::value_type           value_type;
+  typedef Hash                                        hasher;
+  typedef KeyEqual                                    key_equal;
+
+  typedef mystl::allocator<T>                         allocator_type;
+  typedef mystl::allocator<T>                         data_allocator;
+  typedef mystl::allocator<fh_ctrl_type>              ctrl_allocator;
+
+  typedef typename allocator_type::pointer            pointer;
+  typedef typename allocator_type::const_pointer      const_pointer;
+  typedef typename allocator_type::reference          reference;
+  typedef typename allocator_type::const_reference    const_reference;
+  typedef typename allocator_type::size_type          size_type;
+  typedef typename allocator_type::difference_type    difference_type;
+
+  typedef mystl::fh_iterator<T>                       iterator;
+  typedef mystl::fh_const_iterator<T>                 const_iterator;
+
+  allocator_type get_allocator() const { return allocator_type(); }
+
+private:
+  // 用以下七个参数来表现 flat_hashtable
+  fh_ctrl_type* ctrl_;         // 控制字节数组，长度为 capacity_ + fh_group::width
+  pointer       slots_;        // 槽数组，长度为 capacity_
+  size_type     size_;         // 元素个数
+  size_type     capacity_;     // 槽的个数，为 0 或 2^k - 1
+  size_type     growth_left_;  // 不扩容还能占用的空位数
+  hasher        hash_;
+  key_equal     equal_;
+
+public:
+  // 构造、复制、移动、析构函数
+  explicit flat_hashtable(size_type bucket_count,
+                          const Hash& hash = Hash(),
+                          const KeyEqual& equal = KeyEqual())
+    :ctrl_(fh_empty_group()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+     hash_(hash), equal_(equal)
+  {
+    if (bucket_count != 0)
+      resize(normalize_capacity(bucket_count));
+  }
+
+  flat_hashtable(const flat_hashtable& rhs)
+    :ctrl_(fh_empty_group()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+     hash_(rhs.hash_), equal_(rhs.equal_)
+  {
+    copy_init(rhs);
+  }
+
+  flat_hashtable(flat_hashtable&& rhs) noexcept
+    :ctrl_(rhs.ctrl_), slots_(rhs.slots_), size_(rhs.size_), capacity_(rhs.capacity_),
+     growth_left_(rhs.growth_left_), hash_(rhs.hash_), equal_(rhs.equal_)
+  {
+    rhs.reset_empty();
+  }
+
+  flat_hashtable& operator=(const flat_hashtable& rhs);
+  flat_hashtable& operator=(flat_hashtable&& rhs) noexcept;
+
+  ~flat_hashtable()
+  {
+    destroy_table();
+  }
+
+  // 迭代器相关操作
+  iterator       begin()        noexcept
+  {
+    iterator it(ctrl_, slots_);
+    it.skip_empty_or_deleted();
+    return it;
+  }
+  const_iterator begin()  const noexcept
+  {
+    const_iterator it(ctrl_, slots_);
+    it.skip_empty_or_deleted();
+    return it;
+  }
+  iterator       end()          noexcept
+  { return iterator_at(capacity_); }
+  const_iterator end()    const noexcept
+  { return citerator_at(capacity_); }
+
+  const_iterator cbegin() const noexcept
+  { return begin(); }
+  const_iterator cend()   const noexcept
+  { return end(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept { return size_ == 0; }
+  size_type size()     const noexcept { return size_; }
+  size_type max_size() const noexcept { return (static_cast<size_type>(-1) >> 1) / sizeof(T); }
+
+  // 修改容器相关操作
+
+  // emplace / empalce_hint
+
+  template <class ...Args>
+  pair<iterator, bool> emplace_unique(Args&& ...args);
+
+  template <class ...Args>
+  iterator emplace_unique_use_hint(const_iterator /*hint*/, Args&& ...args)
+  { return emplace_unique(mystl::forward<Args>(args)...).first; }
+
+  // try_emplace / insert_or_assign
+
+  template <class K, class ...Args>
+  pair<iterator, bool> try_emplace_unique(K&& key, Args&& ...args);
+  template <class K, class M>
+  pair<iterator, bool> insert_or_assign_unique(K&& key, M&& obj);
+
+  // insert
+
+  pair<iterator, bool> insert_unique(const value_type& value);
+  pair<iterator, bool> insert_unique(value_type&& value);
+
+  iterator insert_unique_use_hint(const_iterator /*hint*/, const value_type& value)
+  { return insert_unique(value).first; }
+  iterator insert_unique_use_hint(const_iterator /*hint*/, value_type&& value)
+  { return insert_unique(mystl::move(value)).first; }
+
+  template <class InputIter>
+  void insert_unique(InputIter first, InputIter last)
+  {
+    for (; first != last; ++first)
+      emplace_unique(*first);
+  }
+
+  // erase / clear
+
+  void      erase(const_iterator position);
+  void      erase(const_iterator first, const_iterator last);
+
+  size_type erase_unique(const key_type& key);
+
+  void      clear();
+
+  void      swap(flat_hashtable& rhs) noexcept;
+
+  // 查找相关操作
+
+  size_type                            count(const key_type& key) const
+  { return find_index(key, hash_of(key)) == capacity_ ? 0 : 1; }
+  template <class K>
+  size_type                            count(const K& key) const
+  { return find_index(key, hash_of(key)) == capacity_ ? 0 : 1; }
+
+  iterator                             find(const key_type& key)
+  { return iterator_at(find_index(key, hash_of(key))); }
+  const_iterator                       find(const key_type& key) const
+  { return citerator_at(find_index(key, hash_of(key))); }
+  template <class K>
+  iterator                             find(const K& key)
+  { return iterator_at(find_index(key, hash_of(key))); }
+  template <class K>
+  const_iterator                       find(const K& key) const
+  { return citerator_at(find_index(key, hash_of(key))); }
+
+  pair<iterator, iterator>             equal_range_unique(const key_type& key)
+  { return equal_range_tr<iterator>(find(key)); }
+  pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const
+  { return equal_range_tr<const_iterator>(find(key)); }
+  template <class K>
+  pair<iterator, iterator>             equal_range_unique(const K& key)
+  { return equal_range_tr<iterator>(find(key)); }
+  template <class K>
+  pair<const_iterator, const_iterator> equal_range_unique(const K& key) const
+  { return equal_range_tr<const_iterator>(find(key)); }
+
+  // bucket interface，这里的 bucket 指一个槽
+
+  size_type bucket_count()     const noexcept { return capacity_; }
+  size_type max_bucket_count() const noexcept { return max_size(); }
+
+  // hash policy
+
+  float     load_factor() const noexcept
+  { return capacity_ != 0 ? static_cast<float>(size_) / capacity_ : 0.0f; }
+
+  // 负载因子上限固定为 7/8，设置的值会被忽略
+  float     max_load_factor() const noexcept { return 0.875f; }
+  void      max_load_factor(float /*ml*/) {}
+
+  void      rehash(size_type count);
+  void      reserve(size_type count);
+
+  hasher    hash_fcn() const { return hash_; }
+  key_equal key_eq()   const { return equal_; }
+
+  // 两个表中的元素是否相同
+  bool      equal_unique(const flat_hashtable& other) const;
+
+private:
+  // flat_hashtable 成员函数
+
+  // 高位决定探测起点，低 7 位存入控制字节，哈希函数没有声明 is_avalanching 时需要先打散
+  template <class K>
+  size_type hash_of(const K& key) const
+  {
+    const auto h = static_cast<size_t>(hash_(key));
+    return hash_is_avalanching<Hash>::value ? h : mystl::hash_mix(h);
+  }
+
+  iterator       iterator_at(size_type i) noexcept
+  { return iterator(ctrl_ + i, slots_ + i); }
+  const_iterator citerator_at(size_type i) const noexcept
+  { return const_iterator(ctrl_ + i, slots_ + i); }
+
+  template <class Iter>
+  pair<Iter, Iter> equal_range_tr(Iter it) const
+  {
+    auto next = it;
+    return it.ctrl == ctrl_ + capacity_ ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
+  }
+
+  // 容量为 2^k - 1，最多容纳其中的 7/8，容量为 7 且一组只有 8 个字节时需要留出一个空位
+  static size_type capacity_to_growth(size_type capacity) noexcept
+  {
+    if (fh_group::width == 8 && capacity == 7)
+      return 6;
+    return capacity - capacity / 8;
+  }
+  static size_type growth_to_lower_bound(size_type growth) noexcept
+  {
+    if (growth == 0)
+      return 0;
+    if (fh_group::width == 8 && growth == 7)
+      return 8;
+    return growth + (growth - 1) / 7;
+  }
+  static size_type normalize_capacity(size_type n) noexcept
+  {
+    size_type capacity = 1;
+    while (capacity < n)
+      capacity = capacity * 2 + 1;
+    return capacity;
+  }
+
+  // init / destroy
+  void reset_empty() noexcept;
+  void destroy_table() noexcept;
+  void copy_init(const flat_hashtable& rhs);
+
+  // ctrl
+  void set_ctrl(size_type i, fh_ctrl_type c) noexcept;
+
+  // lookup / insert
+  template <class K>
+  size_type find_index(const K& key, size_type h) const;
+  size_type find_first_non_full(size_type h) const noexcept;
+  template <class ...Args>
+  iterator  insert_new(size_type h, Args&& ...args);
+
+  // rehash
+  void rehash_and_grow_if_necessary();
+  void resize(size_type new_capacity);
+};
+
+/*****************************************************************************************/
+
+// 复制赋值运算符
+template <class T, class Hash, class KeyEqual>
+flat_hashtable<T, Hash, KeyEqual>&
+flat_hashtable<T, Hash, KeyEqual>::
+operator=(const flat_hashtable& rhs)
+{
+  if (this != &rhs)
+  {
+    flat_hashtable tmp(rhs);
+    swap(tmp);
+  }
+  return *this;
+}
+
+// 移动赋值运算符
+template <class T, class Hash, class KeyEqual>
+flat_hashtable<T, Hash, KeyEqual>&
+flat_hashtable<T, Hash, KeyEqual>::
+operator=(flat_hashtable&& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    destroy_table();
+    ctrl_ = rhs.ctrl_;
+    slots_ = rhs.slots_;
+    size_ = rhs.size_;
+    capacity_ = rhs.capacity_;
+    growth_left_ = rhs.growth_left_;
+    hash_ = rhs.hash_;
+    equal_ = rhs.equal_;
+    rhs.reset_empty();
+  }
+  return *this;
+}
+
+// 就地构造元素，键值不允许重复
+template <class T, class Hash, class KeyEqual>
+template <class ...Args>
+pair<typename flat_hashtable<T, Hash, KeyEqual>::iterator, bool>
+flat_hashtable<T, Hash, KeyEqual>::
+emplace_unique(Args&& ...args)
+{
+  value_type value(mystl::forward<Args>(args)...);
+  const auto& key = value_traits::get_key(value);
+  const auto h = hash_of(key);
+  const auto i = find_index(key, h);
+  if (i != capacity_)
+    return mystl::make_pair(iterator_at(i), false);
+  return mystl::make_pair(insert_new(h, mystl::move(value)), true);
+}
+
+// 键值为 key 的元素不存在时，以 key 和 args 构造新元素
+template <class T, class Hash, class KeyEqual>
+template <class K, class ...Args>
+pair<typename flat_hashtable<T, Hash, KeyEqual>::iterator, bool>
+flat_hashtable<T, Hash, KeyEqual>::
+try_emplace_unique(K&& key, Args&& ...args)
+{
+  const auto h = hash_of(key);
+  const auto i = find_index(key, h);
+  if (i != capacity_)
+    return mystl::make_pair(iterator_at(i), false);
+  return mystl::make_pair(insert_new(h, mystl::forward<K>(key),
+                                     mapped_type(mystl::forward<Args>(args)...)), true);
+}
+
+// 键值为 key 的元素存在时把 obj 赋给它的 mapped 值，否则以 key 和 obj 构造新元素
+template <class T, class Hash, class KeyEqual>
+template <class K, class M>
+pair<typename flat_hashtable<T, Hash, KeyEqual>::iterator, bool>
+flat_hashtable<T, Hash, KeyEqual>::
+insert_or_assign_unique(K&& key, M&& obj)
+{
+  const auto h = hash_of(key);
+  const auto i = find_index(key, h);
+  if (i != capacity_)
+  {
+    slots_[i].second = mystl::forward<M>(obj);
+    return mystl::make_pair(iterator_at(i), false);
+  }
+  return mystl::make_pair(insert_new(h, mystl::forward<K>(key), mystl::forward<M>(obj)), true);
+}
+
+// 插入元素，键值不允许重复
+template <class T, class Hash, class KeyEqual>
+pair<typename flat_hashtable<T, Hash, KeyEqual>::iterator, bool>
+flat_hashtable<T, Hash, KeyEqual>::
+insert_unique(const value_type& value)
+{
+  const auto& key = value_traits::get_key(value);
+  const auto h = hash_of(key);
+  const auto i = find_index(key, h);
+  if (i != capacity_)
+    return mystl::make_pair(iterator_at(i), false);
+  return mystl::make_pair(insert_new(h, value), true);
+}
+
+template <class T, class Hash, class KeyEqual>
+pair<typename flat_hashtable<T, Hash, KeyEqual>::iterator, bool>
+flat_hashtable<T, Hash, KeyEqual>::
+insert_unique(value_type&& value)
+{
+  const auto& key = value_traits::get_key(value);
+  const auto h = hash_of(key);
+  const auto i = find_index(key, h);
+  if (i != capacity_)
+    return mystl::make_pair(iterator_at(i), false);
+  return mystl::make_pair(insert_new(h, mystl::move(value)), true);
+}
+
+// 删除迭代器所指的元素
+// 若该位置前后两组中最近的空位相距不到一组，说明任何一次探测都没有因为这一组满而越过它，可以直接标记为空位
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+erase(const_iterator position)
+{
+  const auto index = static_cast<size_type>(position.ctrl - ctrl_);
+  MYSTL_DEBUG(index < capacity_ && fh_is_full(ctrl_[index]));
+  mystl::destroy(slots_ + index);
+  const auto index_before = (index - fh_group::width) & capacity_;
+  const auto empty_after = fh_group(ctrl_ + index).match_empty();
+  const auto empty_before = fh_group(ctrl_ + index_before).match_empty();
+  const bool was_never_full = empty_before && empty_after &&
+    empty_after.lowest() + (fh_group::width - 1 - empty_before.highest()) < fh_group::width;
+  set_ctrl(index, was_never_full ? fh_empty : fh_deleted);
+  if (was_never_full)
+    ++growth_left_;
+  --size_;
+}
+
+// 删除[first, last)内的元素，删除不会移动其它元素
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+erase(const_iterator first, const_iterator last)
+{
+  if (first == begin() && last == end())
+  {
+    clear();
+    return;
+  }
+  while (first != last)
+    erase(first++);
+}
+
+// 删除键值为 key 的元素
+template <class T, class Hash, class KeyEqual>
+typename flat_hashtable<T, Hash, KeyEqual>::size_type
+flat_hashtable<T, Hash, KeyEqual>::
+erase_unique(const key_type& key)
+{
+  const auto i = find_index(key, hash_of(key));
+  if (i == capacity_)
+    return 0;
+  erase(citerator_at(i));
+  return 1;
+}
+
+// 清空 flat_hashtable，保留已分配的空间
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+clear()
+{
+  if (capacity_ == 0)
+    return;
+  if (!std::is_trivially_destructible<T>::value)
+  {
+    for (size_type i = 0; i < capacity_ && size_ != 0; ++i)
+    {
+      if (fh_is_full(ctrl_[i]))
+      {
+        mystl::destroy(slots_ + i);
+        --size_;
+      }
+    }
+  }
+  mystl::fill_n(ctrl_, capacity_ + fh_group::width, fh_empty);
+  ctrl_[capacity_] = fh_sentinel;
+  size_ = 0;
+  growth_left_ = capacity_to_growth(capacity_);
+}
+
+// 交换 flat_hashtable
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+swap(flat_hashtable& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    mystl::swap(ctrl_, rhs.ctrl_);
+    mystl::swap(slots_, rhs.slots_);
+    mystl::swap(size_, rhs.size_);
+    mystl::swap(capacity_, rhs.capacity_);
+    mystl::swap(growth_left_, rhs.growth_left_);
+    mystl::swap(hash_, rhs.hash_);
+    mystl::swap(equal_, rhs.equal_);
+  }
+}
+
+// 重新设置容量，使它至少为 count 且能不扩容地容纳现有元素，count 为 0 且表为空时释放空间
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+rehash(size_type count)
+{
+  if (count == 0 && size_ == 0)
+  {
+    destroy_table();
+    reset_empty();
+    return;
+  }
+  const auto m = normalize_capacity(mystl::max(count, growth_to_lower_bound(size_)));
+  if (count == 0 || m > capacity_)
+    resize(m);
+}
+
+// 预留空间，使容器能不扩容地容纳 count 个元素
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+reserve(size_type count)
+{
+  if (count > size_ + growth_left_)
+    resize(normalize_capacity(growth_to_lower_bound(count)));
+}
+
+// 两个表中的元素是否相同
+template <class T, class Hash, class KeyEqual>
+bool flat_hashtable<T, Hash, KeyEqual>::
+equal_unique(const flat_hashtable& other) const
+{
+  if (size_ != other.size_)
+    return false;
+  for (auto it = begin(), last = end(); it != last; ++it)
+  {
+    auto res = other.find(value_traits::get_key(*it));
+    if (res == other.end() || !(*res == *it))
+      return false;
+  }
+  return true;
+}
+
+// reset_empty 函数
+// 让容器指向共用的空组，不释放原有空间
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+reset_empty() noexcept
+{
+  ctrl_ = fh_empty_group();
+  slots_ = nullptr;
+  size_ = 0;
+  capacity_ = 0;
+  growth_left_ = 0;
+}
+
+// destroy_table 函数
+// 销毁所有元素并释放空间
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+destroy_table() noexcept
+{
+  if (capacity_ == 0)
+    return;
+  if (!std::is_trivially_destructible<T>::value)
+  {
+    for (size_type i = 0; i < capacity_; ++i)
+    {
+      if (fh_is_full(ctrl_[i]))
+        mystl::destroy(slots_ + i);
+    }
+  }
+  ctrl_allocator::deallocate(ctrl_, capacity_ + fh_group::width);
+  data_allocator::deallocate(slots_, capacity_);
+}
+
+// copy_init 函数
+// 按 rhs 的元素个数分配空间后逐个插入，不需要比较键值
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+copy_init(const flat_hashtable& rhs)
+{
+  if (rhs.size_ == 0)
+    return;
+  resize(normalize_capacity(growth_to_lower_bound(rhs.size_)));
+  try
+  {
+    for (auto it = rhs.begin(), last = rhs.end(); it != last; ++it)
+    {
+      const auto h = hash_of(value_traits::get_key(*it));
+      const auto i = find_first_non_full(h);
+      mystl::construct(slots_ + i, *it);
+      set_ctrl(i, fh_h2(h));
+      ++size_;
+      --growth_left_;
+    }
+  }
+  catch (...)
+  {
+    destroy_table();
+    reset_empty();
+    throw;
+  }
+}
+
+// set_ctrl 函数
+// 设置第 i 个控制字节，i 小于 width - 1 时同时设置它在数组末尾的副本
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+set_ctrl(size_type i, fh_ctrl_type c) noexcept
+{
+  ctrl_[i] = c;
+  ctrl_[((i - (fh_group::width - 1)) & capacity_) + ((fh_group::width - 1) & capacity_)] = c;
+}
+
+// find_index 函数
+// 查找键值为 key 的元素所在的位置，找不到时返回 capacity_
+template <class T, class Hash, class KeyEqual>
+template <class K>
+typename flat_hashtable<T, Hash, KeyEqual>::size_type
+flat_hashtable<T, Hash, KeyEqual>::
+find_index(const K& key, size_type h) const
+{
+  fh_probe_seq seq(fh_h1(h), capacity_);
+  const auto h2 = fh_h2(h);
+  while (true)
+  {
+    fh_group g(ctrl_ + seq.offset);
+    for (auto m = g.match(h2); m; ++m)
+    {
+      const auto i = seq.offset_at(m.lowest());
+      if (equal_(value_traits::get_key(slots_[i]), key))
+        return i;
+    }
+    if (g.match_empty())
+      return capacity_;
+    seq.next();
+  }
+}
+
+// find_first_non_full 函数
+// 沿探测序列找到第一个空位或已删除的位置
+template <class T, class Hash, class KeyEqual>
+typename flat_hashtable<T, Hash, KeyEqual>::size_type
+flat_hashtable<T, Hash, KeyEqual>::
+find_first_non_full(size_type h) const noexcept
+{
+  fh_probe_seq seq(fh_h1(h), capacity_);
+  while (true)
+  {
+    auto m = fh_group(ctrl_ + seq.offset).match_empty_or_deleted();
+    if (m)
+      return seq.offset_at(m.lowest());
+    seq.next();
+  }
+}
+
+// insert_new 函数
+// 在确定键值不存在后插入新元素。需要扩容时先构造出新元素再扩容，因为 args 可能引用表中的元素
+template <class T, class Hash, class KeyEqual>
+template <class ...Args>
+typename flat_hashtable<T, Hash, KeyEqual>::iterator
+flat_hashtable<T, Hash, KeyEqual>::
+insert_new(size_type h, Args&& ...args)
+{
+  auto i = find_first_non_full(h);
+  if (growth_left_ == 0 && ctrl_[i] != fh_deleted)
+  {
+    value_type value(mystl::forward<Args>(args)...);
+    rehash_and_grow_if_necessary();
+    i = find_first_non_full(h);
+    mystl::construct(slots_ + i, mystl::move(value));
+  }
+  else
+  {
+    mystl::construct(slots_ + i, mystl::forward<Args>(args)...);
+  }
+  if (ctrl_[i] == fh_empty)
+    --growth_left_;
+  set_ctrl(i, fh_h2(h));
+  ++size_;
+  return iterator_at(i);
+}
+
+// rehash_and_grow_if_necessary 函数
+// 已删除的位置较多时以原容量重建以清除它们，否则容量翻倍
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+rehash_and_grow_if_necessary()
+{
+  if (capacity_ == 0)
+    resize(1);
+  else if (capacity_ > fh_group::width && size_ * 32 <= capacity_ * 25)
+    resize(capacity_);
+  else
+    resize(capacity_ * 2 + 1);
+}
+
+// resize 函数
+// 分配新的控制字节与槽数组，把元素逐个移入
+template <class T, class Hash, class KeyEqual>
+void flat_hashtable<T, Hash, KeyEqual>::
+resize(size_type new_capacity)
+{
+  THROW_LENGTH_ERROR_IF(new_capacity > max_size(), "flat_hashtable<T>'s size too big");
+  auto new_ctrl = ctrl_allocator::allocate(new_capacity + fh_group::width);
+  pointer new_slots = nullptr;
+  try
+  {
+    new_slots = data_allocator::allocate(new_capacity);
+  }
+  catch (...)
+  {
+    ctrl_allocator::deallocate(new_ctrl, new_capacity + fh_group::width);
+    throw;
+  }
+  mystl::fill_n(new_ctrl, new_capacity + fh_group::width, fh_empty);
+  new_ctrl[new_capacity] = fh_sentinel;
+
+  auto old_ctrl = ctrl_;
+  auto old_slots = slots_;
+  const auto old_capacity = capacity_;
+  ctrl_ = new_ctrl;
+  slots_ = new_slots;
+  capacity_ = new_capacity;
+  growth_left_ = capacity_to_growth(new_capacity) - size_;
+  for (size_type i = 0; i < old_capacity; ++i)
+  {
+    if (fh_is_full(old_ctrl[i]))
+    {
+      const auto h = hash_of(value_traits::get_key(old_slots[i]));
+      const auto target = find_first_non_full(h);
+      mystl::construct(slots_ + target, mystl::move(old_slots[i]));
+      set_ctrl(target, fh_h2(h));
+      mystl::destroy(old_slots + i);
+    }
+  }
+  if (old_capacity != 0)
+  {
+    ctrl_allocator::deallocate(old_ctrl, old_capacity + fh_group::width);
+    data_allocator::deallocate(old_slots, old_capacity);
+  }
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_HASHTABLE_H_
+
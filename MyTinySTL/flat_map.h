@@ -0,0 +1,465 @@
+#ifndef MYTINYSTL_FLAT_MAP_H_
+#define MYTINYSTL_FLAT_MAP_H_
+
+// 这个头文件包含一个模板类 flat_map
+// flat_map : 映射，元素按键值大小有序地存放在 mystl::vector 中，键值不允许重复
+
+// notes:
+//
+// flat_map 以连续空间代替 rb_tree 的节点，查找使用二分查找，适合构建一次后多次查询的场景
+// 单个元素的插入与删除需要搬移元素，复杂度为 O(n)，批量插入请使用 insert(first, last)，
+// 它会把新元素追加到尾部，做一次 sort + unique 后与原有元素归并，整体为 O(n + k log k)
+// 若输入已经有序且无重复，可以使用 insert(sorted_unique, first, last) 省去排序
+//
+// 与 map 不同，插入、删除会使迭代器失效，value_type 为 pair<Key, T>，不要通过迭代器修改键值
+//
+// 异常保证：
+// mystl::flat_map<Key, T> 满足基本异常保证，对以下等函数做强异常安全保证：
+//   * emplace
+//   * emplace_hint
+//   * insert(value)
+
+#include "vector.h"
+#include "algo.h"
+#include "functional.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类 flat_map，键值不允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl::less
+template <class Key, class T, class Compare = mystl::less<Key>>
+class flat_map
+{
+public:
+  // flat_map 的嵌套型别定义
+  typedef Key                        key_type;
+  typedef T                          mapped_type;
+  typedef mystl::pair<Key, T>        value_type;
+  typedef Compare                    key_compare;
+
+  // 定义一个 functor，用来进行元素比较
+  class value_compare : public binary_function <value_type, value_type, bool>
+  {
+    friend class flat_map<Key, T, Compare>;
+  private:
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+  public:
+    bool operator()(const value_type& lhs, const value_type& rhs) const
+    {
+      return comp(lhs.first, rhs.first);  // 比较键值的大小
+    }
+  };
+
+private:
+  // 以 mystl::vector 作为底层机制
+  typedef mystl::vector<value_type>  base_type;
+  base_type   data_;
+  key_compare comp_;
+
+public:
+  // 使用 vector 的型别
+  typedef typename base_type::pointer                pointer;
+  typedef typename base_type::const_pointer          const_pointer;
+  typedef typename base_type::reference              reference;
+  typedef typename base_type::const_reference        const_reference;
+  typedef typename base_type::iterator               iterator;
+  typedef typename base_type::const_iterator         const_iterator;
+  typedef typename base_type::reverse_iterator       reverse_iterator;
+  typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+  typedef typename base_type::size_type              size_type;
+  typedef typename base_type::difference_type        difference_type;
+  typedef typename base_type::allocator_type         allocator_type;
+
+public:
+  // 构造、复制、移动、赋值函数
+
+  flat_map() = default;
+
+  template <class InputIterator>
+  flat_map(InputIterator first, InputIterator last)
+    :data_(), comp_()
+  { insert(first, last); }
+
+  template <class InputIterator>
+  flat_map(sorted_unique_t, InputIterator first, InputIterator last)
+    :data_(first, last), comp_()
+  {
+  }
+
+  flat_map(std::initializer_list<value_type> ilist)
+    :data_(), comp_()
+  { insert(ilist.begin(), ilist.end()); }
+
+  flat_map(const flat_map& rhs)
+    :data_(rhs.data_), comp_(rhs.comp_)
+  {
+  }
+  flat_map(flat_map&& rhs) noexcept
+    :data_(mystl::move(rhs.data_)), comp_(rhs.comp_)
+  {
+  }
+
+  flat_map& operator=(const flat_map& rhs)
+  {
+    data_ = rhs.data_;
+    comp_ = rhs.comp_;
+    return *this;
+  }
+  flat_map& operator=(flat_map&& rhs)
+  {
+    data_ = mystl::move(rhs.data_);
+    comp_ = rhs.comp_;
+    return *this;
+  }
+
+  flat_map& operator=(std::initializer_list<value_type> ilist)
+  {
+    data_.clear();
+    insert(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  // 相关接口
+
+  key_compare            key_comp()      const { return comp_; }
+  value_compare          value_comp()    const { return value_compare(comp_); }
+  allocator_type         get_allocator() const { return allocator_type(); }
+
+  // 迭代器相关
+
+  iterator               begin()         noexcept
+  { return data_.begin(); }
+  const_iterator         begin()   const noexcept
+  { return data_.begin(); }
+  iterator               end()           noexcept
+  { return data_.end(); }
+  const_iterator         end()     const noexcept
+  { return data_.end(); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关
+  bool                   empty()    const noexcept { return data_.empty(); }
+  size_type              size()     const noexcept { return data_.size(); }
+  size_type              max_size() const noexcept { return data_.max_size(); }
+  size_type              capacity() const noexcept { return data_.capacity(); }
+
+  void                   reserve(size_type n)      { data_.reserve(n); }
+  void                   shrink_to_fit()           { data_.shrink_to_fit(); }
+
+  // 访问元素相关
+
+  // 若键值不存在，at 会抛出一个异常
+  mapped_type& at(const key_type& key)
+  {
+    iterator it = lower_bound(key);
+    THROW_OUT_OF_RANGE_IF(it == end() || comp_(key, it->first),
+                          "flat_map<Key, T> no such element exists");
+    return it->second;
+  }
+  const mapped_type& at(const key_type& key) const
+  {
+    const_iterator it = lower_bound(key);
+    THROW_OUT_OF_RANGE_IF(it == end() || comp_(key, it->first),
+                          "flat_map<Key, T> no such element exists");
+    return it->second;
+  }
+
+  mapped_type& operator[](const key_type& key)
+  {
+    iterator it = lower_bound(key);
+    if (it == end() || comp_(key, it->first))
+      it = data_.emplace(it, key, T{});
+    return it->second;
+  }
+  mapped_type& operator[](key_type&& key)
+  {
+    iterator it = lower_bound(key);
+    if (it == end() || comp_(key, it->first))
+      it = data_.emplace(it, mystl::move(key), T{});
+    return it->second;
+  }
+
+  // 插入删除相关
+
+  template <class ...Args>
+  pair<iterator, bool> emplace(Args&& ...args)
+  {
+    value_type value(mystl::forward<Args>(args)...);
+    iterator it = lower_bound(value.first);
+    if (it != end() && !comp_(value.first, it->first))
+      return mystl::make_pair(it, false);
+    return mystl::make_pair(data_.emplace(it, mystl::move(value)), true);
+  }
+
+  template <class ...Args>
+  iterator emplace_hint(const_iterator hint, Args&& ...args);
+
+  pair<iterator, bool> insert(const value_type& value)
+  {
+    return emplace(value);
+  }
+  pair<iterator, bool> insert(value_type&& value)
+  {
+    return emplace(mystl::move(value));
+  }
+
+  iterator insert(const_iterator hint, const value_type& value)
+  {
+    return emplace_hint(hint, value);
+  }
+  iterator insert(const_iterator hint, value_type&& value)
+  {
+    return emplace_hint(hint, mystl::move(value));
+  }
+
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last);
+
+  template <class InputIterator>
+  void insert(sorted_unique_t, InputIterator first, InputIterator last);
+
+  void insert(std::initializer_list<value_type> ilist)
+  {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  iterator  erase(const_iterator position)                   { return data_.erase(position); }
+  size_type erase(const key_type& key);
+  iterator  erase(const_iterator first, const_iterator last) { return data_.erase(first, last); }
+
+  void      clear()                                          { data_.clear(); }
+
+  // flat_map 相关操作
+
+  iterator       find(const key_type& key)
+  {
+    iterator it = lower_bound(key);
+    return (it == end() || comp_(key, it->first)) ? end() : it;
+  }
+  const_iterator find(const key_type& key)        const
+  {
+    const_iterator it = lower_bound(key);
+    return (it == end() || comp_(key, it->first)) ? end() : it;
+  }
+
+  size_type      count(const key_type& key)       const { return find(key) == end() ? 0 : 1; }
+  bool           contains(const key_type& key)    const { return find(key) != end(); }
+
+  iterator       lower_bound(const key_type& key)
+  { return const_cast<iterator>(static_cast<const flat_map&>(*this).lower_bound(key)); }
+  const_iterator lower_bound(const key_type& key) const;
+
+  iterator       upper_bound(const key_type& key)
+  { return const_cast<iterator>(static_cast<const flat_map&>(*this).upper_bound(key)); }
+  const_iterator upper_bound(const key_type& key) const;
+
+  pair<iterator, iterator>
+    equal_range(const key_type& key)
+  {
+    iterator it = lower_bound(key);
+    return mystl::make_pair(it, (it == end() || comp_(key, it->first)) ? it : it + 1);
+  }
+
+  pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const
+  {
+    const_iterator it = lower_bound(key);
+    return mystl::make_pair(it, (it == end() || comp_(key, it->first)) ? it : it + 1);
+  }
+
+  void           swap(flat_map& rhs) noexcept
+  {
+    data_.swap(rhs.data_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+
+private:
+  // helper functions
+  void merge_tail(size_type n);
+
+public:
+  friend bool operator==(const flat_map& lhs, const flat_map& rhs) { return lhs.data_ == rhs.data_; }
+  friend bool operator< (const flat_map& lhs, const flat_map& rhs) { return lhs.data_ <  rhs.data_; }
+};
+
+/*****************************************************************************************/
+
+// 在 hint 附近就地插入元素，hint 位置正确时省去二分查找
+template <class Key, class T, class Compare>
+template <class ...Args>
+typename flat_map<Key, T, Compare>::iterator
+flat_map<Key, T, Compare>::
+emplace_hint(const_iterator hint, Args&& ...args)
+{
+  value_type value(mystl::forward<Args>(args)...);
+  // hint 合法的条件：前一个元素小于 value，且 hint 处的元素大于 value
+  if ((hint == begin() || comp_((hint - 1)->first, value.first)) &&
+      (hint == end() || comp_(value.first, hint->first)))
+  {
+    return data_.emplace(hint, mystl::move(value));
+  }
+  return emplace(mystl::move(value)).first;
+}
+
+// 批量插入元素，把新元素追加到尾部后排序、去重并与原有元素归并
+template <class Key, class T, class Compare>
+template <class InputIterator>
+void flat_map<Key, T, Compare>::
+insert(InputIterator first, InputIterator last)
+{
+  const size_type n = data_.size();
+  data_.insert(data_.end(), first, last);
+  mystl::sort(data_.begin() + n, data_.end(), value_comp());
+  merge_tail(n);
+}
+
+// 批量插入已有序且无重复的元素，省去排序
+template <class Key, class T, class Compare>
+template <class InputIterator>
+void flat_map<Key, T, Compare>::
+insert(sorted_unique_t, InputIterator first, InputIterator last)
+{
+  const size_type n = data_.size();
+  data_.insert(data_.end(), first, last);
+  merge_tail(n);
+}
+
+// 删除键值为 key 的元素，返回删除的个数
+template <class Key, class T, class Compare>
+typename flat_map<Key, T, Compare>::size_type
+flat_map<Key, T, Compare>::
+erase(const key_type& key)
+{
+  iterator it = find(key);
+  if (it == end())
+    return 0;
+  data_.erase(it);
+  return 1;
+}
+
+// 键值不小于 key 的第一个位置
+template <class Key, class T, class Compare>
+typename flat_map<Key, T, Compare>::const_iterator
+flat_map<Key, T, Compare>::
+lower_bound(const key_type& key) const
+{
+  const_iterator first = begin();
+  size_type len = size();
+  while (len > 0)
+  {
+    const size_type half = len >> 1;
+    const_iterator middle = first + half;
+    if (comp_(middle->first, key))
+    {
+      first = middle + 1;
+      len = len - half - 1;
+    }
+    else
+    {
+      len = half;
+    }
+  }
+  return first;
+}
+
+// 键值大于 key 的第一个位置
+template <class Key, class T, class Compare>
+typename flat_map<Key, T, Compare>::const_iterator
+flat_map<Key, T, Compare>::
+upper_bound(const key_type& key) const
+{
+  const_iterator first = begin();
+  size_type len = size();
+  while (len > 0)
+  {
+    const size_type half = len >> 1;
+    const_iterator middle = first + half;
+    if (comp_(key, middle->first))
+    {
+      len = half;
+    }
+    else
+    {
+      first = middle + 1;
+      len = len - half - 1;
+    }
+  }
+  return first;
+}
+
+// merge_tail 函数
+// [begin, begin + n) 为原有元素，[begin + n, end) 为已排序的新元素
+// 先对新元素去重，再做一次稳定的归并，键值相同时保留原有元素
+template <class Key, class T, class Compare>
+void flat_map<Key, T, Compare>::
+merge_tail(size_type n)
+{
+  const auto comp = comp_;
+  auto equiv = [comp](const value_type& lhs, const value_type& rhs)
+  { return !comp(lhs.first, rhs.first); };
+  iterator middle = data_.begin() + n;
+  data_.erase(mystl::unique(middle, data_.end(), equiv), data_.end());
+  if (middle == data_.begin() || middle == data_.end() ||
+      comp_((middle - 1)->first, middle->first))
+  { // 新元素全部位于原有元素之后，无需归并
+    return;
+  }
+  mystl::inplace_merge(data_.begin(), middle, data_.end(), value_comp());
+  data_.erase(mystl::unique(data_.begin(), data_.end(), equiv), data_.end());
+}
+
+// 重载比较操作符
+template <class Key, class T, class Compare>
+bool operator!=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Key, class T, class Compare>
+bool operator<=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Compare>
+void swap(flat_map<Key, T, Compare>& lhs, flat_map<Key, T, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_MAP_H_
+
@@ -0,0 +1,362 @@
+#ifndef MYTINYSTL_FLAT_SET_H_
+#define MYTINYSTL_FLAT_SET_H_
+
+// 这个头文件包含一个模板类 flat_set
+// flat_set : 集合，元素有序地存放在 mystl::vector 中，键值不允许重复
+
+// notes:
+//
+// flat_set 以连续空间代替 rb_tree 的节点，查找使用二分查找，适合构建一次后多次查询的场景
+// 单个元素的插入与删除需要搬移元素，复杂度为 O(n)，批量插入请使用 insert(first, last)，
+// 它会把新元素追加到尾部，做一次 sort + unique 后与原有元素归并，整体为 O(n + k log k)
+// 若输入已经有序且无重复，可以使用 insert(sorted_unique, first, last) 省去排序
+//
+// 与 set 不同，插入、删除会使迭代器失效
+//
+// 异常保证：
+// mystl::flat_set<Key> 满足基本异常保证，对以下等函数做强异常安全保证：
+//   * emplace
+//   * emplace_hint
+//   * insert(value)
+
+#include "vector.h"
+#include "algo.h"
+#include "functional.h"
+
+namespace mystl
+{
+
+// 模板类 flat_set，键值不允许重复
+// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mystl::less
+template <class Key, class Compare = mystl::less<Key>>
+class flat_set
+{
+public:
+  typedef Key        key_type;
+  typedef Key        value_type;
+  typedef Compare    key_compare;
+  typedef Compare    value_compare;
+
+private:
+  // 以 mystl::vector 作为底层机制
+  typedef mystl::vector<value_type>  base_type;
+  base_type   data_;
+  key_compare comp_;
+
+public:
+  // 使用 vector 定义的型别
+  typedef typename base_type::const_pointer          pointer;
+  typedef typename base_type::const_pointer          const_pointer;
+  typedef typename base_type::const_reference        reference;
+  typedef typename base_type::const_reference        const_reference;
+  typedef typename base_type::const_iterator         iterator;
+  typedef typename base_type::const_iterator         const_iterator;
+  typedef typename base_type::const_reverse_iterator reverse_iterator;
+  typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+  typedef typename base_type::size_type              size_type;
+  typedef typename base_type::difference_type        difference_type;
+  typedef typename base_type::allocator_type         allocator_type;
+
+public:
+  // 构造、复制、移动函数
+  flat_set() = default;
+
+  template <class InputIterator>
+  flat_set(InputIterator first, InputIterator last)
+    :data_(), comp_()
+  { insert(first, last); }
+
+  template <class InputIterator>
+  flat_set(sorted_unique_t, InputIterator first, InputIterator last)
+    :data_(first, last), comp_()
+  {
+  }
+
+  flat_set(std::initializer_list<value_type> ilist)
+    :data_(), comp_()
+  { insert(ilist.begin(), ilist.end()); }
+
+  flat_set(const flat_set& rhs)
+    :data_(rhs.data_), comp_(rhs.comp_)
+  {
+  }
+  flat_set(flat_set&& rhs) noexcept
+    :data_(mystl::move(rhs.data_)), comp_(rhs.comp_)
+  {
+  }
+
+  flat_set& operator=(const flat_set& rhs)
+  {
+    data_ = rhs.data_;
+    comp_ = rhs.comp_;
+    return *this;
+  }
+  flat_set& operator=(flat_set&& rhs)
+  {
+    data_ = mystl::move(rhs.data_);
+    comp_ = rhs.comp_;
+    return *this;
+  }
+  flat_set& operator=(std::initializer_list<value_type> ilist)
+  {
+    data_.clear();
+    insert(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  // 相关接口
+  key_compare            key_comp()      const { return comp_; }
+  value_compare          value_comp()    const { return comp_; }
+  allocator_type         get_allocator() const { return allocator_type(); }
+
+  // 迭代器相关
+  iterator               begin()         noexcept
+  { return data_.begin(); }
+  const_iterator         begin()   const noexcept
+  { return data_.begin(); }
+  iterator               end()           noexcept
+  { return data_.end(); }
+  const_iterator         end()     const noexcept
+  { return data_.end(); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关
+  bool                   empty()    const noexcept { return data_.empty(); }
+  size_type              size()     const noexcept { return data_.size(); }
+  size_type              max_size() const noexcept { return data_.max_size(); }
+  size_type              capacity() const noexcept { return data_.capacity(); }
+
+  void                   reserve(size_type n)      { data_.reserve(n); }
+  void                   shrink_to_fit()           { data_.shrink_to_fit(); }
+
+  // 插入删除操作
+  template <class ...Args>
+  pair<iterator, bool> emplace(Args&& ...args)
+  {
+    value_type value(mystl::forward<Args>(args)...);
+    iterator it = lower_bound(value);
+    if (it != end() && !comp_(value, *it))
+      return mystl::make_pair(it, false);
+    return mystl::make_pair(iterator(data_.emplace(it, mystl::move(value))), true);
+  }
+
+  template <class ...Args>
+  iterator emplace_hint(iterator hint, Args&& ...args);
+
+  pair<iterator, bool> insert(const value_type& value)
+  {
+    return emplace(value);
+  }
+  pair<iterator, bool> insert(value_type&& value)
+  {
+    return emplace(mystl::move(value));
+  }
+
+  iterator insert(iterator hint, const value_type& value)
+  {
+    return emplace_hint(hint, value);
+  }
+  iterator insert(iterator hint, value_type&& value)
+  {
+    return emplace_hint(hint, mystl::move(value));
+  }
+
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last);
+
+  template <class InputIterator>
+  void insert(sorted_unique_t, InputIterator first, InputIterator last);
+
+  void insert(std::initializer_list<value_type> ilist)
+  {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  iterator  erase(iterator position)             { return data_.erase(position); }
+  size_type erase(const key_type& key);
+  iterator  erase(iterator first, iterator last) { return data_.erase(first, last); }
+
+  void      clear()                              { data_.clear(); }
+
+  // flat_set 相关操作
+
+  iterator       find(const key_type& key)
+  {
+    iterator it = lower_bound(key);
+    return (it == end() || comp_(key, *it)) ? end() : it;
+  }
+  const_iterator find(const key_type& key)        const
+  {
+    const_iterator it = lower_bound(key);
+    return (it == end() || comp_(key, *it)) ? end() : it;
+  }
+
+  size_type      count(const key_type& key)       const { return find(key) == end() ? 0 : 1; }
+  bool           contains(const key_type& key)    const { return find(key) != end(); }
+
+  iterator       lower_bound(const key_type& key)
+  { return mystl::lower_bound(begin(), end(), key, comp_); }
+  const_iterator lower_bound(const key_type& key) const
+  { return mystl::lower_bound(begin(), end(), key, comp_); }
+
+  iterator       upper_bound(const key_type& key)
+  { return mystl::upper_bound(begin(), end(), key, comp_); }
+  const_iterator upper_bound(const key_type& key) const
+  { return mystl::upper_bound(begin(), end(), key, comp_); }
+
+  pair<iterator, iterator>
+    equal_range(const key_type& key)
+  {
+    iterator it = lower_bound(key);
+    return mystl::make_pair(it, (it == end() || comp_(key, *it)) ? it : it + 1);
+  }
+
+  pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const
+  {
+    const_iterator it = lower_bound(key);
+    return mystl::make_pair(it, (it == end() || comp_(key, *it)) ? it : it + 1);
+  }
+
+  void swap(flat_set& rhs) noexcept
+  {
+    data_.swap(rhs.data_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+
+private:
+  // helper functions
+  void merge_tail(size_type n);
+
+public:
+  friend bool operator==(const flat_set& lhs, const flat_set& rhs) { return lhs.data_ == rhs.data_; }
+  friend bool operator< (const flat_set& lhs, const flat_set& rhs) { return lhs.data_ <  rhs.data_; }
+};
+
+/*****************************************************************************************/
+
+// 在 hint 附近就地插入元素，hint 位置正确时省去二分查找
+template <class Key, class Compare>
+template <class ...Args>
+typename flat_set<Key, Compare>::iterator
+flat_set<Key, Compare>::
+emplace_hint(iterator hint, Args&& ...args)
+{
+  value_type value(mystl::forward<Args>(args)...);
+  // hint 合法的条件：前一个元素小于 value，且 hint 处的元素大于 value
+  if ((hint == begin() || comp_(*(hint - 1), value)) &&
+      (hint == end() || comp_(value, *hint)))
+  {
+    return data_.emplace(hint, mystl::move(value));
+  }
+  return emplace(mystl::move(value)).first;
+}
+
+// 批量插入元素，把新元素追加到尾部后排序、去重并与原有元素归并
+template <class Key, class Compare>
+template <class InputIterator>
+void flat_set<Key, Compare>::
+insert(InputIterator first, InputIterator last)
+{
+  const size_type n = data_.size();
+  data_.insert(data_.end(), first, last);
+  mystl::sort(data_.begin() + n, data_.end(), comp_);
+  merge_tail(n);
+}
+
+// 批量插入已有序且无重复的元素，省去排序
+template <class Key, class Compare>
+template <class InputIterator>
+void flat_set<Key, Compare>::
+insert(sorted_unique_t, InputIterator first, InputIterator last)
+{
+  const size_type n = data_.size();
+  data_.insert(data_.end(), first, last);
+  merge_tail(n);
+}
+
+// 删除键值为 key 的元素，返回删除的个数
+template <class Key, class Compare>
+typename flat_set<Key, Compare>::size_type
+flat_set<Key, Compare>::
+erase(const key_type& key)
+{
+  iterator it = find(key);
+  if (it == end())
+    return 0;
+  data_.erase(it);
+  return 1;
+}
+
+// merge_tail 函数
+// [begin, begin + n) 为原有元素，[begin + n, end) 为已排序的新元素
+// 先对新元素去重，再做一次稳定的归并，键值相同时保留原有元素
+template <class Key, class Compare>
+void flat_set<Key, Compare>::
+merge_tail(size_type n)
+{
+  const auto comp = comp_;
+  auto equiv = [comp](const value_type& lhs, const value_type& rhs)
+  { return !comp(lhs, rhs); };
+  auto middle = data_.begin() + n;
+  data_.erase(mystl::unique(middle, data_.end(), equiv), data_.end());
+  if (middle == data_.begin() || middle == data_.end() || comp_(*(middle - 1), *middle))
+  { // 新元素全部位于原有元素之后，无需归并
+    return;
+  }
+  mystl::inplace_merge(data_.begin(), middle, data_.end(), comp_);
+  data_.erase(mystl::unique(data_.begin(), data_.end(), equiv), data_.end());
+}
+
+// 重载比较操作符
+template <class Key, class Compare>
+bool operator!=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Key, class Compare>
+bool operator>(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Key, class Compare>
+bool operator<=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Key, class Compare>
+bool operator>=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class Compare>
+void swap(flat_set<Key, Compare>& lhs, flat_set<Key, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_SET_H_
+
@@ -0,0 +1,858 @@
+#ifndef MYTINYSTL_FORWARD_LIST_H_
+#define MYTINYSTL_FORWARD_LIST_H_
+
+// 这个头文件包含了一个模板类 forward_list
+// forward_list : 单向链表
+
+// notes:
+//
+// 每个节点只保存一个后继指针，链表以 nullptr 结尾，不记录元素个数
+// 异常保证：
+// mystl::forward_list<T> 满足基本异常保证，部分函数无异常保证，并对以下等函数做强异常安全保证：
+//   * emplace_front
+//   * emplace_after
+//   * push_front
+//   * insert_after
+
+#include <initializer_list>
+
+#include "iterator.h"
+#include "memory.h"
+#include "functional.h"
+#include "util.h"
+#include "exceptdef.h"
+#include "node_pool.h"
+
+namespace mystl
+{
+
+// forward_list 的节点是否从 node_pool 中按块分配
+#ifndef FORWARD_LIST_USE_NODE_POOL
+#define FORWARD_LIST_USE_NODE_POOL 1
+#endif
+
+template <class T> struct forward_list_node_base;
+template <class T> struct forward_list_node;
+
+template <class T>
+struct forward_list_node_traits
+{
+  typedef forward_list_node_base<T>* base_ptr;
+  typedef forward_list_node<T>*      node_ptr;
+};
+
+// forward_list 的节点结构
+
+template <class T>
+struct forward_list_node_base
+{
+  typedef typename forward_list_node_traits<T>::base_ptr base_ptr;
+  typedef typename forward_list_node_traits<T>::node_ptr node_ptr;
+
+  base_ptr next = nullptr;  // 下一节点
+
+  node_ptr as_node()
+  {
+    return static_cast<node_ptr>(this);
+  }
+};
+
+template <class T>
+struct forward_list_node : public forward_list_node_base<T>
+{
+  typedef typename forward_list_node_traits<T>::base_ptr base_ptr;
+
+  T value;  // 数据域
+
+  base_ptr as_base()
+  {
+    return static_cast<base_ptr>(this);
+  }
+};
+
+// forward_list 的迭代器设计
+template <class T>
+struct forward_list_iterator : public mystl::iterator<mystl::forward_iterator_tag, T>
+{
+  typedef T                                               value_type;
+  typedef T*                                              pointer;
+  typedef T&                                              reference;
+  typedef typename forward_list_node_traits<T>::base_ptr  base_ptr;
+  typedef typename forward_list_node_traits<T>::node_ptr  node_ptr;
+  typedef forward_list_iterator<T>                        self;
+
+  base_ptr node_;  // 指向当前节点
+
+  // 构造函数
+  forward_list_iterator() = default;
+  forward_list_iterator(base_ptr x)
+    :node_(x) {}
+
+  // 重载操作符
+  reference operator*()  const { return node_->as_node()->value; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    node_ = node_->next;
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+  bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+template <class T>
+struct forward_list_const_iterator : public mystl::iterator<mystl::forward_iterator_tag, T>
+{
+  typedef T                                               value_type;
+  typedef const T*                                        pointer;
+  typedef const T&                                        reference;
+  typedef typename forward_list_node_traits<T>::base_ptr  base_ptr;
+  typedef typename forward_list_node_traits<T>::node_ptr  node_ptr;
+  typedef forward_list_const_iterator<T>                  self;
+
+  base_ptr node_;
+
+  forward_list_const_iterator() = default;
+  forward_list_const_iterator(base_ptr x)
+    :node_(x) {}
+  forward_list_const_iterator(const forward_list_iterator<T>& rhs)
+    :node_(rhs.node_) {}
+
+  reference operator*()  const { return node_->as_node()->value; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    node_ = node_->next;
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+  bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// 模板类: forward_list
+// 模板参数 T 代表数据类型
+template <class T>
+class forward_list
+{
+public:
+  // forward_list 的嵌套型别定义
+  typedef mystl::allocator<T>                         allocator_type;
+  typedef mystl::allocator<T>                         data_allocator;
+#if FORWARD_LIST_USE_NODE_POOL
+  typedef mystl::node_pool<forward_list_node<T>>      node_allocator;
+#else
+  typedef mystl::allocator<forward_list_node<T>>      node_allocator;
+#endif
+
+  typedef typename allocator_type::value_type         value_type;
+  typedef typename allocator_type::pointer            pointer;
+  typedef typename allocator_type::const_pointer      const_pointer;
+  typedef typename allocator_type::reference          reference;
+  typedef typename allocator_type::const_reference    const_reference;
+  typedef typename allocator_type::size_type          size_type;
+  typedef typename allocator_type::difference_type    difference_type;
+
+  typedef forward_list_iterator<T>                    iterator;
+  typedef forward_list_const_iterator<T>              const_iterator;
+
+  typedef typename forward_list_node_traits<T>::base_ptr base_ptr;
+  typedef typename forward_list_node_traits<T>::node_ptr node_ptr;
+
+  allocator_type get_allocator() { return allocator_type(); }
+
+private:
+  forward_list_node_base<T> head_;  // 头部之前的哨兵节点
+
+public:
+  // 构造、复制、移动、析构函数
+  forward_list() noexcept = default;
+
+  explicit forward_list(size_type n)
+  { insert_after(before_begin(), n, value_type()); }
+
+  forward_list(size_type n, const T& value)
+  { insert_after(before_begin(), n, value); }
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  forward_list(Iter first, Iter last)
+  { insert_after(before_begin(), first, last); }
+
+  forward_list(std::initializer_list<T> ilist)
+  { insert_after(before_begin(), ilist.begin(), ilist.end()); }
+
+  forward_list(const forward_list& rhs)
+  { insert_after(before_begin(), rhs.begin(), rhs.end()); }
+
+  forward_list(forward_list&& rhs) noexcept
+  {
+    head_.next = rhs.head_.next;
+    rhs.head_.next = nullptr;
+  }
+
+  forward_list& operator=(const forward_list& rhs)
+  {
+    if (this != &rhs)
+    {
+      assign(rhs.begin(), rhs.end());
+    }
+    return *this;
+  }
+
+  forward_list& operator=(forward_list&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      clear();
+      head_.next = rhs.head_.next;
+      rhs.head_.next = nullptr;
+    }
+    return *this;
+  }
+
+  forward_list& operator=(std::initializer_list<T> ilist)
+  {
+    assign(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  ~forward_list()
+  { clear(); }
+
+public:
+  // 迭代器相关操作
+  iterator       before_begin()        noexcept
+  { return &head_; }
+  const_iterator before_begin()  const noexcept
+  { return const_cast<base_ptr>(&head_); }
+  iterator       begin()               noexcept
+  { return head_.next; }
+  const_iterator begin()         const noexcept
+  { return head_.next; }
+  iterator       end()                 noexcept
+  { return nullptr; }
+  const_iterator end()           const noexcept
+  { return nullptr; }
+
+  const_iterator cbefore_begin() const noexcept
+  { return before_begin(); }
+  const_iterator cbegin()        const noexcept
+  { return begin(); }
+  const_iterator cend()          const noexcept
+  { return end(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept
+  { return head_.next == nullptr; }
+
+  size_type max_size() const noexcept
+  { return static_cast<size_type>(-1); }
+
+  // 访问元素相关操作
+  reference       front()
+  {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+
+  const_reference front() const
+  {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+
+  // 调整容器相关操作
+
+  // assign
+
+  void     assign(size_type n, const value_type& value);
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  void     assign(Iter first, Iter last);
+
+  void     assign(std::initializer_list<T> ilist)
+  { assign(ilist.begin(), ilist.end()); }
+
+  // emplace_front / emplace_after
+
+  template <class ...Args>
+  void     emplace_front(Args&& ...args)
+  { emplace_after(before_begin(), mystl::forward<Args>(args)...); }
+
+  template <class ...Args>
+  iterator emplace_after(const_iterator pos, Args&& ...args)
+  {
+    auto link_node = create_node(mystl::forward<Args>(args)...);
+    link_after(pos.node_, link_node->as_base(), link_node->as_base());
+    return link_node->as_base();
+  }
+
+  // insert_after
+
+  iterator insert_after(const_iterator pos, const value_type& value)
+  { return emplace_after(pos, value); }
+
+  iterator insert_after(const_iterator pos, value_type&& value)
+  { return emplace_after(pos, mystl::move(value)); }
+
+  iterator insert_after(const_iterator pos, size_type n, const value_type& value);
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  iterator insert_after(const_iterator pos, Iter first, Iter last);
+
+  iterator insert_after(const_iterator pos, std::initializer_list<T> ilist)
+  { return insert_after(pos, ilist.begin(), ilist.end()); }
+
+  // push_front / pop_front
+
+  void push_front(const value_type& value)
+  { emplace_after(before_begin(), value); }
+
+  void push_front(value_type&& value)
+  { emplace_after(before_begin(), mystl::move(value)); }
+
+  void pop_front()
+  {
+    MYSTL_DEBUG(!empty());
+    erase_after(before_begin());
+  }
+
+  // erase_after / clear
+
+  iterator erase_after(const_iterator pos);
+  iterator erase_after(const_iterator first, const_iterator last);
+
+  void     clear()
+  { erase_after(before_begin(), end()); }
+
+  // resize
+
+  void     resize(size_type new_size) { resize(new_size, value_type()); }
+  void     resize(size_type new_size, const value_type& value);
+
+  // 预先准备 n 个空闲节点，之后的插入不再向系统申请内存
+  void     reserve(size_type n)
+  {
+#if FORWARD_LIST_USE_NODE_POOL
+    node_allocator::reserve(n);
+#else
+    (void)n;
+#endif
+  }
+
+  void     swap(forward_list& rhs) noexcept
+  { mystl::swap(head_.next, rhs.head_.next); }
+
+  // forward_list 相关操作
+
+  void splice_after(const_iterator pos, forward_list& other);
+  void splice_after(const_iterator pos, forward_list& other, const_iterator it);
+  void splice_after(const_iterator pos, forward_list& other,
+                    const_iterator first, const_iterator last);
+
+  void remove(const value_type& value)
+  { remove_if([&](const value_type& v) {return v == value; }); }
+  template <class UnaryPredicate>
+  void remove_if(UnaryPredicate pred);
+
+  void unique()
+  { unique(mystl::equal_to<T>()); }
+  template <class BinaryPredicate>
+  void unique(BinaryPredicate pred);
+
+  void merge(forward_list& x)
+  { merge(x, mystl::less<T>()); }
+  template <class Compare>
+  void merge(forward_list& x, Compare comp);
+
+  void sort()
+  { sort(mystl::less<T>()); }
+  template <class Compared>
+  void sort(Compared comp);
+
+  void reverse() noexcept;
+
+private:
+  // helper functions
+
+  // create / destroy node
+  template <class ...Args>
+  node_ptr create_node(Args&& ...args);
+  void     destroy_node(node_ptr p);
+
+  // link
+  void     link_after(base_ptr pos, base_ptr first, base_ptr last);
+
+  // sort
+  template <class Compared>
+  void     merge_chain(base_ptr& a, base_ptr b, Compared comp);
+
+};
+
+/*****************************************************************************************/
+
+// 用 n 个元素为容器赋值
+template <class T>
+void forward_list<T>::assign(size_type n, const value_type& value)
+{
+  auto prev = before_begin();
+  auto i = begin();
+  auto e = end();
+  for (; n > 0 && i != e; --n, ++prev, ++i)
+  {
+    *i = value;
+  }
+  if (n > 0)
+  {
+    insert_after(prev, n, value);
+  }
+  else
+  {
+    erase_after(prev, e);
+  }
+}
+
+// 复制 [first, last) 为容器赋值
+template <class T>
+template <class Iter, typename std::enable_if<
+  mystl::is_input_iterator<Iter>::value, int>::type>
+void forward_list<T>::assign(Iter first, Iter last)
+{
+  auto prev = before_begin();
+  auto i = begin();
+  auto e = end();
+  for (; first != last && i != e; ++first, ++prev, ++i)
+  {
+    *i = *first;
+  }
+  if (first != last)
+  {
+    insert_after(prev, first, last);
+  }
+  else
+  {
+    erase_after(prev, e);
+  }
+}
+
+// 在 pos 之后插入 n 个元素，返回指向最后一个新元素的迭代器
+template <class T>
+typename forward_list<T>::iterator
+forward_list<T>::insert_after(const_iterator pos, size_type n, const value_type& value)
+{
+  forward_list tmp;
+  base_ptr last = &tmp.head_;
+  for (; n > 0; --n)
+  {
+    auto node = create_node(value);
+    last->next = node->as_base();
+    last = last->next;
+  }
+  if (last == &tmp.head_)
+    return pos.node_;
+  link_after(pos.node_, tmp.head_.next, last);
+  tmp.head_.next = nullptr;
+  return last;
+}
+
+// 在 pos 之后插入 [first, last) 的元素，返回指向最后一个新元素的迭代器
+template <class T>
+template <class Iter, typename std::enable_if<
+  mystl::is_input_iterator<Iter>::value, int>::type>
+typename forward_list<T>::iterator
+forward_list<T>::insert_after(const_iterator pos, Iter first, Iter last)
+{
+  forward_list tmp;
+  base_ptr tail = &tmp.head_;
+  for (; first != last; ++first)
+  {
+    auto node = create_node(*first);
+    tail->next = node->as_base();
+    tail = tail->next;
+  }
+  if (tail == &tmp.head_)
+    return pos.node_;
+  link_after(pos.node_, tmp.head_.next, tail);
+  tmp.head_.next = nullptr;
+  return tail;
+}
+
+// 删除 pos 之后的元素
+template <class T>
+typename forward_list<T>::iterator
+forward_list<T>::erase_after(const_iterator pos)
+{
+  MYSTL_DEBUG(pos.node_ != nullptr && pos.node_->next != nullptr);
+  auto n = pos.node_->next;
+  pos.node_->next = n->next;
+  destroy_node(n->as_node());
+  return pos.node_->next;
+}
+
+// 删除 (first, last) 内的元素
+template <class T>
+typename forward_list<T>::iterator
+forward_list<T>::erase_after(const_iterator first, const_iterator last)
+{
+  auto cur = first.node_->next;
+  first.node_->next = last.node_;
+  while (cur != last.node_)
+  {
+    auto next = cur->next;
+    destroy_node(cur->as_node());
+    cur = next;
+  }
+  return last.node_;
+}
+
+// 重置容器大小
+template <class T>
+void forward_list<T>::resize(size_type new_size, const value_type& value)
+{
+  auto prev = before_begin();
+  auto i = begin();
+  size_type len = 0;
+  for (; i != end() && len < new_size; ++prev, ++i, ++len)
+    ;
+  if (len == new_size)
+  {
+    erase_after(prev, end());
+  }
+  else
+  {
+    insert_after(prev, new_size - len, value);
+  }
+}
+
+// 将 x 的所有元素接合于 pos 之后
+template <class T>
+void forward_list<T>::splice_after(const_iterator pos, forward_list& x)
+{
+  MYSTL_DEBUG(this != &x);
+  if (!x.empty())
+  {
+    auto f = x.head_.next;
+    auto l = f;
+    while (l->next != nullptr)
+      l = l->next;
+    x.head_.next = nullptr;
+    link_after(pos.node_, f, l);
+  }
+}
+
+// 将 it 之后的一个元素接合于 pos 之后
+template <class T>
+void forward_list<T>::splice_after(const_iterator pos, forward_list&, const_iterator it)
+{
+  auto n = it.node_->next;
+  if (pos.node_ != it.node_ && pos.node_ != n)
+  {
+    it.node_->next = n->next;
+    link_after(pos.node_, n, n);
+  }
+}
+
+// 将 (first, last) 内的元素接合于 pos 之后
+template <class T>
+void forward_list<T>::splice_after(const_iterator pos, forward_list&,
+                                   const_iterator first, const_iterator last)
+{
+  auto f = first.node_->next;
+  if (f == last.node_ || pos.node_ == first.node_)
+    return;
+  auto l = f;
+  while (l->next != last.node_)
+    l = l->next;
+  first.node_->next = last.node_;
+  link_after(pos.node_, f, l);
+}
+
+// 将另一元操作 pred 为 true 的所有元素移除
+template <class T>
+template <class UnaryPredicate>
+void forward_list<T>::remove_if(UnaryPredicate pred)
+{
+  base_ptr prev = &head_;
+  while (prev->next != nullptr)
+  {
+    if (pred(prev->next->as_node()->value))
+    {
+      erase_after(prev);
+    }
+    else
+    {
+      prev = prev->next;
+    }
+  }
+}
+
+// 移除 forward_list 中满足 pred 为 true 重复元素
+template <class T>
+template <class BinaryPredicate>
+void forward_list<T>::unique(BinaryPredicate pred)
+{
+  base_ptr i = head_.next;
+  if (i == nullptr)
+    return;
+  while (i->next != nullptr)
+  {
+    if (pred(i->as_node()->value, i->next->as_node()->value))
+    {
+      erase_after(i);
+    }
+    else
+    {
+      i = i->next;
+    }
+  }
+}
+
+// 与另一个 forward_list 合并，按照 comp 为 true 的顺序
+// comp 抛出异常时，x 的节点都已移入 *this，顺序未定
+template <class T>
+template <class Compare>
+void forward_list<T>::merge(forward_list& x, Compare comp)
+{
+  if (this != &x)
+  {
+    auto b = x.head_.next;
+    x.head_.next = nullptr;
+    merge_chain(head_.next, b, comp);
+  }
+}
+
+// 对 forward_list 进行自底向上的归并排序，parts[i] 保存长度为 2^i 的有序段
+// comp 抛出异常时，把所有的段接成一条链挂回 head_ 上，forward_list 仍然有效，只是顺序未定
+template <class T>
+template <class Compared>
+void forward_list<T>::sort(Compared comp)
+{
+  if (head_.next == nullptr || head_.next->next == nullptr)
+    return;
+  base_ptr parts[64] = {};
+  size_type fill = 0;
+  base_ptr carry = nullptr;
+  base_ptr result = nullptr;
+  base_ptr cur = head_.next;
+  head_.next = nullptr;
+  try
+  {
+    while (cur != nullptr)
+    {
+      carry = cur;
+      cur = cur->next;
+      carry->next = nullptr;
+      size_type i = 0;
+      for (; i < fill && parts[i] != nullptr; ++i)
+      { // parts[i] 中的元素都在 carry 之前，放在第一个参数以保持稳定
+        auto b = carry;
+        carry = nullptr;
+        merge_chain(parts[i], b, comp);
+        carry = parts[i];
+        parts[i] = nullptr;
+      }
+      parts[i] = carry;
+      carry = nullptr;
+      if (i == fill)
+        ++fill;
+    }
+    for (size_type i = 0; i < fill; ++i)
+    {
+      if (parts[i] != nullptr)
+      {
+        auto b = result;
+        result = nullptr;
+        merge_chain(parts[i], b, comp);
+        result = parts[i];
+        parts[i] = nullptr;
+      }
+    }
+  }
+  catch (...)
+  {
+    // 每个节点都恰好在 cur、carry、result 与 parts 的某一条链中
+    base_ptr* tail = &head_.next;
+    auto append = [&tail](base_ptr chain) {
+      *tail = chain;
+      while (*tail != nullptr)
+        tail = &(*tail)->next;
+    };
+    append(result);
+    for (size_type i = 0; i < fill; ++i)
+      append(parts[i]);
+    append(carry);
+    append(cur);
+    throw;
+  }
+  head_.next = result;
+}
+
+// 将 forward_list 反转
+template <class T>
+void forward_list<T>::reverse() noexcept
+{
+  base_ptr prev = nullptr;
+  base_ptr cur = head_.next;
+  while (cur != nullptr)
+  {
+    auto next = cur->next;
+    cur->next = prev;
+    prev = cur;
+    cur = next;
+  }
+  head_.next = prev;
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 创建结点
+template <class T>
+template <class ...Args>
+typename forward_list<T>::node_ptr
+forward_list<T>::create_node(Args&& ...args)
+{
+  node_ptr p = node_allocator::allocate();
+  try
+  {
+    data_allocator::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+    p->next = nullptr;
+  }
+  catch (...)
+  {
+    node_allocator::deallocate(p);
+    throw;
+  }
+  return p;
+}
+
+// 销毁结点
+template <class T>
+void forward_list<T>::destroy_node(node_ptr p)
+{
+  data_allocator::destroy(mystl::address_of(p->value));
+  node_allocator::deallocate(p);
+}
+
+// 在 pos 之后连接 [first, last] 的结点
+template <class T>
+void forward_list<T>::link_after(base_ptr pos, base_ptr first, base_ptr last)
+{
+  last->next = pos->next;
+  pos->next = first;
+}
+
+// 合并 a、b 两条以 nullptr 结尾的有序链，结果放在 a 中，相等时 a 中的元素在前
+// comp 抛出异常时，a 中是包含两条链全部节点的一条链
+template <class T>
+template <class Compared>
+void forward_list<T>::merge_chain(base_ptr& a, base_ptr b, Compared comp)
+{
+  forward_list_node_base<T> head;
+  base_ptr tail = &head;
+  base_ptr x = a;
+  try
+  {
+    while (x != nullptr && b != nullptr)
+    {
+      if (comp(b->as_node()->value, x->as_node()->value))
+      {
+        tail->next = b;
+        b = b->next;
+      }
+      else
+      {
+        tail->next = x;
+        x = x->next;
+      }
+      tail = tail->next;
+    }
+  }
+  catch (...)
+  {
+    tail->next = x;
+    while (tail->next != nullptr)
+      tail = tail->next;
+    tail->next = b;
+    a = head.next;
+    throw;
+  }
+  tail->next = x != nullptr ? x : b;
+  a = head.next;
+}
+
+// 重载比较操作符
+template <class T>
+bool operator==(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+  auto f1 = lhs.cbegin();
+  auto f2 = rhs.cbegin();
+  auto l1 = lhs.cend();
+  auto l2 = rhs.cend();
+  for (; f1 != l1 && f2 != l2 && *f1 == *f2; ++f1, ++f2)
+    ;
+  return f1 == l1 && f2 == l2;
+}
+
+template <class T>
+bool operator<(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+  return mystl::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <class T>
+bool operator!=(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class T>
+bool operator>(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class T>
+bool operator<=(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class T>
+bool operator>=(const forward_list<T>& lhs, const forward_list<T>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T>
+void swap(forward_list<T>& lhs, forward_list<T>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_FORWARD_LIST_H_
+
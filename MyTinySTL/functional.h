@@ -4,6 +4,12 @@
 // 这个头文件包含了 mystl 的函数对象与哈希函数
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 namespace mystl
 {
@@ -76,12 +82,22 @@ template <class T>
 T identity_element(multiplies<T>) { return T(1); }
 
 // 函数对象：等于
-template <class T>
+template <class T = void>
 struct equal_to :public binary_function<T, T, bool>
 {
   bool operator()(const T& x, const T& y) const { return x == y; }
 };
 
+// equal_to<void> 可以比较任意两种类型，并定义 is_transparent，使关联式容器支持异构查找
+template <>
+struct equal_to<void>
+{
+  typedef int is_transparent;
+
+  template <class T1, class T2>
+  bool operator()(const T1& x, const T2& y) const { return x == y; }
+};
+
 // 函数对象：不等于
 template <class T>
 struct not_equal_to :public binary_function<T, T, bool>
@@ -90,19 +106,39 @@ struct not_equal_to :public binary_function<T, T, bool>
 };
 
 // 函数对象：大于
-template <class T>
+template <class T = void>
 struct greater :public binary_function<T, T, bool>
 {
   bool operator()(const T& x, const T& y) const { return x > y; }
 };
 
+// greater<void> 可以比较任意两种类型，并定义 is_transparent，使关联式容器支持异构查找
+template <>
+struct greater<void>
+{
+  typedef int is_transparent;
+
+  template <class T1, class T2>
+  bool operator()(const T1& x, const T2& y) const { return x > y; }
+};
+
 // 函数对象：小于
-template <class T>
+template <class T = void>
 struct less :public binary_function<T, T, bool>
 {
   bool operator()(const T& x, const T& y) const { return x < y; }
 };
 
+// less<void> 可以比较任意两种类型，并定义 is_transparent，使关联式容器支持异构查找
+template <>
+struct less<void>
+{
+  typedef int is_transparent;
+
+  template <class T1, class T2>
+  bool operator()(const T1& x, const T2& y) const { return x < y; }
+};
+
 // 函数对象：大于等于
 template <class T>
 struct greater_equal :public binary_function<T, T, bool>
@@ -186,20 +222,171 @@ struct projectsecond :public binary_function<Arg1, Arg2, Arg1>
 template <class Key>
 struct hash {};
 
+// 哈希函数的基本运算，参考 wyhash 的做法
+// 两个 64 位整数相乘，用 128 位乘积的高 64 位与低 64 位的异或作为结果，一次乘法就能让每一位影响全部结果位
+
+static constexpr uint64_t hash_secret[4] = {
+  0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+};
+
+// 计算 a * b，a 保存乘积的低 64 位，b 保存乘积的高 64 位
+inline void hash_mum(uint64_t& a, uint64_t& b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+  const __uint128_t r = static_cast<__uint128_t>(a) * b;
+  a = static_cast<uint64_t>(r);
+  b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  a = _umul128(a, b, &b);
+#else
+  const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+  const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const uint64_t t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  const uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  a = lo;
+  b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline uint64_t hash_mum_mix(uint64_t a, uint64_t b) noexcept
+{
+  hash_mum(a, b);
+  return a ^ b;
+}
+
+// 按小端读出 8 / 4 字节，不要求地址对齐
+inline uint64_t hash_read8(const unsigned char* p) noexcept
+{
+  uint64_t v;
+  std::memcpy(&v, p, 8);
+  return v;
+}
+
+inline uint64_t hash_read4(const unsigned char* p) noexcept
+{
+  uint32_t v;
+  std::memcpy(&v, p, 4);
+  return v;
+}
+
+// 不超过 3 个字节时，取首、中、尾三个字节
+inline uint64_t hash_read3(const unsigned char* p, size_t k) noexcept
+{
+  return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+// 整数的哈希值：与常数异或后做一次 mum
+inline size_t hash_int(uint64_t val) noexcept
+{
+  return static_cast<size_t>(hash_mum_mix(val ^ hash_secret[0], hash_secret[1]));
+}
+
+// 对一段字节求哈希值，每次读入 8 个字节
+// 不超过 16 个字节时只读首尾的两个字，超过 48 个字节时用三条互不依赖的链并行处理，让乘法可以流水执行
+inline size_t bitwise_hash(const unsigned char* first, size_t count)
+{
+  const unsigned char* p = first;
+  uint64_t seed = hash_mum_mix(hash_secret[0], hash_secret[1]);
+  uint64_t a, b;
+  if (count <= 16)
+  {
+    if (count >= 4)
+    {
+      const size_t off = (count >> 3) << 2;
+      a = (hash_read4(p) << 32) | hash_read4(p + off);
+      b = (hash_read4(p + count - 4) << 32) | hash_read4(p + count - 4 - off);
+    }
+    else if (count > 0)
+    {
+      a = hash_read3(p, count);
+      b = 0;
+    }
+    else
+    {
+      a = b = 0;
+    }
+  }
+  else
+  {
+    size_t i = count;
+    if (i > 48)
+    {
+      uint64_t see1 = seed, see2 = seed;
+      do
+      {
+        seed = hash_mum_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+        see1 = hash_mum_mix(hash_read8(p + 16) ^ hash_secret[2], hash_read8(p + 24) ^ see1);
+        see2 = hash_mum_mix(hash_read8(p + 32) ^ hash_secret[3], hash_read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16)
+    {
+      seed = hash_mum_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+      p += 16;
+      i -= 16;
+    }
+    // 最后 16 个字节可能与已处理的部分重叠，i 个字节之前仍在原串之内
+    a = hash_read8(p + i - 16);
+    b = hash_read8(p + i - 8);
+  }
+  a ^= hash_secret[1];
+  b ^= seed;
+  hash_mum(a, b);
+  return static_cast<size_t>(hash_mum_mix(a ^ hash_secret[0] ^ count, b ^ hash_secret[1]));
+}
+
+// 把哈希值的各位充分打散，供只取低位或高位的容器使用
+// 用户提供的哈希函数可能只是返回原值，直接取低位时规律的键值会冲突
+inline size_t hash_mix(size_t h) noexcept
+{
+#if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) &&__SIZEOF_POINTER__ == 8)
+  h ^= h >> 32;
+  h *= 0x9e3779b97f4a7c15ull;
+  h ^= h >> 29;
+#else
+  h ^= h >> 16;
+  h *= 0x9e3779b9u;
+  h ^= h >> 15;
+#endif
+  return h;
+}
+
+// 判断哈希函数是否声明了 is_avalanching，即结果的每一位都已充分打散，容器可以省去 hash_mix
+template <class Hash>
+struct hash_is_avalanching
+{
+private:
+  struct two { char a; char b; };
+  template <class U>
+  static two  test(...);
+  template <class U>
+  static char test(typename U::is_avalanching* = 0);
+
+public:
+  static constexpr bool value = sizeof(test<Hash>(0)) == sizeof(char);
+};
+
 // 针对指针的偏特化版本
 template <class T>
 struct hash<T*>
 {
+  typedef void is_avalanching;
   size_t operator()(T* p) const noexcept
-  { return reinterpret_cast<size_t>(p); }
+  { return hash_int(reinterpret_cast<uintptr_t>(p)); }
 };
 
-// 对于整型类型，只是返回原值
-#define MYSTL_TRIVIAL_HASH_FCN(Type)         \
-template <> struct hash<Type>                \
-{                                            \
-  size_t operator()(Type val) const noexcept \
-  { return static_cast<size_t>(val); }       \
+// 对于整型类型，用 hash_int 打散原值
+#define MYSTL_TRIVIAL_HASH_FCN(Type)                        \
+template <> struct hash<Type>                               \
+{                                                           \
+  typedef void is_avalanching;                              \
+  size_t operator()(Type val) const noexcept                \
+  { return hash_int(static_cast<uint64_t>(val)); }          \
 };
 
 MYSTL_TRIVIAL_HASH_FCN(bool)
@@ -235,27 +422,10 @@ MYSTL_TRIVIAL_HASH_FCN(unsigned long long)
 #undef MYSTL_TRIVIAL_HASH_FCN
 
 // 对于浮点数，逐位哈希
-inline size_t bitwise_hash(const unsigned char* first, size_t count)
-{
-#if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) &&__SIZEOF_POINTER__ == 8)
-  const size_t fnv_offset = 14695981039346656037ull;
-  const size_t fnv_prime = 1099511628211ull;
-#else
-  const size_t fnv_offset = 2166136261u;
-  const size_t fnv_prime = 16777619u;
-#endif
-  size_t result = fnv_offset;
-  for (size_t i = 0; i < count; ++i)
-  {
-    result ^= (size_t)first[i];
-    result *= fnv_prime;
-  }
-  return result;
-}
-
 template <>
 struct hash<float>
 {
+  typedef void is_avalanching;
   size_t operator()(const float& val)
   { 
     return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(float));
@@ -265,6 +435,7 @@ struct hash<float>
 template <>
 struct hash<double>
 {
+  typedef void is_avalanching;
   size_t operator()(const double& val)
   {
     return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(double));
@@ -274,6 +445,7 @@ struct hash<double>
 template <>
 struct hash<long double>
 {
+  typedef void is_avalanching;
   size_t operator()(const long double& val)
   {
     return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(long double));
@@ -12,25 +12,61 @@
 #include "vector.h"
 #include "util.h"
 #include "exceptdef.h"
+#include "node_handle.h"
 
 namespace mystl
 {
 
+// 是否在节点中缓存完整的哈希值
+// HASHTABLE_CACHE_HASH_CODE 为 1 时，每个节点多占一个 size_t，rehash、按迭代器删除与跨 bucket 的迭代
+// 不再重新计算哈希值，在链表中查找时也先比较哈希值，不等时不必调用 key_equal
+#ifndef HASHTABLE_CACHE_HASH_CODE
+#define HASHTABLE_CACHE_HASH_CODE 1
+#endif
+
+// 是否使用增量 rehash
+// HASHTABLE_INCREMENTAL_REHASH 为 1 时，单个元素的插入引起扩容时只分配新的 bucket 数组，旧数组保留下来，
+// 之后每次插入从旧数组迁移 HASHTABLE_REHASH_STEP 个 bucket，使一次插入的耗时有上界
+// 迁移期间，旧数组中尚未迁移的 bucket 排在新数组之后，查找时按哈希值决定在哪个数组中找
+// 查找与删除目前不做迁移；bucket 接口只反映新数组
+// 注意：迁移进行中时，插入会移动节点，使所有迭代器失效；使用者应把迁移期间的任何插入或删除
+// 都视为使迭代器失效，不要在遍历中修改容器
+#ifndef HASHTABLE_INCREMENTAL_REHASH
+#define HASHTABLE_INCREMENTAL_REHASH 0
+#endif
+
+#ifndef HASHTABLE_REHASH_STEP
+#define HASHTABLE_REHASH_STEP 8
+#endif
+
 // hashtable 的节点定义
 template <class T>
 struct hashtable_node
 {
-  hashtable_node* next;   // 指向下一个节点
-  T               value;  // 储存实值
+  hashtable_node* next;       // 指向下一个节点
+#if HASHTABLE_CACHE_HASH_CODE
+  size_t          hash_code;  // 缓存的哈希值
+#endif
+  T               value;      // 储存实值
 
   hashtable_node() = default;
   hashtable_node(const T& n) :next(nullptr), value(n) {}
 
+#if HASHTABLE_CACHE_HASH_CODE
+  hashtable_node(const hashtable_node& node)
+    :next(node.next), hash_code(node.hash_code), value(node.value) {}
+  hashtable_node(hashtable_node&& node)
+    :next(node.next), hash_code(node.hash_code), value(mystl::move(node.value))
+  {
+    node.next = nullptr;
+  }
+#else
   hashtable_node(const hashtable_node& node) :next(node.next), value(node.value) {}
   hashtable_node(hashtable_node&& node) :next(node.next), value(mystl::move(node.value))
   {
     node.next = nullptr;
   }
+#endif
 };
 
 // value traits
@@ -206,9 +242,9 @@ struct ht_iterator :public ht_iterator_base<T, Hash, KeyEqual>
     node = node->next;
     if (node == nullptr)
     { // 如果下一个位置为空，跳到下一个 bucket 的起始处
-      auto index = ht->hash(value_traits::get_key(old->value));
-      while (!node && ++index < ht->bucket_size_)
-        node = ht->buckets_[index];
+      auto index = ht->node_chain(old);
+      while (!node && ++index < ht->chain_count())
+        node = ht->chain(index);
     }
     return *this;
   }
@@ -284,10 +320,10 @@ struct ht_const_iterator :public ht_iterator_base<T, Hash, KeyEqual>
     node = node->next;
     if (node == nullptr)
     { // 如果下一个位置为空，跳到下一个 bucket 的起始处
-      auto index = ht->hash(value_traits::get_key(old->value));
-      while (!node && ++index < ht->bucket_size_)
+      auto index = ht->node_chain(old);
+      while (!node && ++index < ht->chain_count())
       {
-        node = ht->buckets_[index];
+        node = ht->chain(index);
       }
     }
     return *this;
@@ -467,6 +503,54 @@ inline size_t ht_next_prime(size_t n)
   return pos == last ? *(last - 1) : *pos;
 }
 
+// bucket 个数的选取策略
+// HASHTABLE_POWER_OF_TWO 为 1 时 bucket 个数取 2 的幂次，先用 hash_mix 打散哈希值再取低位，
+// 定位 bucket 只需要一次乘法与位运算，哈希函数声明了 is_avalanching 时连这次打散也省去；
+// 为 0 时使用上面的质数表，定位 bucket 需要一次取模
+#ifndef HASHTABLE_POWER_OF_TWO
+#define HASHTABLE_POWER_OF_TWO 1
+#endif
+
+#if HASHTABLE_POWER_OF_TWO
+
+// 可以使用的最大 bucket 个数
+static constexpr size_t ht_max_bucket_count = ~(static_cast<size_t>(-1) >> 1);
+
+// 找出大于等于 n 的最小的 2 的幂次，至少为 16
+inline size_t ht_next_size(size_t n)
+{
+  if (n >= ht_max_bucket_count)
+    return ht_max_bucket_count;
+  size_t result = 16;
+  while (result < n)
+    result <<= 1;
+  return result;
+}
+
+// 由哈希值得到在 n 个 bucket 中的位置
+template <class Hash>
+inline size_t ht_bucket_index(size_t h, size_t n) noexcept
+{
+  return (hash_is_avalanching<Hash>::value ? h : mystl::hash_mix(h)) & (n - 1);
+}
+
+#else
+
+static constexpr size_t ht_max_bucket_count = ht_prime_list[PRIME_NUM - 1];
+
+inline size_t ht_next_size(size_t n)
+{
+  return ht_next_prime(n);
+}
+
+template <class Hash>
+inline size_t ht_bucket_index(size_t h, size_t n) noexcept
+{
+  return h % n;
+}
+
+#endif
+
 // 模板类 hashtable
 // 参数一代表数据类型，参数二代表哈希函数，参数三代表键值相等的比较函数
 template <class T, class Hash, class KeyEqual>
@@ -505,6 +589,9 @@ public:
   typedef mystl::ht_local_iterator<T>                 local_iterator;
   typedef mystl::ht_const_local_iterator<T>           const_local_iterator;
 
+  typedef mystl::node_handle<node_type, value_traits, node_allocator> node_handle_type;
+  typedef mystl::node_insert_return<iterator, node_handle_type>       insert_return_type;
+
   allocator_type get_allocator() const { return allocator_type(); }
 
 private:
@@ -516,38 +603,147 @@ private:
   hasher      hash_;
   key_equal   equal_;
 
+#if HASHTABLE_INCREMENTAL_REHASH
+  // 增量 rehash 时的旧数组，old_buckets_[0, rehash_pos_) 已迁移完，old_size_ 为 0 表示没有进行中的 rehash
+  bucket_type old_buckets_;
+  size_type   old_size_ = 0;
+  size_type   rehash_pos_ = 0;
+#endif
+
 private:
-  bool is_equal(const key_type& key1, const key_type& key2)
+  template <class K1, class K2>
+  bool is_equal(const K1& key1, const K2& key2)
   {
     return equal_(key1, key2);
   }
 
-  bool is_equal(const key_type& key1, const key_type& key2) const
+  template <class K1, class K2>
+  bool is_equal(const K1& key1, const K2& key2) const
   {
     return equal_(key1, key2);
   }
 
+  // 节点的键值是否等于哈希值为 code 的 key，缓存了哈希值时先比较哈希值
+  template <class K>
+  bool node_equal(const node_type* p, size_t code, const K& key) const
+  {
+#if HASHTABLE_CACHE_HASH_CODE
+    return p->hash_code == code && is_equal(value_traits::get_key(p->value), key);
+#else
+    (void)code;
+    return is_equal(value_traits::get_key(p->value), key);
+#endif
+  }
+
+  // 节点的哈希值，缓存了哈希值时直接读出
+  size_t node_code(const node_type* p) const
+  {
+#if HASHTABLE_CACHE_HASH_CODE
+    return p->hash_code;
+#else
+    return hash_code(value_traits::get_key(p->value));
+#endif
+  }
+
+  void set_code(node_type* p, size_t code) const noexcept
+  {
+#if HASHTABLE_CACHE_HASH_CODE
+    p->hash_code = code;
+#else
+    (void)p;
+    (void)code;
+#endif
+  }
+
+  // 所有链表按新数组、旧数组中未迁移部分的顺序编号，迭代器按这个顺序遍历
+  // 没有进行中的增量 rehash 时，链表的编号就是 bucket 的编号
+  size_type chain_count() const noexcept
+  {
+#if HASHTABLE_INCREMENTAL_REHASH
+    return bucket_size_ + old_size_;
+#else
+    return bucket_size_;
+#endif
+  }
+
+  node_ptr& chain(size_type n) noexcept
+  {
+#if HASHTABLE_INCREMENTAL_REHASH
+    if (n >= bucket_size_)
+      return old_buckets_[n - bucket_size_];
+#endif
+    return buckets_[n];
+  }
+
+  node_ptr  chain(size_type n) const noexcept
+  {
+#if HASHTABLE_INCREMENTAL_REHASH
+    if (n >= bucket_size_)
+      return old_buckets_[n - bucket_size_];
+#endif
+    return buckets_[n];
+  }
+
+  // 哈希值为 code 的元素所在的链表编号
+  size_type key_chain(size_t code) const noexcept
+  {
+#if HASHTABLE_INCREMENTAL_REHASH
+    if (old_size_ != 0)
+    {
+      const auto i = bucket_index(code, old_size_);
+      if (i >= rehash_pos_)
+        return bucket_size_ + i;
+    }
+#endif
+    return bucket_index(code, bucket_size_);
+  }
+
+  size_type node_chain(const node_type* p) const
+  {
+    return key_chain(node_code(p));
+  }
+
+  // 是否有进行中的增量 rehash
+  bool      rehashing() const noexcept
+  {
+#if HASHTABLE_INCREMENTAL_REHASH
+    return old_size_ != 0;
+#else
+    return false;
+#endif
+  }
+
   const_iterator M_cit(node_ptr node) const noexcept
   {
     return const_iterator(node, const_cast<hashtable*>(this));
   }
 
+  pair<iterator, iterator> M_range(pair<node_ptr, node_ptr> p) noexcept
+  {
+    return mystl::make_pair(iterator(p.first, this), iterator(p.second, this));
+  }
+
+  pair<const_iterator, const_iterator> M_crange(pair<node_ptr, node_ptr> p) const noexcept
+  {
+    return mystl::make_pair(M_cit(p.first), M_cit(p.second));
+  }
+
   iterator M_begin() noexcept
   {
-    for (size_type n = 0; n < bucket_size_; ++n)
+    for (size_type n = 0; n < chain_count(); ++n)
     {
-      if (buckets_[n])  // 找到第一个有节点的位置就返回
-        return iterator(buckets_[n], this);
+      if (chain(n))  // 找到第一个有节点的位置就返回
+        return iterator(chain(n), this);
     }
     return iterator(nullptr, this);
   }
 
   const_iterator M_begin() const noexcept
   {
-    for (size_type n = 0; n < bucket_size_; ++n)
+    for (size_type n = 0; n < chain_count(); ++n)
     {
-      if (buckets_[n])  // 找到第一个有节点的位置就返回
-        return M_cit(buckets_[n]);
+      if (chain(n))  // 找到第一个有节点的位置就返回
+        return M_cit(chain(n));
     }
     return M_cit(nullptr);
   }
@@ -589,6 +785,13 @@ public:
     rhs.bucket_size_ = 0;
     rhs.size_ = 0;
     rhs.mlf_ = 0.0f;
+#if HASHTABLE_INCREMENTAL_REHASH
+    old_buckets_ = mystl::move(rhs.old_buckets_);
+    old_size_ = rhs.old_size_;
+    rehash_pos_ = rhs.rehash_pos_;
+    rhs.old_size_ = 0;
+    rhs.rehash_pos_ = 0;
+#endif
   }
 
   hashtable& operator=(const hashtable& rhs);
@@ -636,6 +839,13 @@ public:
   iterator emplace_unique_use_hint(const_iterator /*hint*/, Args&& ...args)
   { return emplace_unique(mystl::forward<Args>(args)...).first; }
 
+  // 以下两个函数只用于 unordered_map，先按 key 查找，键值已存在时不会创建节点
+  template <class K, class ...Args>
+  pair<iterator, bool> try_emplace_unique(K&& key, Args&& ...args);
+
+  template <class K, class M>
+  pair<iterator, bool> insert_or_assign_unique(K&& key, M&& obj);
+
   // insert
 
   iterator             insert_multi_noresize(const value_type& value);
@@ -687,59 +897,111 @@ public:
 
   void      clear();
 
-  void      swap(hashtable& rhs) noexcept;
+  // extract / insert node / merge
+  // 节点在容器之间转移时不会重新分配内存，也不会复制或移动元素
 
-  // 查找相关操作
+  node_handle_type   extract(const_iterator position);
+  node_handle_type   extract(const key_type& key);
 
-  size_type                            count(const key_type& key) const;
+  insert_return_type insert_unique(node_handle_type&& nh);
+  iterator           insert_multi(node_handle_type&& nh);
 
-  iterator                             find(const key_type& key);
-  const_iterator                       find(const key_type& key) const;
+  void               merge_unique(hashtable& rhs);
+  void               merge_multi(hashtable& rhs);
 
-  pair<iterator, iterator>             equal_range_multi(const key_type& key);
-  pair<const_iterator, const_iterator> equal_range_multi(const key_type& key) const;
+  void      swap(hashtable& rhs) noexcept;
 
-  pair<iterator, iterator>             equal_range_unique(const key_type& key);
-  pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const;
+  // 查找相关操作
+  // 若 Hash 与 KeyEqual 都定义了 is_transparent，查找函数还接受任何能与 key_type 比较的类型 K，
+  // 此时不会为了查找而构造 key_type 的临时对象
+
+  size_type                            count(const key_type& key) const
+  { return count_tr(key); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  size_type                            count(const K& key) const
+  { return count_tr(key); }
+
+  iterator                             find(const key_type& key)
+  { return iterator(find_node(key), this); }
+  const_iterator                       find(const key_type& key) const
+  { return M_cit(find_node(key)); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  iterator                             find(const K& key)
+  { return iterator(find_node(key), this); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  const_iterator                       find(const K& key) const
+  { return M_cit(find_node(key)); }
+
+  pair<iterator, iterator>             equal_range_multi(const key_type& key)
+  { return M_range(equal_range_multi_node(key)); }
+  pair<const_iterator, const_iterator> equal_range_multi(const key_type& key) const
+  { return M_crange(equal_range_multi_node(key)); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<iterator, iterator>             equal_range_multi(const K& key)
+  { return M_range(equal_range_multi_node(key)); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<const_iterator, const_iterator> equal_range_multi(const K& key) const
+  { return M_crange(equal_range_multi_node(key)); }
+
+  pair<iterator, iterator>             equal_range_unique(const key_type& key)
+  { return M_range(equal_range_unique_node(key)); }
+  pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const
+  { return M_crange(equal_range_unique_node(key)); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<iterator, iterator>             equal_range_unique(const K& key)
+  { return M_range(equal_range_unique_node(key)); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<const_iterator, const_iterator> equal_range_unique(const K& key) const
+  { return M_crange(equal_range_unique_node(key)); }
 
   // bucket interface
 
   local_iterator       begin(size_type n)        noexcept
   { 
-    MYSTL_DEBUG(n < size_);
+    MYSTL_DEBUG(n < bucket_size_);
     return buckets_[n];
   }
   const_local_iterator begin(size_type n)  const noexcept
   { 
-    MYSTL_DEBUG(n < size_);
+    MYSTL_DEBUG(n < bucket_size_);
     return buckets_[n];
   }
   const_local_iterator cbegin(size_type n) const noexcept
   { 
-    MYSTL_DEBUG(n < size_);
+    MYSTL_DEBUG(n < bucket_size_);
     return buckets_[n];
   }
 
   local_iterator       end(size_type n)          noexcept
   { 
-    MYSTL_DEBUG(n < size_);
+    MYSTL_DEBUG(n < bucket_size_);
     return nullptr; 
   }
   const_local_iterator end(size_type n)    const noexcept
   { 
-    MYSTL_DEBUG(n < size_);
+    MYSTL_DEBUG(n < bucket_size_);
     return nullptr; 
   }
   const_local_iterator cend(size_type n)   const noexcept
   {
-    MYSTL_DEBUG(n < size_);
+    MYSTL_DEBUG(n < bucket_size_);
     return nullptr; 
   }
 
   size_type bucket_count()                 const noexcept
   { return bucket_size_; }
   size_type max_bucket_count()             const noexcept
-  { return ht_prime_list[PRIME_NUM - 1]; }
+  { return ht_max_bucket_count; }
 
   size_type bucket_size(size_type n)       const noexcept;
   size_type bucket(const key_type& key)    const
@@ -780,8 +1042,11 @@ private:
 
   // hash
   size_type next_size(size_type n) const;
-  size_type hash(const key_type& key, size_type n) const;
-  size_type hash(const key_type& key) const;
+  template <class K>
+  size_t    hash_code(const K& key) const;
+  size_type bucket_index(size_t code, size_type n) const noexcept;
+  template <class K>
+  size_type hash(const K& key) const;
   void      rehash_if_need(size_type n);
 
   // insert
@@ -794,12 +1059,29 @@ private:
   template <class ForwardIter>
   void copy_insert_unique(ForwardIter first, ForwardIter last, mystl::forward_iterator_tag);
 
+  // lookup
+  template <class K>
+  node_ptr  find_node(const K& key) const;
+  template <class K>
+  size_type count_tr(const K& key) const;
+  template <class K>
+  pair<node_ptr, node_ptr> equal_range_multi_node(const K& key) const;
+  template <class K>
+  pair<node_ptr, node_ptr> equal_range_unique_node(const K& key) const;
+
   // insert node
+  iterator             link_new_node(node_ptr np, size_type n);
   pair<iterator, bool> insert_node_unique(node_ptr np);
   iterator             insert_node_multi(node_ptr np);
 
   // bucket operator
   void replace_bucket(size_type bucket_count);
+  void move_chain(node_ptr& head, bucket_type& bucket, size_type bucket_count);
+#if HASHTABLE_INCREMENTAL_REHASH
+  void rehash_start(size_type bucket_count);
+  void rehash_step(size_type n);
+#endif
+  void rehash_finish();
   void erase_bucket(size_type n, node_ptr first, node_ptr last);
   void erase_bucket(size_type n, node_ptr last);
 
@@ -846,8 +1128,7 @@ emplace_multi(Args&& ...args)
   auto np = create_node(mystl::forward<Args>(args)...);
   try
   {
-    if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
-      rehash(size_ + 1);
+    rehash_if_need(1);
   }
   catch (...)
   {
@@ -868,15 +1149,59 @@ emplace_unique(Args&& ...args)
   auto np = create_node(mystl::forward<Args>(args)...);
   try
   {
-    if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
-      rehash(size_ + 1);
+    rehash_if_need(1);
   }
   catch (...)
   {
     destroy_node(np);
     throw;
   }
-  return insert_node_unique(np);
+  auto res = insert_node_unique(np);
+  if (!res.second)
+    destroy_node(np);
+  return res;
+}
+
+// 键值为 key 的元素不存在时，以 key 和 mapped_type(args...) 构造新元素
+// 键值已存在时直接返回，args 不会被移动，也不会分配内存
+template <class T, class Hash, class KeyEqual>
+template <class K, class ...Args>
+pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
+hashtable<T, Hash, KeyEqual>::
+try_emplace_unique(K&& key, Args&& ...args)
+{
+  const auto code = hash_code(key);
+  auto n = key_chain(code);
+  for (auto cur = chain(n); cur; cur = cur->next)
+  {
+    if (node_equal(cur, code, key))
+      return mystl::make_pair(iterator(cur, this), false);
+  }
+  auto np = create_node(mystl::forward<K>(key), mapped_type(mystl::forward<Args>(args)...));
+  set_code(np, code);
+  return mystl::make_pair(link_new_node(np, n), true);
+}
+
+// 键值为 key 的元素存在时把 obj 赋给它的 mapped 值，否则以 key 和 obj 构造新元素
+template <class T, class Hash, class KeyEqual>
+template <class K, class M>
+pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
+hashtable<T, Hash, KeyEqual>::
+insert_or_assign_unique(K&& key, M&& obj)
+{
+  const auto code = hash_code(key);
+  auto n = key_chain(code);
+  for (auto cur = chain(n); cur; cur = cur->next)
+  {
+    if (node_equal(cur, code, key))
+    {
+      cur->value.second = mystl::forward<M>(obj);
+      return mystl::make_pair(iterator(cur, this), false);
+    }
+  }
+  auto np = create_node(mystl::forward<K>(key), mystl::forward<M>(obj));
+  set_code(np, code);
+  return mystl::make_pair(link_new_node(np, n), true);
 }
 
 // 在不需要重建表格的情况下插入新节点，键值不允许重复
@@ -885,17 +1210,18 @@ pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
 hashtable<T, Hash, KeyEqual>::
 insert_unique_noresize(const value_type& value)
 {
-  const auto n = hash(value_traits::get_key(value));
-  auto first = buckets_[n];
+  const auto code = hash_code(value_traits::get_key(value));
+  auto& first = chain(key_chain(code));
   for (auto cur = first; cur; cur = cur->next)
   {
-    if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(value)))
+    if (node_equal(cur, code, value_traits::get_key(value)))
       return mystl::make_pair(iterator(cur, this), false);
   }
   // 让新节点成为链表的第一个节点
   auto tmp = create_node(value);  
+  set_code(tmp, code);
   tmp->next = first;
-  buckets_[n] = tmp;
+  first = tmp;
   ++size_;
   return mystl::make_pair(iterator(tmp, this), true);
 }
@@ -906,12 +1232,13 @@ typename hashtable<T, Hash, KeyEqual>::iterator
 hashtable<T, Hash, KeyEqual>::
 insert_multi_noresize(const value_type& value)
 {
-  const auto n = hash(value_traits::get_key(value));
-  auto first = buckets_[n];
+  const auto code = hash_code(value_traits::get_key(value));
+  auto& first = chain(key_chain(code));
   auto tmp = create_node(value);
+  set_code(tmp, code);
   for (auto cur = first; cur; cur = cur->next)
   {
-    if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(value)))
+    if (node_equal(cur, code, value_traits::get_key(value)))
     { // 如果链表中存在相同键值的节点就马上插入，然后返回
       tmp->next = cur->next;
       cur->next = tmp;
@@ -921,7 +1248,7 @@ insert_multi_noresize(const value_type& value)
   }
   // 否则插入在链表头部
   tmp->next = first;
-  buckets_[n] = tmp;
+  first = tmp;
   ++size_;
   return iterator(tmp, this);
 }
@@ -934,11 +1261,11 @@ erase(const_iterator position)
   auto p = position.node;
   if (p)
   {
-    const auto n = hash(value_traits::get_key(p->value));
-    auto cur = buckets_[n];
+    auto& head = chain(node_chain(p));
+    auto cur = head;
     if (cur == p)
     { // p 位于链表头部
-      buckets_[n] = cur->next;
+      head = cur->next;
       destroy_node(cur);
       --size_;
     }
@@ -964,6 +1291,123 @@ erase(const_iterator position)
   }
 }
 
+// 把 position 所指的节点从链表中摘下，交给节点句柄
+template <class T, class Hash, class KeyEqual>
+typename hashtable<T, Hash, KeyEqual>::node_handle_type
+hashtable<T, Hash, KeyEqual>::
+extract(const_iterator position)
+{
+  auto p = position.node;
+  if (p == nullptr)
+    return node_handle_type();
+  auto& head = chain(node_chain(p));
+  if (head == p)
+  { // p 位于链表头部
+    head = p->next;
+  }
+  else
+  {
+    auto cur = head;
+    while (cur->next != p)
+      cur = cur->next;
+    cur->next = p->next;
+  }
+  p->next = nullptr;
+  --size_;
+  return node_handle_type(p);
+}
+
+// 摘下一个键值等于 key 的节点，没有这样的节点时返回空句柄
+template <class T, class Hash, class KeyEqual>
+typename hashtable<T, Hash, KeyEqual>::node_handle_type
+hashtable<T, Hash, KeyEqual>::
+extract(const key_type& key)
+{
+  return extract(M_cit(find(key).node));
+}
+
+// 插入节点句柄持有的节点，键值不允许重复
+// 插入失败时节点仍留在返回值的 node 中
+template <class T, class Hash, class KeyEqual>
+typename hashtable<T, Hash, KeyEqual>::insert_return_type
+hashtable<T, Hash, KeyEqual>::
+insert_unique(node_handle_type&& nh)
+{
+  if (nh.empty())
+    return insert_return_type{ end(), false, node_handle_type() };
+  rehash_if_need(1);
+  auto res = insert_node_unique(nh.node_);
+  if (res.second)
+    nh.release();
+  return insert_return_type{ res.first, res.second, mystl::move(nh) };
+}
+
+// 插入节点句柄持有的节点，键值允许重复
+template <class T, class Hash, class KeyEqual>
+typename hashtable<T, Hash, KeyEqual>::iterator
+hashtable<T, Hash, KeyEqual>::
+insert_multi(node_handle_type&& nh)
+{
+  if (nh.empty())
+    return end();
+  rehash_if_need(1);
+  return insert_node_multi(nh.release());
+}
+
+// 把 rhs 中的节点移到 *this 中，键值不允许重复，与 *this 中键值相同的节点留在 rhs 中
+template <class T, class Hash, class KeyEqual>
+void hashtable<T, Hash, KeyEqual>::
+merge_unique(hashtable& rhs)
+{
+  if (this == &rhs || rhs.size_ == 0)
+    return;
+  rehash_if_need(rhs.size_);
+  for (size_type i = 0; i < rhs.chain_count(); ++i)
+  {
+    // link 指向 rhs 中当前节点的前驱所保存的指针
+    node_ptr* link = &rhs.chain(i);
+    while (*link)
+    {
+      auto p = *link;
+      auto next = p->next;
+      p->next = nullptr;
+      if (insert_node_unique(p).second)
+      {
+        *link = next;
+        --rhs.size_;
+      }
+      else
+      {
+        p->next = next;
+        link = &p->next;
+      }
+    }
+  }
+}
+
+// 把 rhs 中的节点全部移到 *this 中，键值允许重复
+template <class T, class Hash, class KeyEqual>
+void hashtable<T, Hash, KeyEqual>::
+merge_multi(hashtable& rhs)
+{
+  if (this == &rhs || rhs.size_ == 0)
+    return;
+  rehash_if_need(rhs.size_);
+  for (size_type i = 0; i < rhs.chain_count(); ++i)
+  {
+    auto p = rhs.chain(i);
+    rhs.chain(i) = nullptr;
+    while (p)
+    {
+      auto next = p->next;
+      p->next = nullptr;
+      insert_node_multi(p);
+      p = next;
+    }
+  }
+  rhs.size_ = 0;
+}
+
 // 删除[first, last)内的节点
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
@@ -971,12 +1415,9 @@ erase(const_iterator first, const_iterator last)
 {
   if (first.node == last.node)
     return;
-  auto first_bucket = first.node 
-    ? hash(value_traits::get_key(first.node->value)) 
-    : bucket_size_;
-  auto last_bucket = last.node 
-    ? hash(value_traits::get_key(last.node->value))
-    : bucket_size_;
+  const auto end_chain = chain_count();
+  auto first_bucket = first.node ? node_chain(first.node) : end_chain;
+  auto last_bucket = last.node ? node_chain(last.node) : end_chain;
   if (first_bucket == last_bucket)
   { // 如果在 bucket 在同一个位置
     erase_bucket(first_bucket, first.node, last.node);
@@ -986,10 +1427,10 @@ erase(const_iterator first, const_iterator last)
     erase_bucket(first_bucket, first.node, nullptr);
     for (auto n = first_bucket + 1; n < last_bucket; ++n)
     {
-      if(buckets_[n] != nullptr)
+      if(chain(n) != nullptr)
         erase_bucket(n, nullptr);
     }
-    if (last_bucket != bucket_size_)
+    if (last_bucket != end_chain)
     {
       erase_bucket(last_bucket, last.node);
     }
@@ -1005,8 +1446,9 @@ erase_multi(const key_type& key)
   auto p = equal_range_multi(key);
   if (p.first.node != nullptr)
   {
+    const size_type n = mystl::distance(p.first, p.second);
     erase(p.first, p.second);
-    return mystl::distance(p.first, p.second);
+    return n;
   }
   return 0;
 }
@@ -1016,13 +1458,14 @@ typename hashtable<T, Hash, KeyEqual>::size_type
 hashtable<T, Hash, KeyEqual>::
 erase_unique(const key_type& key)
 {
-  const auto n = hash(key);
-  auto first = buckets_[n];
+  const auto code = hash_code(key);
+  auto& head = chain(key_chain(code));
+  auto first = head;
   if (first)
   {
-    if (is_equal(value_traits::get_key(first->value), key))
+    if (node_equal(first, code, key))
     {
-      buckets_[n] = first->next;
+      head = first->next;
       destroy_node(first);
       --size_;
       return 1;
@@ -1032,7 +1475,7 @@ erase_unique(const key_type& key)
       auto next = first->next;
       while (next)
       {
-        if (is_equal(value_traits::get_key(next->value), key))
+        if (node_equal(next, code, key))
         {
           first->next = next->next;
           destroy_node(next);
@@ -1054,19 +1497,25 @@ clear()
 {
   if (size_ != 0)
   {
-    for (size_type i = 0; i < bucket_size_; ++i)
+    for (size_type i = 0; i < chain_count(); ++i)
     {
-      node_ptr cur = buckets_[i];
+      node_ptr cur = chain(i);
       while (cur != nullptr)
       {
         node_ptr next = cur->next;
         destroy_node(cur);
         cur = next;
       }
-      buckets_[i] = nullptr;
+      chain(i) = nullptr;
     }
     size_ = 0;
   }
+#if HASHTABLE_INCREMENTAL_REHASH
+  // 旧数组已经没有节点，直接结束进行中的 rehash
+  bucket_type().swap(old_buckets_);
+  old_size_ = 0;
+  rehash_pos_ = 0;
+#endif
 }
 
 // 在某个 bucket 节点的个数
@@ -1088,7 +1537,8 @@ template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
 rehash(size_type count)
 {
-  auto n = ht_next_prime(count);
+  rehash_finish();
+  auto n = next_size(count);
   if (n > bucket_size_)
   {
     replace_bucket(n);
@@ -1103,146 +1553,90 @@ rehash(size_type count)
   }
 }
 
-// 查找键值为 key 的节点，返回其迭代器
+// 查找键值为 key 的节点，没有这样的节点时返回 nullptr
 template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::
-find(const key_type& key)
-{
-  const auto n = hash(key);
-  node_ptr first = buckets_[n];
-  for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {}
-  return iterator(first, this);
-}
-
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::const_iterator
+template <class K>
+typename hashtable<T, Hash, KeyEqual>::node_ptr
 hashtable<T, Hash, KeyEqual>::
-find(const key_type& key) const
+find_node(const K& key) const
 {
-  const auto n = hash(key);
-  node_ptr first = buckets_[n];
-  for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {}
-  return M_cit(first);
+  const auto code = hash_code(key);
+  node_ptr first = chain(key_chain(code));
+  for (; first && !node_equal(first, code, key); first = first->next) {}
+  return first;
 }
 
 // 查找键值为 key 出现的次数
 template <class T, class Hash, class KeyEqual>
+template <class K>
 typename hashtable<T, Hash, KeyEqual>::size_type
 hashtable<T, Hash, KeyEqual>::
-count(const key_type& key) const
+count_tr(const K& key) const
 {
-  const auto n = hash(key);
+  const auto code = hash_code(key);
   size_type result = 0;
-  for (node_ptr cur = buckets_[n]; cur; cur = cur->next)
+  for (node_ptr cur = chain(key_chain(code)); cur; cur = cur->next)
   {
-    if (is_equal(value_traits::get_key(cur->value), key))
+    if (node_equal(cur, code, key))
       ++result;
   }
   return result;
 }
 
-// 查找与键值 key 相等的区间，返回一个 pair，指向相等区间的首尾
+// 查找与键值 key 相等的区间，返回一对节点指针，指向相等区间的首尾，nullptr 表示 end
 template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-  typename hashtable<T, Hash, KeyEqual>::iterator>
+template <class K>
+pair<typename hashtable<T, Hash, KeyEqual>::node_ptr,
+  typename hashtable<T, Hash, KeyEqual>::node_ptr>
 hashtable<T, Hash, KeyEqual>::
-equal_range_multi(const key_type& key)
+equal_range_multi_node(const K& key) const
 {
-  const auto n = hash(key);
-  for (node_ptr first = buckets_[n]; first; first = first->next)
+  const auto code = hash_code(key);
+  const auto n = key_chain(code);
+  for (node_ptr first = chain(n); first; first = first->next)
   {
-    if (is_equal(value_traits::get_key(first->value), key))
+    if (node_equal(first, code, key))
     { // 如果出现相等的键值
       for (node_ptr second = first->next; second; second = second->next)
       {
-        if (!is_equal(value_traits::get_key(second->value), key))
-          return mystl::make_pair(iterator(first, this), iterator(second, this));
-      }
-      for (auto m = n + 1; m < bucket_size_; ++m)
-      { // 整个链表都相等，查找下一个链表出现的位置
-        if (buckets_[m])
-          return mystl::make_pair(iterator(first, this), iterator(buckets_[m], this));
-      }
-      return mystl::make_pair(iterator(first, this), end());
-    }
-  }
-  return mystl::make_pair(end(), end());
-}
-
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-  typename hashtable<T, Hash, KeyEqual>::const_iterator>
-hashtable<T, Hash, KeyEqual>::
-equal_range_multi(const key_type& key) const
-{
-  const auto n = hash(key);
-  for (node_ptr first = buckets_[n]; first; first = first->next)
-  {
-    if (is_equal(value_traits::get_key(first->value), key))
-    {
-      for (node_ptr second = first->next; second; second = second->next)
-      {
-        if (!is_equal(value_traits::get_key(second->value), key))
-          return mystl::make_pair(M_cit(first), M_cit(second));
+        if (!node_equal(second, code, key))
+          return mystl::make_pair(first, second);
       }
-      for (auto m = n + 1; m < bucket_size_; ++m)
-      { // 整个链表都相等，查找下一个链表出现的位置
-        if (buckets_[m])
-          return mystl::make_pair(M_cit(first), M_cit(buckets_[m]));
-      }
-      return mystl::make_pair(M_cit(first), cend());
-    }
-  }
-  return mystl::make_pair(cend(), cend());
-}
-
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-  typename hashtable<T, Hash, KeyEqual>::iterator>
-hashtable<T, Hash, KeyEqual>::
-equal_range_unique(const key_type& key)
-{
-  const auto n = hash(key);
-  for (node_ptr first = buckets_[n]; first; first = first->next)
-  {
-    if (is_equal(value_traits::get_key(first->value), key))
-    {
-      if (first->next)
-        return mystl::make_pair(iterator(first, this), iterator(first->next, this));
-      for (auto m = n + 1; m < bucket_size_; ++m)
+      for (auto m = n + 1; m < chain_count(); ++m)
       { // 整个链表都相等，查找下一个链表出现的位置
-        if (buckets_[m])
-          return mystl::make_pair(iterator(first, this), iterator(buckets_[m], this));
+        if (chain(m))
+          return mystl::make_pair(first, chain(m));
       }
-      return mystl::make_pair(iterator(first, this), end());
+      return mystl::make_pair(first, node_ptr(nullptr));
     }
   }
-  return mystl::make_pair(end(), end());
+  return mystl::make_pair(node_ptr(nullptr), node_ptr(nullptr));
 }
 
 template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-  typename hashtable<T, Hash, KeyEqual>::const_iterator>
+template <class K>
+pair<typename hashtable<T, Hash, KeyEqual>::node_ptr,
+  typename hashtable<T, Hash, KeyEqual>::node_ptr>
 hashtable<T, Hash, KeyEqual>::
-equal_range_unique(const key_type& key) const
+equal_range_unique_node(const K& key) const
 {
-  const auto n = hash(key);
-  for (node_ptr first = buckets_[n]; first; first = first->next)
+  const auto code = hash_code(key);
+  const auto n = key_chain(code);
+  for (node_ptr first = chain(n); first; first = first->next)
   {
-    if (is_equal(value_traits::get_key(first->value), key))
+    if (node_equal(first, code, key))
     {
       if (first->next)
-        return mystl::make_pair(M_cit(first), M_cit(first->next));
-      for (auto m = n + 1; m < bucket_size_; ++m)
+        return mystl::make_pair(first, first->next);
+      for (auto m = n + 1; m < chain_count(); ++m)
       { // 整个链表都相等，查找下一个链表出现的位置
-        if (buckets_[m])
-          return mystl::make_pair(M_cit(first), M_cit(buckets_[m]));
+        if (chain(m))
+          return mystl::make_pair(first, chain(m));
       }
-      return mystl::make_pair(M_cit(first), cend());
+      return mystl::make_pair(first, node_ptr(nullptr));
     }
   }
-  return mystl::make_pair(cend(), cend());
+  return mystl::make_pair(node_ptr(nullptr), node_ptr(nullptr));
 }
 
 // 交换 hashtable
@@ -1258,6 +1652,11 @@ swap(hashtable& rhs) noexcept
     mystl::swap(mlf_, rhs.mlf_);
     mystl::swap(hash_, rhs.hash_);
     mystl::swap(equal_, rhs.equal_);
+#if HASHTABLE_INCREMENTAL_REHASH
+    old_buckets_.swap(rhs.old_buckets_);
+    mystl::swap(old_size_, rhs.old_size_);
+    mystl::swap(rehash_pos_, rhs.rehash_pos_);
+#endif
   }
 }
 
@@ -1292,30 +1691,41 @@ copy_init(const hashtable& ht)
   bucket_size_ = 0;
   buckets_.reserve(ht.bucket_size_);
   buckets_.assign(ht.bucket_size_, nullptr);
+  bucket_size_ = ht.bucket_size_;
+#if HASHTABLE_INCREMENTAL_REHASH
+  // 进行中的增量 rehash 原样复制，两个数组的链表一一对应
+  old_buckets_.assign(ht.old_size_, nullptr);
+  old_size_ = ht.old_size_;
+  rehash_pos_ = ht.rehash_pos_;
+#endif
   try
   {
-    for (size_type i = 0; i < ht.bucket_size_; ++i)
+    for (size_type i = 0; i < ht.chain_count(); ++i)
     {
-      node_ptr cur = ht.buckets_[i];
+      node_ptr cur = ht.chain(i);
       if (cur)
       { // 如果某 bucket 存在链表
         auto copy = create_node(cur->value);
-        buckets_[i] = copy;
+        set_code(copy, ht.node_code(cur));
+        chain(i) = copy;
         for (auto next = cur->next; next; cur = next, next = cur->next)
         {  //复制链表
           copy->next = create_node(next->value);
           copy = copy->next;
+          set_code(copy, ht.node_code(next));
         }
         copy->next = nullptr;
       }
     }
-    bucket_size_ = ht.bucket_size_;
     mlf_ = ht.mlf_;
     size_ = ht.size_;
   }
   catch (...)
   {
+    // 已复制的节点都挂在链表上，clear 只看 size_ 是否为 0
+    size_ = ht.size_;
     clear();
+    throw;
   }
 }
 
@@ -1355,24 +1765,35 @@ template <class T, class Hash, class KeyEqual>
 typename hashtable<T, Hash, KeyEqual>::size_type
 hashtable<T, Hash, KeyEqual>::next_size(size_type n) const
 {
-  return ht_next_prime(n);
+  return ht_next_size(n);
 }
 
-// hash 函数
+// hash_code 函数，求出 key 的完整哈希值
+template <class T, class Hash, class KeyEqual>
+template <class K>
+size_t hashtable<T, Hash, KeyEqual>::
+hash_code(const K& key) const
+{
+  return static_cast<size_t>(hash_(key));
+}
+
+// bucket_index 函数，由哈希值得到在 n 个 bucket 中的位置
 template <class T, class Hash, class KeyEqual>
 typename hashtable<T, Hash, KeyEqual>::size_type
 hashtable<T, Hash, KeyEqual>::
-hash(const key_type& key, size_type n) const
+bucket_index(size_t code, size_type n) const noexcept
 {
-  return hash_(key) % n;
+  return ht_bucket_index<Hash>(code, n);
 }
 
+// hash 函数
 template <class T, class Hash, class KeyEqual>
+template <class K>
 typename hashtable<T, Hash, KeyEqual>::size_type
 hashtable<T, Hash, KeyEqual>::
-hash(const key_type& key) const
+hash(const K& key) const
 {
-  return hash_(key) % bucket_size_;
+  return bucket_index(hash_code(key), bucket_size_);
 }
 
 // rehash_if_need 函数
@@ -1380,8 +1801,30 @@ template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
 rehash_if_need(size_type n)
 {
+#if HASHTABLE_INCREMENTAL_REHASH
+  if (old_size_ != 0)
+    rehash_step(HASHTABLE_REHASH_STEP);
+#endif
   if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor())
-    rehash(size_ + n);
+  {
+    // 与 reserve 一样按 ceil((size_ + n) / max_load_factor()) 确定 bucket 数，
+    // 否则 max_load_factor() < 1 时 next_size(size_ + n) 可能等于当前的 bucket 数，表不会增长
+    const float need = static_cast<float>(size_ + n) / max_load_factor();
+    auto count = static_cast<size_type>(need);
+    if (static_cast<float>(count) < need)
+      ++count;
+#if HASHTABLE_INCREMENTAL_REHASH
+    // 只有单个元素的插入做增量 rehash，批量插入一次完成
+    if (n == 1 && old_size_ == 0 && size_ != 0)
+    {
+      const auto bucket_nums = next_size(count);
+      if (bucket_nums > bucket_size_)
+        rehash_start(bucket_nums);
+      return;
+    }
+#endif
+    rehash(count);
+  }
 }
 
 // copy_insert
@@ -1433,17 +1876,19 @@ typename hashtable<T, Hash, KeyEqual>::iterator
 hashtable<T, Hash, KeyEqual>::
 insert_node_multi(node_ptr np)
 {
-  const auto n = hash(value_traits::get_key(np->value));
-  auto cur = buckets_[n];
+  const auto code = hash_code(value_traits::get_key(np->value));
+  set_code(np, code);
+  auto& head = chain(key_chain(code));
+  auto cur = head;
   if (cur == nullptr)
   {
-    buckets_[n] = np;
+    head = np;
     ++size_;
     return iterator(np, this);
   }
   for (; cur; cur = cur->next)
   {
-    if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value)))
+    if (node_equal(cur, code, value_traits::get_key(np->value)))
     {
       np->next = cur->next;
       cur->next = np;
@@ -1451,35 +1896,66 @@ insert_node_multi(node_ptr np)
       return iterator(np, this);
     }
   }
-  np->next = buckets_[n];
-  buckets_[n] = np;
+  np->next = head;
+  head = np;
+  ++size_;
+  return iterator(np, this);
+}
+
+// link_new_node 函数
+// np 为已确认不重复的新节点，n 为插入前计算出的链表位置，需要扩容或迁移节点时重新计算位置
+// 强异常安全保证
+template <class T, class Hash, class KeyEqual>
+typename hashtable<T, Hash, KeyEqual>::iterator
+hashtable<T, Hash, KeyEqual>::
+link_new_node(node_ptr np, size_type n)
+{
+  if (rehashing() || (float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
+  {
+    try
+    {
+      rehash_if_need(1);
+      n = node_chain(np);
+    }
+    catch (...)
+    {
+      destroy_node(np);
+      throw;
+    }
+  }
+  auto& head = chain(n);
+  np->next = head;
+  head = np;
   ++size_;
   return iterator(np, this);
 }
 
 // insert_node_unique 函数
+// 插入失败时不会销毁 np，由调用者处理
 template <class T, class Hash, class KeyEqual>
 pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
 hashtable<T, Hash, KeyEqual>::
 insert_node_unique(node_ptr np)
 {
-  const auto n = hash(value_traits::get_key(np->value));
-  auto cur = buckets_[n];
+  const auto code = hash_code(value_traits::get_key(np->value));
+  set_code(np, code);
+  auto& head = chain(key_chain(code));
+  auto cur = head;
   if (cur == nullptr)
   {
-    buckets_[n] = np;
+    head = np;
     ++size_;
     return mystl::make_pair(iterator(np, this), true);
   }
   for (; cur; cur = cur->next)
   {
-    if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value)))
+    if (node_equal(cur, code, value_traits::get_key(np->value)))
     {
       return mystl::make_pair(iterator(cur, this), false);
     }
   }
-  np->next = buckets_[n];
-  buckets_[n] = np;
+  np->next = head;
+  head = np;
   ++size_;
   return mystl::make_pair(iterator(np, this), true);
 }
@@ -1493,42 +1969,100 @@ replace_bucket(size_type bucket_count)
   if (size_ != 0)
   {
     for (size_type i = 0; i < bucket_size_; ++i)
+      move_chain(buckets_[i], bucket, bucket_count);
+  }
+  buckets_.swap(bucket);
+  bucket_size_ = buckets_.size();
+}
+
+// move_chain 函数
+// 把链表 head 上的节点逐个摘下并接到 bucket 中，不复制元素，键值相同的节点仍然相邻
+template <class T, class Hash, class KeyEqual>
+void hashtable<T, Hash, KeyEqual>::
+move_chain(node_ptr& head, bucket_type& bucket, size_type bucket_count)
+{
+  auto first = head;
+  while (first)
+  {
+    auto next = first->next;
+    const auto code = node_code(first);
+    const auto n = bucket_index(code, bucket_count);
+    auto f = bucket[n];
+    bool is_inserted = false;
+    for (auto cur = f; cur; cur = cur->next)
     {
-      for (auto first = buckets_[i]; first; first = first->next)
+      if (node_equal(cur, code, value_traits::get_key(first->value)))
       {
-        auto tmp = create_node(first->value);
-        const auto n = hash(value_traits::get_key(first->value), bucket_count);
-        auto f = bucket[n];
-        bool is_inserted = false;
-        for (auto cur = f; cur; cur = cur->next)
-        {
-          if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(first->value)))
-          {
-            tmp->next = cur->next;
-            cur->next = tmp;
-            is_inserted = true;
-            break;
-          }
-        }
-        if (!is_inserted)
-        {
-          tmp->next = f;
-          bucket[n] = tmp;
-        }
+        first->next = cur->next;
+        cur->next = first;
+        is_inserted = true;
+        break;
       }
     }
+    if (!is_inserted)
+    {
+      first->next = f;
+      bucket[n] = first;
+    }
+    first = next;
   }
+  head = nullptr;
+}
+
+#if HASHTABLE_INCREMENTAL_REHASH
+
+// rehash_start 函数
+// 分配 bucket_count 个 bucket 作为新数组，原数组改为旧数组，节点留待之后迁移
+template <class T, class Hash, class KeyEqual>
+void hashtable<T, Hash, KeyEqual>::
+rehash_start(size_type bucket_count)
+{
+  MYSTL_DEBUG(old_size_ == 0);
+  bucket_type bucket(bucket_count);
+  old_buckets_.swap(buckets_);
   buckets_.swap(bucket);
+  old_size_ = bucket_size_;
   bucket_size_ = buckets_.size();
+  rehash_pos_ = 0;
+}
+
+// rehash_step 函数
+// 从旧数组迁移至多 n 个 bucket 到新数组，全部迁移完后释放旧数组
+template <class T, class Hash, class KeyEqual>
+void hashtable<T, Hash, KeyEqual>::
+rehash_step(size_type n)
+{
+  for (; n > 0 && rehash_pos_ < old_size_; --n, ++rehash_pos_)
+    move_chain(old_buckets_[rehash_pos_], buckets_, bucket_size_);
+  if (rehash_pos_ == old_size_)
+  {
+    bucket_type().swap(old_buckets_);
+    old_size_ = 0;
+    rehash_pos_ = 0;
+  }
+}
+
+#endif
+
+// rehash_finish 函数
+// 完成进行中的增量 rehash
+template <class T, class Hash, class KeyEqual>
+void hashtable<T, Hash, KeyEqual>::
+rehash_finish()
+{
+#if HASHTABLE_INCREMENTAL_REHASH
+  if (old_size_ != 0)
+    rehash_step(old_size_);
+#endif
 }
 
 // erase_bucket 函数
-// 在第 n 个 bucket 内，删除 [first, last) 的节点
+// 在第 n 个链表内，删除 [first, last) 的节点
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
 erase_bucket(size_type n, node_ptr first, node_ptr last)
 {
-  auto cur = buckets_[n];
+  auto cur = chain(n);
   if (cur == first)
   {
     erase_bucket(n, last);
@@ -1548,12 +2082,13 @@ erase_bucket(size_type n, node_ptr first, node_ptr last)
 }
 
 // erase_bucket 函数
-// 在第 n 个 bucket 内，删除 [buckets_[n], last) 的节点
+// 在第 n 个链表内，删除 [chain(n), last) 的节点
 template <class T, class Hash, class KeyEqual>
 void hashtable<T, Hash, KeyEqual>::
 erase_bucket(size_type n, node_ptr last)
 {
-  auto cur = buckets_[n];
+  auto& head = chain(n);
+  auto cur = head;
   while (cur != last)
   {
     auto next = cur->next;
@@ -1561,7 +2096,7 @@ erase_bucket(size_type n, node_ptr last)
     cur = next;
     --size_;
   }
-  buckets_[n] = last;
+  head = last;
 }
 
 // equal_to 函数
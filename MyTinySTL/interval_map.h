@@ -0,0 +1,778 @@
+#ifndef MYTINYSTL_INTERVAL_MAP_H_
+#define MYTINYSTL_INTERVAL_MAP_H_
+
+// 这个头文件包含两个模板类 interval 和 interval_map
+// interval     : 闭区间 [low, high]
+// interval_map : 区间映射，以区间为键值的红黑树，键值允许重复，可以查找与某点或某区间相交的所有区间
+
+// notes:
+//
+// interval_map 直接使用 rb_tree.h 中的节点基类以及插入、删除、旋转的平衡函数，
+// 区间按 (low, high) 排序，每个节点额外记录子树中所有区间右端点的最大值，
+// 这一信息通过特化 rb_tree_augment，在插入路径、删除路径与每次旋转时维护，不改变原有的复杂度
+//
+// 查询时跳过最大右端点小于查询起点的子树，以及左端点大于查询终点的节点的右侧部分：
+//   * stab(point, result)         输出所有包含 point 的区间
+//   * overlap(interval, result)   输出所有与 interval 相交的区间
+// 两者按区间的顺序输出，复杂度为 O(min(n, (k + 1) log n))，k 为结果个数，通常接近 O(log n + k)
+//   * find_overlap(interval)      返回任意一个相交的区间，复杂度为 O(log n)
+//
+// 子树最大值在 rb_tree_augment 的静态函数中维护，因此要求 Compare 是无状态的
+
+#include <initializer_list>
+
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "exceptdef.h"
+#include "rb_tree.h"
+
+namespace mystl
+{
+
+// 模板类 interval
+// 闭区间 [low, high]，要求 high 不小于 low
+template <class Key>
+struct interval
+{
+  typedef Key point_type;
+
+  Key low;
+  Key high;
+
+  interval() :low(), high() {}
+  interval(const Key& l, const Key& h) :low(l), high(h) {}
+};
+
+template <class Key>
+bool operator==(const interval<Key>& lhs, const interval<Key>& rhs)
+{
+  return lhs.low == rhs.low && lhs.high == rhs.high;
+}
+
+template <class Key>
+bool operator!=(const interval<Key>& lhs, const interval<Key>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+// interval_map 节点基类的标记类型，使它与其它 rb tree 的节点基类成为不同的类型
+template <class Key, class T, class Compare>
+struct interval_map_node_tag {};
+
+// interval_map 的节点
+template <class Key, class T, class Compare>
+struct interval_map_node :public rb_tree_node_base<interval_map_node_tag<Key, T, Compare>>
+{
+  mystl::pair<const interval<Key>, T> value;     // 节点值
+  const Key*                          max_high;  // 指向子树中最大的右端点
+};
+
+// 为 interval_map 的节点维护子树中最大的右端点
+template <class Key, class T, class Compare>
+struct rb_tree_augment<rb_tree_node_base<interval_map_node_tag<Key, T, Compare>>*>
+{
+  typedef rb_tree_node_base<interval_map_node_tag<Key, T, Compare>>* base_ptr;
+  typedef interval_map_node<Key, T, Compare>*                        node_ptr;
+
+  static void update(base_ptr x) noexcept
+  {
+    auto p = static_cast<node_ptr>(x);
+    const Key* m = &p->value.first.high;
+    if (x->left != nullptr && Compare()(*m, *static_cast<node_ptr>(x->left)->max_high))
+      m = static_cast<node_ptr>(x->left)->max_high;
+    if (x->right != nullptr && Compare()(*m, *static_cast<node_ptr>(x->right)->max_high))
+      m = static_cast<node_ptr>(x->right)->max_high;
+    p->max_high = m;
+  }
+
+  static void propagate(base_ptr x, base_ptr end) noexcept
+  {
+    for (; x != end; x = x->parent())
+      update(x);
+  }
+};
+
+// interval_map 的迭代器，前进与后退沿用 rb_tree_iterator_base
+template <class Key, class T, class Compare>
+struct interval_map_const_iterator;
+
+template <class Key, class T, class Compare>
+struct interval_map_iterator
+  :public rb_tree_iterator_base<interval_map_node_tag<Key, T, Compare>>
+{
+  typedef rb_tree_iterator_base<interval_map_node_tag<Key, T, Compare>> base_iter;
+
+  typedef mystl::pair<const interval<Key>, T>     value_type;
+  typedef value_type*                             pointer;
+  typedef value_type&                             reference;
+  typedef typename base_iter::base_ptr            base_ptr;
+  typedef interval_map_node<Key, T, Compare>*     node_ptr;
+  typedef interval_map_iterator                   self;
+
+  using base_iter::node;
+
+  // 构造函数
+  interval_map_iterator() {}
+  interval_map_iterator(base_ptr x) { node = x; }
+
+  // 重载操作符
+  reference operator*()  const { return static_cast<node_ptr>(node)->value; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    this->inc();
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp(*this);
+    this->inc();
+    return tmp;
+  }
+  self& operator--()
+  {
+    this->dec();
+    return *this;
+  }
+  self operator--(int)
+  {
+    self tmp(*this);
+    this->dec();
+    return tmp;
+  }
+
+  bool operator==(const self& rhs) const { return node == rhs.node; }
+  bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+template <class Key, class T, class Compare>
+struct interval_map_const_iterator
+  :public rb_tree_iterator_base<interval_map_node_tag<Key, T, Compare>>
+{
+  typedef rb_tree_iterator_base<interval_map_node_tag<Key, T, Compare>> base_iter;
+
+  typedef mystl::pair<const interval<Key>, T>     value_type;
+  typedef const value_type*                       pointer;
+  typedef const value_type&                       reference;
+  typedef typename base_iter::base_ptr            base_ptr;
+  typedef interval_map_node<Key, T, Compare>*     node_ptr;
+  typedef interval_map_const_iterator             self;
+
+  using base_iter::node;
+
+  // 构造函数
+  interval_map_const_iterator() {}
+  interval_map_const_iterator(base_ptr x) { node = x; }
+  interval_map_const_iterator(const interval_map_iterator<Key, T, Compare>& rhs) { node = rhs.node; }
+
+  // 重载操作符
+  reference operator*()  const { return static_cast<node_ptr>(node)->value; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    this->inc();
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp(*this);
+    this->inc();
+    return tmp;
+  }
+  self& operator--()
+  {
+    this->dec();
+    return *this;
+  }
+  self operator--(int)
+  {
+    self tmp(*this);
+    this->dec();
+    return tmp;
+  }
+
+  bool operator==(const self& rhs) const { return node == rhs.node; }
+  bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+// 模板类 interval_map，键值允许重复
+// 参数一代表区间端点的类型，参数二代表实值类型，参数三代表端点的比较方式，缺省使用 mystl::less
+template <class Key, class T, class Compare = mystl::less<Key>>
+class interval_map
+{
+public:
+  // interval_map 的型别定义
+  typedef interval<Key>                               interval_type;
+  typedef interval<Key>                               key_type;
+  typedef Key                                         point_type;
+  typedef T                                           mapped_type;
+  typedef mystl::pair<const interval_type, T>         value_type;
+  typedef Compare                                     point_compare;
+
+  typedef value_type*                                 pointer;
+  typedef const value_type*                           const_pointer;
+  typedef value_type&                                 reference;
+  typedef const value_type&                           const_reference;
+  typedef interval_map_iterator<Key, T, Compare>       iterator;
+  typedef interval_map_const_iterator<Key, T, Compare> const_iterator;
+  typedef mystl::reverse_iterator<iterator>           reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>     const_reverse_iterator;
+  typedef size_t                                      size_type;
+  typedef ptrdiff_t                                   difference_type;
+  typedef mystl::allocator<value_type>                allocator_type;
+
+private:
+  typedef rb_tree_node_base<interval_map_node_tag<Key, T, Compare>> base_type;
+  typedef base_type*                                  base_ptr;
+  typedef interval_map_node<Key, T, Compare>          node_type;
+  typedef node_type*                                  node_ptr;
+
+  typedef mystl::allocator<base_type>                 base_allocator;
+#if RB_TREE_USE_NODE_POOL
+  typedef mystl::node_pool<node_type>                 node_allocator;
+#else
+  typedef mystl::allocator<node_type>                 node_allocator;
+#endif
+
+private:
+  base_ptr      header_;      // 特殊节点，与根节点互为对方的父节点
+  size_type     node_count_;  // 节点数
+  point_compare comp_;        // 端点的比较准则
+
+  base_ptr  root()      const { return header_->parent(); }
+  void      set_root(base_ptr x) const { header_->set_parent(x); }
+  base_ptr& leftmost()  const { return header_->left; }
+  base_ptr& rightmost() const { return header_->right; }
+
+  static node_ptr node(base_ptr x) { return static_cast<node_ptr>(x); }
+
+public:
+  // 构造、复制、移动、析构函数
+  interval_map() { init(); }
+
+  template <class InputIterator>
+  interval_map(InputIterator first, InputIterator last)
+  {
+    init();
+    try
+    {
+      insert(first, last);
+    }
+    catch (...)
+    {
+      clear();
+      base_allocator::deallocate(header_);
+      throw;
+    }
+  }
+
+  interval_map(std::initializer_list<value_type> ilist)
+    :interval_map(ilist.begin(), ilist.end())
+  {
+  }
+
+  interval_map(const interval_map& rhs)
+    :interval_map(rhs.begin(), rhs.end())
+  {
+  }
+
+  interval_map(interval_map&& rhs) noexcept
+    :header_(rhs.header_), node_count_(rhs.node_count_), comp_(rhs.comp_)
+  {
+    rhs.header_ = nullptr;
+    rhs.node_count_ = 0;
+  }
+
+  interval_map& operator=(const interval_map& rhs)
+  {
+    if (this != &rhs)
+    {
+      interval_map tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  interval_map& operator=(interval_map&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      clear();
+      if (header_ != nullptr)
+        base_allocator::deallocate(header_);
+      header_ = rhs.header_;
+      node_count_ = rhs.node_count_;
+      comp_ = rhs.comp_;
+      rhs.header_ = nullptr;
+      rhs.node_count_ = 0;
+    }
+    return *this;
+  }
+
+  interval_map& operator=(std::initializer_list<value_type> ilist)
+  {
+    interval_map tmp(ilist);
+    swap(tmp);
+    return *this;
+  }
+
+  ~interval_map()
+  {
+    clear();
+    if (header_ != nullptr)
+      base_allocator::deallocate(header_);
+  }
+
+public:
+  // 相关接口
+  point_compare  point_comp()    const { return comp_; }
+  allocator_type get_allocator() const { return allocator_type(); }
+
+  // 迭代器相关
+  iterator               begin()         noexcept
+  { return leftmost(); }
+  const_iterator         begin()   const noexcept
+  { return leftmost(); }
+  iterator               end()           noexcept
+  { return header_; }
+  const_iterator         end()     const noexcept
+  { return header_; }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return node_count_ == 0; }
+  size_type size()     const noexcept { return node_count_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+  // 插入删除操作
+
+  template <class ...Args>
+  iterator emplace(Args&& ...args)
+  {
+    THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "interval_map<Key, T>'s size too big");
+    return insert_node(create_node(mystl::forward<Args>(args)...));
+  }
+
+  iterator insert(const value_type& value)
+  {
+    return emplace(value);
+  }
+  iterator insert(value_type&& value)
+  {
+    return emplace(mystl::move(value));
+  }
+
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last)
+  {
+    for (; first != last; ++first)
+      emplace(*first);
+  }
+  void insert(std::initializer_list<value_type> ilist)
+  {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  iterator  erase(iterator position);
+  size_type erase(const interval_type& key);
+  void      erase(iterator first, iterator last);
+
+  void      clear();
+
+  // interval_map 相关操作
+
+  // 查找与 key 完全相同的区间
+  iterator       find(const interval_type& key)
+  {
+    auto y = lower_bound_node(key);
+    return (y == header_ || key_less(key, node(y)->value.first)) ? header_ : y;
+  }
+  const_iterator find(const interval_type& key) const
+  {
+    auto y = lower_bound_node(key);
+    return (y == header_ || key_less(key, node(y)->value.first)) ? header_ : y;
+  }
+
+  size_type      count(const interval_type& key) const
+  {
+    auto p = equal_range(key);
+    return static_cast<size_type>(mystl::distance(p.first, p.second));
+  }
+
+  iterator       lower_bound(const interval_type& key)
+  { return lower_bound_node(key); }
+  const_iterator lower_bound(const interval_type& key) const
+  { return lower_bound_node(key); }
+
+  iterator       upper_bound(const interval_type& key)
+  { return upper_bound_node(key); }
+  const_iterator upper_bound(const interval_type& key) const
+  { return upper_bound_node(key); }
+
+  pair<iterator, iterator>
+    equal_range(const interval_type& key)
+  { return mystl::make_pair(lower_bound(key), upper_bound(key)); }
+  pair<const_iterator, const_iterator>
+    equal_range(const interval_type& key) const
+  { return mystl::make_pair(lower_bound(key), upper_bound(key)); }
+
+  // 区间查询
+
+  // 按顺序把包含 point 的区间的迭代器写入 result
+  template <class OutputIterator>
+  OutputIterator stab(const point_type& point, OutputIterator result) const
+  { return overlap_since(root(), point, point, result); }
+
+  // 按顺序把与 key 相交的区间的迭代器写入 result
+  template <class OutputIterator>
+  OutputIterator overlap(const interval_type& key, OutputIterator result) const
+  { return overlap_since(root(), key.low, key.high, result); }
+
+  // 返回任意一个与 key 相交的区间，没有时返回 end()
+  iterator       find_overlap(const interval_type& key)
+  { return find_overlap_node(key.low, key.high); }
+  const_iterator find_overlap(const interval_type& key) const
+  { return find_overlap_node(key.low, key.high); }
+
+  void swap(interval_map& rhs) noexcept
+  {
+    mystl::swap(header_, rhs.header_);
+    mystl::swap(node_count_, rhs.node_count_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+
+private:
+  // helper functions
+
+  // node related
+  void     init();
+  template <class ...Args>
+  node_ptr create_node(Args&& ...args);
+  void     destroy_node(node_ptr p) noexcept;
+  void     erase_since(base_ptr x) noexcept;
+
+  // 按 (low, high) 比较两个区间
+  bool     key_less(const interval_type& lhs, const interval_type& rhs) const
+  {
+    return comp_(lhs.low, rhs.low) || (!comp_(rhs.low, lhs.low) && comp_(lhs.high, rhs.high));
+  }
+
+  // insert / lookup
+  iterator insert_node(node_ptr np);
+  base_ptr lower_bound_node(const interval_type& key) const;
+  base_ptr upper_bound_node(const interval_type& key) const;
+
+  // interval query
+  template <class OutputIterator>
+  OutputIterator overlap_since(base_ptr x, const point_type& low, const point_type& high,
+                               OutputIterator result) const;
+  base_ptr find_overlap_node(const point_type& low, const point_type& high) const;
+};
+
+/*****************************************************************************************/
+
+// 删除 position 处的元素，返回下一个位置
+template <class Key, class T, class Compare>
+typename interval_map<Key, T, Compare>::iterator
+interval_map<Key, T, Compare>::
+erase(iterator position)
+{
+  iterator next(position);
+  ++next;
+  auto r = root();
+  rb_tree_erase_rebalance(position.node, r, leftmost(), rightmost());
+  set_root(r);
+  destroy_node(node(position.node));
+  --node_count_;
+  return next;
+}
+
+// 删除与 key 完全相同的区间，返回删除的个数
+template <class Key, class T, class Compare>
+typename interval_map<Key, T, Compare>::size_type
+interval_map<Key, T, Compare>::
+erase(const interval_type& key)
+{
+  auto p = equal_range(key);
+  size_type n = 0;
+  while (p.first != p.second)
+  {
+    p.first = erase(p.first);
+    ++n;
+  }
+  return n;
+}
+
+// 删除 [first, last) 区间内的元素
+template <class Key, class T, class Compare>
+void interval_map<Key, T, Compare>::
+erase(iterator first, iterator last)
+{
+  if (first == begin() && last == end())
+  {
+    clear();
+  }
+  else
+  {
+    while (first != last)
+      first = erase(first);
+  }
+}
+
+// 清空容器
+template <class Key, class T, class Compare>
+void interval_map<Key, T, Compare>::
+clear()
+{
+  if (node_count_ != 0)
+  {
+    erase_since(root());
+    leftmost() = header_;
+    set_root(nullptr);
+    rightmost() = header_;
+    node_count_ = 0;
+  }
+}
+
+// init 函数
+template <class Key, class T, class Compare>
+void interval_map<Key, T, Compare>::
+init()
+{
+  header_ = base_allocator::allocate(1);
+  header_->init_parent(nullptr, rb_tree_red);  // header_ 节点颜色为红，与 root 区分
+  leftmost() = header_;
+  rightmost() = header_;
+  node_count_ = 0;
+}
+
+// 创建一个节点
+template <class Key, class T, class Compare>
+template <class ...Args>
+typename interval_map<Key, T, Compare>::node_ptr
+interval_map<Key, T, Compare>::
+create_node(Args&& ...args)
+{
+#if RB_TREE_USE_NODE_POOL
+  node_ptr p = node_allocator::allocate();
+#else
+  node_ptr p = node_allocator::allocate(1);
+#endif
+  try
+  {
+    mystl::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+  }
+  catch (...)
+  {
+    node_allocator::deallocate(p);
+    throw;
+  }
+  MYSTL_DEBUG(!comp_(p->value.first.high, p->value.first.low));
+  p->left = nullptr;
+  p->right = nullptr;
+  p->max_high = &p->value.first.high;
+  return p;
+}
+
+// 销毁一个节点
+template <class Key, class T, class Compare>
+void interval_map<Key, T, Compare>::
+destroy_node(node_ptr p) noexcept
+{
+  mystl::destroy(mystl::address_of(p->value));
+  node_allocator::deallocate(p);
+}
+
+// 销毁以 x 为根的子树
+template <class Key, class T, class Compare>
+void interval_map<Key, T, Compare>::
+erase_since(base_ptr x) noexcept
+{
+  while (x != nullptr)
+  {
+    erase_since(x->right);
+    auto y = x->left;
+    destroy_node(node(x));
+    x = y;
+  }
+}
+
+// 把节点插入到所有不大于它的区间之后，再由 rb_tree_insert_rebalance 维护颜色与子树最大值
+template <class Key, class T, class Compare>
+typename interval_map<Key, T, Compare>::iterator
+interval_map<Key, T, Compare>::
+insert_node(node_ptr np)
+{
+  base_ptr y = header_;
+  base_ptr x = root();
+  bool add_to_left = true;
+  while (x != nullptr)
+  {
+    y = x;
+    add_to_left = key_less(np->value.first, node(x)->value.first);
+    x = add_to_left ? x->left : x->right;
+  }
+  base_ptr base_node = np;
+  base_node->set_parent(y);
+  if (y == header_)
+  {
+    set_root(base_node);
+    leftmost() = base_node;
+    rightmost() = base_node;
+  }
+  else if (add_to_left)
+  {
+    y->left = base_node;
+    if (leftmost() == y)
+      leftmost() = base_node;
+  }
+  else
+  {
+    y->right = base_node;
+    if (rightmost() == y)
+      rightmost() = base_node;
+  }
+  auto r = root();
+  rb_tree_insert_rebalance(base_node, r);
+  set_root(r);
+  ++node_count_;
+  return iterator(base_node);
+}
+
+// 查找第一个不小于 key 的区间，没有这样的区间时返回 header_
+template <class Key, class T, class Compare>
+typename interval_map<Key, T, Compare>::base_ptr
+interval_map<Key, T, Compare>::
+lower_bound_node(const interval_type& key) const
+{
+  auto y = header_;
+  auto x = root();
+  while (x != nullptr)
+  {
+    if (!key_less(node(x)->value.first, key))
+    {
+      y = x;
+      x = x->left;
+    }
+    else
+    {
+      x = x->right;
+    }
+  }
+  return y;
+}
+
+// 查找第一个大于 key 的区间，没有这样的区间时返回 header_
+template <class Key, class T, class Compare>
+typename interval_map<Key, T, Compare>::base_ptr
+interval_map<Key, T, Compare>::
+upper_bound_node(const interval_type& key) const
+{
+  auto y = header_;
+  auto x = root();
+  while (x != nullptr)
+  {
+    if (key_less(key, node(x)->value.first))
+    {
+      y = x;
+      x = x->left;
+    }
+    else
+    {
+      x = x->right;
+    }
+  }
+  return y;
+}
+
+// 按顺序输出以 x 为根的子树中与 [low, high] 相交的区间
+// 子树中最大的右端点小于 low 时整颗子树都不相交；某个节点的左端点大于 high 时，它与右子树都不相交
+template <class Key, class T, class Compare>
+template <class OutputIterator>
+OutputIterator interval_map<Key, T, Compare>::
+overlap_since(base_ptr x, const point_type& low, const point_type& high,
+              OutputIterator result) const
+{
+  while (x != nullptr && !comp_(*node(x)->max_high, low))
+  {
+    result = overlap_since(x->left, low, high, result);
+    const interval_type& key = node(x)->value.first;
+    if (comp_(high, key.low))
+      break;
+    if (!comp_(key.high, low))
+    {
+      *result = const_iterator(x);
+      ++result;
+    }
+    x = x->right;
+  }
+  return result;
+}
+
+// 查找任意一个与 [low, high] 相交的区间，没有时返回 header_
+// 左子树中最大的右端点不小于 low 时，若左子树中没有相交的区间，右子树中也一定没有，因此只需走一条路径
+template <class Key, class T, class Compare>
+typename interval_map<Key, T, Compare>::base_ptr
+interval_map<Key, T, Compare>::
+find_overlap_node(const point_type& low, const point_type& high) const
+{
+  auto x = root();
+  while (x != nullptr)
+  {
+    const interval_type& key = node(x)->value.first;
+    if (!comp_(high, key.low) && !comp_(key.high, low))
+      return x;
+    if (x->left != nullptr && !comp_(*node(x->left)->max_high, low))
+      x = x->left;
+    else
+      x = x->right;
+  }
+  return header_;
+}
+
+// 重载比较操作符
+template <class Key, class T, class Compare>
+bool operator==(const interval_map<Key, T, Compare>& lhs, const interval_map<Key, T, Compare>& rhs)
+{
+  return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin(),
+    [](const typename interval_map<Key, T, Compare>::value_type& a,
+       const typename interval_map<Key, T, Compare>::value_type& b)
+    { return a.first == b.first && a.second == b.second; });
+}
+
+template <class Key, class T, class Compare>
+bool operator!=(const interval_map<Key, T, Compare>& lhs, const interval_map<Key, T, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Compare>
+void swap(interval_map<Key, T, Compare>& lhs, interval_map<Key, T, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_INTERVAL_MAP_H_
+
@@ -0,0 +1,711 @@
+#ifndef MYTINYSTL_INTRUSIVE_LIST_H_
+#define MYTINYSTL_INTRUSIVE_LIST_H_
+
+// 这个头文件包含了一个模板类 intrusive_list
+// intrusive_list : 侵入式双向链表
+
+// notes:
+//
+// 链接指针存放在元素内部的 intrusive_list_hook 成员中，容器不分配任何内存，也不拥有元素：
+//   * 插入的元素必须由使用者保证在链表中时一直有效
+//   * erase / clear 只是把元素从链表上摘下，不会析构元素
+//   * 一个 hook 同一时刻只能挂在一个链表上，需要同时挂在多个链表上时，使用多个 hook 成员
+// 可以通过 iterator_to / erase(value) 在 O(1) 时间内由元素的引用定位或删除元素
+
+#include "iterator.h"
+#include "functional.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 侵入式链表的钩子，作为成员嵌入到元素中
+struct intrusive_list_hook
+{
+  intrusive_list_hook* prev = nullptr;  // 前一节点
+  intrusive_list_hook* next = nullptr;  // 下一节点
+
+  intrusive_list_hook() = default;
+
+  // 复制元素时不复制链接关系
+  intrusive_list_hook(const intrusive_list_hook&) noexcept {}
+  intrusive_list_hook& operator=(const intrusive_list_hook&) noexcept { return *this; }
+
+  bool is_linked() const noexcept { return next != nullptr; }
+};
+
+// 在元素与 hook 之间转换
+template <class T, intrusive_list_hook T::*Hook>
+struct intrusive_list_traits
+{
+  typedef intrusive_list_hook* hook_ptr;
+
+  static hook_ptr to_hook(T& value) noexcept
+  {
+    return &(value.*Hook);
+  }
+
+  static T* to_value(hook_ptr h) noexcept
+  {
+    return reinterpret_cast<T*>(reinterpret_cast<char*>(h) - offset());
+  }
+
+  static ptrdiff_t offset() noexcept
+  {
+    // 在一块真实存在且对齐的存储上求成员的偏移量，只取地址，不构造也不访问对象
+    // Hook 不可能指向虚基类中的成员，所以偏移量对所有 T 对象都相同
+    alignas(T) static unsigned char storage[sizeof(T)];
+    const auto p = reinterpret_cast<const T*>(storage);
+    return reinterpret_cast<const char*>(&(p->*Hook)) - reinterpret_cast<const char*>(p);
+  }
+};
+
+// intrusive_list 的迭代器设计
+template <class T, intrusive_list_hook T::*Hook>
+struct intrusive_list_iterator : public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+  typedef T                                   value_type;
+  typedef T*                                  pointer;
+  typedef T&                                  reference;
+  typedef intrusive_list_hook*                hook_ptr;
+  typedef intrusive_list_traits<T, Hook>      traits;
+  typedef intrusive_list_iterator<T, Hook>    self;
+
+  hook_ptr node_;  // 指向当前节点
+
+  // 构造函数
+  intrusive_list_iterator() = default;
+  intrusive_list_iterator(hook_ptr x)
+    :node_(x) {}
+
+  // 重载操作符
+  reference operator*()  const { return *traits::to_value(node_); }
+  pointer   operator->() const { return traits::to_value(node_); }
+
+  self& operator++()
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    node_ = node_->next;
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  self& operator--()
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    node_ = node_->prev;
+    return *this;
+  }
+  self operator--(int)
+  {
+    self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+  bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+template <class T, intrusive_list_hook T::*Hook>
+struct intrusive_list_const_iterator : public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+  typedef T                                      value_type;
+  typedef const T*                               pointer;
+  typedef const T&                               reference;
+  typedef intrusive_list_hook*                   hook_ptr;
+  typedef intrusive_list_traits<T, Hook>         traits;
+  typedef intrusive_list_const_iterator<T, Hook> self;
+
+  hook_ptr node_;
+
+  intrusive_list_const_iterator() = default;
+  intrusive_list_const_iterator(hook_ptr x)
+    :node_(x) {}
+  intrusive_list_const_iterator(const intrusive_list_iterator<T, Hook>& rhs)
+    :node_(rhs.node_) {}
+
+  reference operator*()  const { return *traits::to_value(node_); }
+  pointer   operator->() const { return traits::to_value(node_); }
+
+  self& operator++()
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    node_ = node_->next;
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  self& operator--()
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    node_ = node_->prev;
+    return *this;
+  }
+  self operator--(int)
+  {
+    self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+  bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// 模板类: intrusive_list
+// 模板参数 T 代表元素类型，Hook 代表元素中用于链接的 intrusive_list_hook 成员
+template <class T, intrusive_list_hook T::*Hook>
+class intrusive_list
+{
+public:
+  // intrusive_list 的嵌套型别定义
+  typedef T                                              value_type;
+  typedef T*                                             pointer;
+  typedef const T*                                       const_pointer;
+  typedef T&                                             reference;
+  typedef const T&                                       const_reference;
+  typedef size_t                                         size_type;
+  typedef ptrdiff_t                                      difference_type;
+
+  typedef intrusive_list_iterator<T, Hook>               iterator;
+  typedef intrusive_list_const_iterator<T, Hook>         const_iterator;
+  typedef mystl::reverse_iterator<iterator>              reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>        const_reverse_iterator;
+
+  typedef intrusive_list_hook*                           hook_ptr;
+  typedef intrusive_list_traits<T, Hook>                 traits;
+
+private:
+  intrusive_list_hook node_;  // 哨兵节点，不对应任何元素
+  size_type           size_;  // 大小
+
+public:
+  // 构造、移动、析构函数
+  intrusive_list() noexcept
+    :size_(0)
+  { reset(); }
+
+  intrusive_list(intrusive_list&& rhs) noexcept
+    :size_(0)
+  {
+    reset();
+    swap(rhs);
+  }
+
+  intrusive_list& operator=(intrusive_list&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  // 元素不归容器所有，因此不允许复制
+  intrusive_list(const intrusive_list&) = delete;
+  intrusive_list& operator=(const intrusive_list&) = delete;
+
+  ~intrusive_list()
+  { clear(); }
+
+public:
+  // 迭代器相关操作
+  iterator               begin()         noexcept
+  { return node_.next; }
+  const_iterator         begin()   const noexcept
+  { return node_.next; }
+  iterator               end()           noexcept
+  { return &node_; }
+  const_iterator         end()     const noexcept
+  { return const_cast<hook_ptr>(&node_); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 由元素的引用得到迭代器，元素必须已在本链表中
+  iterator               iterator_to(reference value) noexcept
+  {
+    MYSTL_DEBUG(traits::to_hook(value)->is_linked());
+    return traits::to_hook(value);
+  }
+  const_iterator         iterator_to(const_reference value) const noexcept
+  {
+    return traits::to_hook(const_cast<reference>(value));
+  }
+
+  // 容量相关操作
+  bool      empty()    const noexcept
+  { return node_.next == &node_; }
+
+  size_type size()     const noexcept
+  { return size_; }
+
+  size_type max_size() const noexcept
+  { return static_cast<size_type>(-1); }
+
+  // 访问元素相关操作
+  reference       front()
+  {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+
+  const_reference front() const
+  {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+
+  reference       back()
+  {
+    MYSTL_DEBUG(!empty());
+    return *(--end());
+  }
+
+  const_reference back()  const
+  {
+    MYSTL_DEBUG(!empty());
+    return *(--end());
+  }
+
+  // 调整容器相关操作
+
+  // push_front / push_back
+
+  void push_front(reference value) noexcept
+  { insert(begin(), value); }
+
+  void push_back(reference value) noexcept
+  { insert(end(), value); }
+
+  // pop_front / pop_back
+
+  void pop_front() noexcept
+  {
+    MYSTL_DEBUG(!empty());
+    erase(begin());
+  }
+
+  void pop_back() noexcept
+  {
+    MYSTL_DEBUG(!empty());
+    erase(--end());
+  }
+
+  // insert
+
+  iterator insert(const_iterator pos, reference value) noexcept
+  {
+    auto h = traits::to_hook(value);
+    MYSTL_DEBUG(!h->is_linked());
+    link_nodes(pos.node_, h, h);
+    ++size_;
+    return h;
+  }
+
+  template <class Iter>
+  void     insert(const_iterator pos, Iter first, Iter last) noexcept
+  {
+    for (; first != last; ++first)
+      insert(pos, *first);
+  }
+
+  // erase / clear
+
+  iterator erase(const_iterator pos) noexcept;
+  iterator erase(const_iterator first, const_iterator last) noexcept;
+  iterator erase(reference value) noexcept
+  { return erase(iterator_to(value)); }
+
+  void     clear() noexcept;
+
+  void     swap(intrusive_list& rhs) noexcept;
+
+  // intrusive_list 相关操作
+
+  void splice(const_iterator pos, intrusive_list& other) noexcept;
+  void splice(const_iterator pos, intrusive_list& other, const_iterator it) noexcept;
+  void splice(const_iterator pos, intrusive_list& other,
+              const_iterator first, const_iterator last) noexcept;
+
+  void remove(const value_type& value)
+  { remove_if([&](const value_type& v) {return v == value; }); }
+  template <class UnaryPredicate>
+  void remove_if(UnaryPredicate pred);
+
+  void unique()
+  { unique(mystl::equal_to<T>()); }
+  template <class BinaryPredicate>
+  void unique(BinaryPredicate pred);
+
+  void merge(intrusive_list& x)
+  { merge(x, mystl::less<T>()); }
+  template <class Compare>
+  void merge(intrusive_list& x, Compare comp);
+
+  void sort()
+  { sort(mystl::less<T>()); }
+  template <class Compared>
+  void sort(Compared comp);
+
+  void reverse() noexcept;
+
+private:
+  // helper functions
+
+  void reset() noexcept
+  { node_.prev = node_.next = &node_; }
+
+  static void link_nodes(hook_ptr pos, hook_ptr first, hook_ptr last) noexcept;
+  static void unlink_nodes(hook_ptr first, hook_ptr last) noexcept;
+  static void clear_hook(hook_ptr h) noexcept
+  { h->prev = h->next = nullptr; }
+
+};
+
+/*****************************************************************************************/
+
+// 摘下 pos 处的元素
+template <class T, intrusive_list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::erase(const_iterator pos) noexcept
+{
+  MYSTL_DEBUG(pos != cend());
+  auto n = pos.node_;
+  auto next = n->next;
+  unlink_nodes(n, n);
+  clear_hook(n);
+  --size_;
+  return next;
+}
+
+// 摘下 [first, last) 内的元素
+template <class T, intrusive_list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::erase(const_iterator first, const_iterator last) noexcept
+{
+  if (first != last)
+  {
+    unlink_nodes(first.node_, last.node_->prev);
+    while (first != last)
+    {
+      auto cur = first.node_;
+      ++first;
+      clear_hook(cur);
+      --size_;
+    }
+  }
+  return last.node_;
+}
+
+// 清空 intrusive_list
+template <class T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::clear() noexcept
+{
+  auto cur = node_.next;
+  while (cur != &node_)
+  {
+    auto next = cur->next;
+    clear_hook(cur);
+    cur = next;
+  }
+  reset();
+  size_ = 0;
+}
+
+// 交换两个 intrusive_list，需要修正首尾元素指向哨兵的指针
+template <class T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::swap(intrusive_list& rhs) noexcept
+{
+  if (this == &rhs)
+    return;
+  const bool lhs_empty = empty();
+  const bool rhs_empty = rhs.empty();
+  mystl::swap(node_.prev, rhs.node_.prev);
+  mystl::swap(node_.next, rhs.node_.next);
+  mystl::swap(size_, rhs.size_);
+  if (rhs_empty)
+    reset();
+  else
+    node_.next->prev = node_.prev->next = &node_;
+  if (lhs_empty)
+    rhs.reset();
+  else
+    rhs.node_.next->prev = rhs.node_.prev->next = &rhs.node_;
+}
+
+// 将 x 的所有元素接合于 pos 之前
+template <class T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list& x) noexcept
+{
+  MYSTL_DEBUG(this != &x);
+  if (!x.empty())
+  {
+    auto f = x.node_.next;
+    auto l = x.node_.prev;
+
+    unlink_nodes(f, l);
+    link_nodes(pos.node_, f, l);
+
+    size_ += x.size_;
+    x.size_ = 0;
+  }
+}
+
+// 将 it 所指的元素接合于 pos 之前
+template <class T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list& x,
+                                     const_iterator it) noexcept
+{
+  if (pos.node_ != it.node_ && pos.node_ != it.node_->next)
+  {
+    auto f = it.node_;
+
+    unlink_nodes(f, f);
+    link_nodes(pos.node_, f, f);
+
+    ++size_;
+    --x.size_;
+  }
+}
+
+// 将 x 的 [first, last) 内的元素接合于 pos 之前
+template <class T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list& x,
+                                     const_iterator first, const_iterator last) noexcept
+{
+  if (first != last)
+  {
+    if (this != &x)
+    {
+      size_type n = mystl::distance(first, last);
+      size_ += n;
+      x.size_ -= n;
+    }
+    auto f = first.node_;
+    auto l = last.node_->prev;
+
+    unlink_nodes(f, l);
+    link_nodes(pos.node_, f, l);
+  }
+}
+
+// 将另一元操作 pred 为 true 的所有元素摘下
+template <class T, intrusive_list_hook T::*Hook>
+template <class UnaryPredicate>
+void intrusive_list<T, Hook>::remove_if(UnaryPredicate pred)
+{
+  auto f = begin();
+  auto l = end();
+  for (auto next = f; f != l; f = next)
+  {
+    ++next;
+    if (pred(*f))
+    {
+      erase(f);
+    }
+  }
+}
+
+// 摘下满足 pred 为 true 的重复元素
+template <class T, intrusive_list_hook T::*Hook>
+template <class BinaryPredicate>
+void intrusive_list<T, Hook>::unique(BinaryPredicate pred)
+{
+  auto i = begin();
+  auto e = end();
+  auto j = i;
+  ++j;
+  while (j != e)
+  {
+    if (pred(*i, *j))
+    {
+      erase(j);
+    }
+    else
+    {
+      i = j;
+    }
+    j = i;
+    ++j;
+  }
+}
+
+// 与另一个 intrusive_list 合并，按照 comp 为 true 的顺序
+template <class T, intrusive_list_hook T::*Hook>
+template <class Compare>
+void intrusive_list<T, Hook>::merge(intrusive_list& x, Compare comp)
+{
+  if (this != &x)
+  {
+    auto f1 = begin();
+    auto l1 = end();
+    auto f2 = x.begin();
+    auto l2 = x.end();
+
+    while (f1 != l1 && f2 != l2)
+    {
+      if (comp(*f2, *f1))
+      {
+        // 使 comp 为 true 的一段区间
+        auto next = f2;
+        ++next;
+        size_type n = 1;
+        for (; next != l2 && comp(*next, *f1); ++next)
+          ++n;
+        auto f = f2.node_;
+        auto l = next.node_->prev;
+        f2 = next;
+
+        // 每移动一段就更新大小，comp 抛出异常时两个链表的大小仍然正确
+        unlink_nodes(f, l);
+        link_nodes(f1.node_, f, l);
+        size_ += n;
+        x.size_ -= n;
+      }
+      ++f1;
+    }
+    // 连接剩余部分
+    if (f2 != l2)
+    {
+      auto f = f2.node_;
+      auto l = l2.node_->prev;
+      unlink_nodes(f, l);
+      link_nodes(l1.node_, f, l);
+      size_ += x.size_;
+      x.size_ = 0;
+    }
+  }
+}
+
+// 归并排序，用一组临时链表保存长度为 2^i 的有序段，不分配内存
+// comp 抛出异常时，临时链表中的元素全部接回 *this，元素不会丢失，但顺序未指定
+template <class T, intrusive_list_hook T::*Hook>
+template <class Compared>
+void intrusive_list<T, Hook>::sort(Compared comp)
+{
+  if (size_ < 2)
+    return;
+  intrusive_list carry;
+  intrusive_list counter[64];
+  int fill = 0;
+  try
+  {
+    while (!empty())
+    {
+      carry.splice(carry.begin(), *this, begin());
+      int i = 0;
+      while (i < fill && !counter[i].empty())
+      {
+        counter[i].merge(carry, comp);
+        carry.swap(counter[i++]);
+      }
+      carry.swap(counter[i]);
+      if (i == fill)
+        ++fill;
+    }
+    for (int i = 1; i < fill; ++i)
+      counter[i].merge(counter[i - 1], comp);
+  }
+  catch (...)
+  {
+    splice(end(), carry);
+    for (int i = 0; i < fill; ++i)
+      splice(end(), counter[i]);
+    throw;
+  }
+  swap(counter[fill - 1]);
+}
+
+// 将 intrusive_list 反转
+template <class T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::reverse() noexcept
+{
+  if (size_ <= 1)
+    return;
+  hook_ptr cur = &node_;
+  do
+  {
+    mystl::swap(cur->prev, cur->next);
+    cur = cur->prev;
+  } while (cur != &node_);
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 在 pos 处连接 [first, last] 的结点
+template <class T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::link_nodes(hook_ptr pos, hook_ptr first, hook_ptr last) noexcept
+{
+  pos->prev->next = first;
+  first->prev = pos->prev;
+  pos->prev = last;
+  last->next = pos;
+}
+
+// 将 [first, last] 结点从所在链表断开
+template <class T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::unlink_nodes(hook_ptr first, hook_ptr last) noexcept
+{
+  first->prev->next = last->next;
+  last->next->prev = first->prev;
+}
+
+// 重载比较操作符
+template <class T, intrusive_list_hook T::*Hook>
+bool operator==(const intrusive_list<T, Hook>& lhs, const intrusive_list<T, Hook>& rhs)
+{
+  auto f1 = lhs.cbegin();
+  auto f2 = rhs.cbegin();
+  auto l1 = lhs.cend();
+  auto l2 = rhs.cend();
+  for (; f1 != l1 && f2 != l2 && *f1 == *f2; ++f1, ++f2)
+    ;
+  return f1 == l1 && f2 == l2;
+}
+
+template <class T, intrusive_list_hook T::*Hook>
+bool operator!=(const intrusive_list<T, Hook>& lhs, const intrusive_list<T, Hook>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T, intrusive_list_hook T::*Hook>
+void swap(intrusive_list<T, Hook>& lhs, intrusive_list<T, Hook>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_INTRUSIVE_LIST_H_
+
@@ -22,10 +22,17 @@
 #include "functional.h"
 #include "util.h"
 #include "exceptdef.h"
+#include "node_pool.h"
+#include "vector.h"
 
 namespace mystl
 {
 
+// list 的节点是否从 node_pool 中按块分配
+#ifndef LIST_USE_NODE_POOL
+#define LIST_USE_NODE_POOL 1
+#endif
+
 template <class T> struct list_node_base;
 template <class T> struct list_node;
 
@@ -214,7 +221,11 @@ public:
   typedef mystl::allocator<T>                      allocator_type;
   typedef mystl::allocator<T>                      data_allocator;
   typedef mystl::allocator<list_node_base<T>>      base_allocator;
+#if LIST_USE_NODE_POOL
+  typedef mystl::node_pool<list_node<T>>           node_allocator;
+#else
   typedef mystl::allocator<list_node<T>>           node_allocator;
+#endif
 
   typedef typename allocator_type::value_type      value_type;
   typedef typename allocator_type::pointer         pointer;
@@ -232,7 +243,7 @@ public:
   typedef typename node_traits<T>::base_ptr        base_ptr;
   typedef typename node_traits<T>::node_ptr        node_ptr;
 
-  allocator_type get_allocator() { return node_allocator(); }
+  allocator_type get_allocator() { return allocator_type(); }
 
 private:
   base_ptr  node_;  // 指向末尾节点
@@ -503,6 +514,16 @@ public:
   void     resize(size_type new_size) { resize(new_size, value_type()); }
   void     resize(size_type new_size, const value_type& value);
 
+  // 预先准备 n 个空闲节点，之后的插入不再向系统申请内存
+  void     reserve(size_type n)
+  {
+#if LIST_USE_NODE_POOL
+    node_allocator::reserve(n);
+#else
+    (void)n;
+#endif
+  }
+
   void     swap(list& rhs) noexcept
   {
     mystl::swap(node_, rhs.node_);
@@ -531,10 +552,16 @@ public:
   void merge(list& x, Compare comp);
 
   void sort()
-  { list_sort(begin(), end(), size(), mystl::less<T>()); }
+  { sort(mystl::less<T>()); }
   template <class Compared>
   void sort(Compared comp)
-  { list_sort(begin(), end(), size(), comp); }
+  { list_sort(comp); }
+
+  // 借助节点指针数组排序，对大链表更快，但需要 O(n) 的额外空间，sort 不会使用它
+  void pointer_sort()
+  { pointer_sort(mystl::less<T>()); }
+  template <class Compared>
+  void pointer_sort(Compared comp);
 
   void reverse();
 
@@ -570,7 +597,10 @@ private:
 
   // sort
   template <class Compared>
-  iterator  list_sort(iterator first, iterator last, size_type n, Compared comp);
+  void      list_sort(Compared comp);
+  template <class Compared>
+  void      merge_chain(base_ptr& a, base_ptr b, Compared comp);
+  void      relink_chain(base_ptr first);
 
 };
 
@@ -822,7 +852,7 @@ template <class ...Args>
 typename list<T>::node_ptr 
 list<T>::create_node(Args&& ...args)
 {
-  node_ptr p = node_allocator::allocate(1);
+  node_ptr p = node_allocator::allocate();
   try
   {
     data_allocator::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
@@ -1078,81 +1108,194 @@ list<T>::copy_insert(const_iterator pos, size_type n, Iter first)
   return r;
 }
 
-// 对 list 进行归并排序，返回一个迭代器指向区间最小元素的位置
+// 对 list 进行自底向上的归并排序
+// 排序时把链表拆成以 nullptr 结尾的单向链，parts[i] 保存长度为 2^i 的有序段，
+// 每次取下一个节点逐级向上合并，最后再统一修正 prev 指针，整个过程不需要递归与遍历定位
+// comp 抛出异常时，把所有的段接成一条链挂回 node_ 上，list 仍然有效，只是顺序未定
 template <class T>
 template <class Compared>
-typename list<T>::iterator 
-list<T>::list_sort(iterator f1, iterator l2, size_type n, Compared comp)
+void list<T>::list_sort(Compared comp)
 {
-  if (n < 2)
-    return f1;
+  if (size_ < 2)
+    return;
+  base_ptr parts[64] = {};
+  size_type fill = 0;
+  base_ptr carry = nullptr;
+  base_ptr result = nullptr;
+  node_->prev->next = nullptr;
+  base_ptr cur = node_->next;
+  try
+  {
+    while (cur != nullptr)
+    {
+      carry = cur;
+      cur = cur->next;
+      carry->next = nullptr;
+      size_type i = 0;
+      for (; i < fill && parts[i] != nullptr; ++i)
+      { // parts[i] 中的元素都在 carry 之前，放在第一个参数以保持稳定
+        auto b = carry;
+        carry = nullptr;
+        merge_chain(parts[i], b, comp);
+        carry = parts[i];
+        parts[i] = nullptr;
+      }
+      parts[i] = carry;
+      carry = nullptr;
+      if (i == fill)
+        ++fill;
+    }
+    for (size_type i = 0; i < fill; ++i)
+    {
+      if (parts[i] != nullptr)
+      {
+        auto b = result;
+        result = nullptr;
+        merge_chain(parts[i], b, comp);
+        result = parts[i];
+        parts[i] = nullptr;
+      }
+    }
+  }
+  catch (...)
+  {
+    // 每个节点都恰好在 cur、carry、result 与 parts 的某一条链中
+    base_ptr head = nullptr;
+    base_ptr* tail = &head;
+    auto append = [&tail](base_ptr chain) {
+      *tail = chain;
+      while (*tail != nullptr)
+        tail = &(*tail)->next;
+    };
+    append(result);
+    for (size_type i = 0; i < fill; ++i)
+      append(parts[i]);
+    append(carry);
+    append(cur);
+    relink_chain(head);
+    throw;
+  }
+  relink_chain(result);
+}
 
-  if (n == 2)
+// 合并 a、b 两条以 nullptr 结尾的有序单向链，结果放在 a 中，相等时 a 中的元素在前
+// comp 抛出异常时，a 中是包含两条链全部节点的一条链
+template <class T>
+template <class Compared>
+void list<T>::merge_chain(base_ptr& a, base_ptr b, Compared comp)
+{
+  list_node_base<T> head;
+  base_ptr tail = &head;
+  base_ptr x = a;
+  try
   {
-    if (comp(*--l2, *f1))
+    while (x != nullptr && b != nullptr)
     {
-      auto ln = l2.node_;
-      unlink_nodes(ln, ln);
-      link_nodes(f1.node_, ln, ln);
-      return l2;
+      if (comp(b->as_node()->value, x->as_node()->value))
+      {
+        tail->next = b;
+        b = b->next;
+      }
+      else
+      {
+        tail->next = x;
+        x = x->next;
+      }
+      tail = tail->next;
     }
-    return f1;
-  }
-
-  auto n2 = n / 2;
-  auto l1 = f1;
-  mystl::advance(l1, n2);
-  auto result = f1 = list_sort(f1, l1, n2, comp);  // 前半段的最小位置
-  auto f2 = l1 = list_sort(l1, l2, n - n2, comp);  // 后半段的最小位置
-
-  // 把较小的一段区间移到前面
-  if (comp(*f2, *f1))
-  {
-    auto m = f2;
-    ++m;
-    for (; m != l2 && comp(*m, *f1); ++m)
-      ;
-    auto f = f2.node_;
-    auto l = m.node_->prev;
-    result = f2;
-    l1 = f2 = m;
-    unlink_nodes(f, l);
-    m = f1;
-    ++m;
-    link_nodes(f1.node_, f, l);
-    f1 = m;
   }
-  else
+  catch (...)
+  {
+    tail->next = x;
+    while (tail->next != nullptr)
+      tail = tail->next;
+    tail->next = b;
+    a = head.next;
+    throw;
+  }
+  tail->next = x != nullptr ? x : b;
+  a = head.next;
+}
+
+// 把以 first 开头、nullptr 结尾的单向链重新挂回 node_ 上，并修正 prev 指针
+template <class T>
+void list<T>::relink_chain(base_ptr first)
+{
+  base_ptr prev = node_;
+  for (base_ptr cur = first; cur != nullptr; prev = cur, cur = cur->next)
   {
-    ++f1;
+    prev->next = cur;
+    cur->prev = prev;
   }
+  prev->next = node_;
+  node_->prev = prev;
+}
 
-  // 合并两段有序区间
-  while (f1 != l1 && f2 != l2)
+// 把节点指针复制到连续的数组中排序，再按顺序重新连接
+// 比较时只访问数组与节点的值，对大链表更友好，但需要额外 O(n) 的空间
+template <class T>
+template <class Compared>
+void list<T>::pointer_sort(Compared comp)
+{
+  if (size_ < 2)
+    return;
+  mystl::vector<node_ptr> buf;
+  mystl::vector<node_ptr> tmp;
+  try
   {
-    if (comp(*f2, *f1))
+    buf.reserve(size_);
+    tmp.resize(size_);
+  }
+  catch (...)
+  { // 内存不足时退回不需要额外空间的排序
+    list_sort(comp);
+    return;
+  }
+  for (base_ptr cur = node_->next; cur != node_; cur = cur->next)
+    buf.push_back(cur->as_node());
+
+  auto node_comp = [&](node_ptr a, node_ptr b) { return comp(a->value, b->value); };
+  const size_type n = size_;
+  const size_type run = 32;
+
+  // 先对每一小段做插入排序
+  for (size_type first = 0; first < n; first += run)
+  {
+    const size_type last = mystl::min(first + run, n);
+    for (size_type i = first + 1; i < last; ++i)
     {
-      auto m = f2;
-      ++m;
-      for (; m != l2 && comp(*m, *f1); ++m)
-        ;
-      auto f = f2.node_;
-      auto l = m.node_->prev;
-      if (l1 == f2)
-        l1 = m;
-      f2 = m;
-      unlink_nodes(f, l);
-      m = f1;
-      ++m;
-      link_nodes(f1.node_, f, l);
-      f1 = m;
+      auto value = buf[i];
+      size_type j = i;
+      for (; j > first && node_comp(value, buf[j - 1]); --j)
+        buf[j] = buf[j - 1];
+      buf[j] = value;
     }
-    else
+  }
+
+  // 再逐轮两两合并相邻的有序段
+  for (size_type width = run; width < n; width <<= 1)
+  {
+    for (size_type first = 0; first < n; first += width << 1)
     {
-      ++f1;
+      const size_type mid = mystl::min(first + width, n);
+      const size_type last = mystl::min(first + (width << 1), n);
+      mystl::merge(buf.begin() + first, buf.begin() + mid,
+                   buf.begin() + mid, buf.begin() + last,
+                   tmp.begin() + first, node_comp);
     }
+    buf.swap(tmp);
+  }
+
+  base_ptr prev = node_;
+  for (size_type i = 0; i < n; ++i)
+  {
+    base_ptr cur = buf[i]->as_base();
+    prev->next = cur;
+    cur->prev = prev;
+    prev = cur;
   }
-  return result;
+  prev->next = node_;
+  node_->prev = prev;
 }
 
 // 重载比较操作符
@@ -63,6 +63,8 @@ public:
   typedef typename base_type::size_type              size_type;
   typedef typename base_type::difference_type        difference_type;
   typedef typename base_type::allocator_type         allocator_type;
+  typedef typename base_type::node_handle_type       node_handle_type;
+  typedef typename base_type::insert_return_type     insert_return_type;
 
 public:
   // 构造、复制、移动、赋值函数
@@ -167,19 +169,11 @@ public:
 
   mapped_type& operator[](const key_type& key)
   {
-    iterator it = lower_bound(key);
-    // it->first >= key
-    if (it == end() || key_comp()(key, it->first))
-      it = emplace_hint(it, key, T{});
-    return it->second;
+    return tree_.try_emplace_unique(key).first->second;
   }
   mapped_type& operator[](key_type&& key)
   {
-    iterator it = lower_bound(key);
-    // it->first >= key
-    if (it == end() || key_comp()(key, it->first))
-      it = emplace_hint(it, mystl::move(key), T{});
-    return it->second;
+    return tree_.try_emplace_unique(mystl::move(key)).first->second;
   }
 
   // 插入删除相关
@@ -196,6 +190,30 @@ public:
     return tree_.emplace_unique_use_hint(hint, mystl::forward<Args>(args)...);
   }
 
+  // 键值不存在时才构造新元素，键值已存在时不会分配内存，args 也不会被移动
+  template <class ...Args>
+  pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+  {
+    return tree_.try_emplace_unique(key, mystl::forward<Args>(args)...);
+  }
+  template <class ...Args>
+  pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+  {
+    return tree_.try_emplace_unique(mystl::move(key), mystl::forward<Args>(args)...);
+  }
+
+  // 键值存在时把 obj 赋给对应的值，否则插入新元素
+  template <class M>
+  pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+  {
+    return tree_.insert_or_assign_unique(key, mystl::forward<M>(obj));
+  }
+  template <class M>
+  pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+  {
+    return tree_.insert_or_assign_unique(mystl::move(key), mystl::forward<M>(obj));
+  }
+
   pair<iterator, bool> insert(const value_type& value)
   {
     return tree_.insert_unique(value);
@@ -226,6 +244,13 @@ public:
 
   void      clear()                              { tree_.clear(); }
 
+  // 节点句柄相关操作，节点在容器之间转移时不会重新分配内存或复制元素
+  node_handle_type   extract(iterator position)    { return tree_.extract(position); }
+  node_handle_type   extract(const key_type& key)  { return tree_.extract(key); }
+  insert_return_type insert(node_handle_type&& nh) { return tree_.insert_unique(mystl::move(nh)); }
+  void               merge(map& source)            { tree_.merge_unique(source.tree_); }
+  void               merge(map&& source)           { tree_.merge_unique(source.tree_); }
+
   // map 相关操作
 
   iterator       find(const key_type& key)              { return tree_.find(key); }
@@ -247,6 +272,50 @@ public:
     equal_range(const key_type& key) const 
   { return tree_.equal_range_unique(key); }
 
+  // 比较函数定义了 is_transparent 时，可以直接用能与 key_type 比较的类型查找
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       find(const K& key)                     { return tree_.find(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const K& key)               const { return tree_.find(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  size_type      count(const K& key)              const { return tree_.count_unique(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       lower_bound(const K& key)              { return tree_.lower_bound(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator lower_bound(const K& key)        const { return tree_.lower_bound(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       upper_bound(const K& key)              { return tree_.upper_bound(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator upper_bound(const K& key)        const { return tree_.upper_bound(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  pair<iterator, iterator>
+    equal_range(const K& key)
+  { return tree_.equal_range_unique(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  pair<const_iterator, const_iterator>
+    equal_range(const K& key) const
+  { return tree_.equal_range_unique(key); }
+
+  // 顺序统计，默认需要中序遍历，为 O(n)；定义 RB_TREE_ORDER_STATISTIC 为 1 时为 O(log n)
+  iterator       nth(size_type k)                     { return tree_.nth(k); }
+  const_iterator nth(size_type k)               const { return tree_.nth(k); }
+  size_type      rank(const key_type& key)      const { return tree_.rank(key); }
+
+  // 整树操作，rhs 的元素会被移入或销毁，操作完成后 rhs 为空
+  // split 把键值不小于 key 的元素移到 rhs 中，join 要求 rhs 的键值都不小于本容器的键值
+  void           split(const key_type& key, map& rhs) { tree_.split(key, rhs.tree_); }
+  void           join(map& rhs)                       { tree_.join(rhs.tree_); }
+
+  // 集合操作，键值相同时保留本容器中的元素
+  void           union_with(map& rhs)                 { tree_.union_unique(rhs.tree_); }
+  void           intersection_with(map& rhs)          { tree_.intersection_unique(rhs.tree_); }
+  void           difference_with(map& rhs)            { tree_.difference_unique(rhs.tree_); }
+
   void           swap(map& rhs) noexcept
   { tree_.swap(rhs.tree_); }
 
@@ -346,6 +415,7 @@ public:
   typedef typename base_type::size_type              size_type;
   typedef typename base_type::difference_type        difference_type;
   typedef typename base_type::allocator_type         allocator_type;
+  typedef typename base_type::node_handle_type       node_handle_type;
 
 public:
   // 构造、复制、移动函数
@@ -471,6 +541,13 @@ public:
 
   void           clear() { tree_.clear(); }
 
+  // 节点句柄相关操作，节点在容器之间转移时不会重新分配内存或复制元素
+  node_handle_type   extract(iterator position)    { return tree_.extract(position); }
+  node_handle_type   extract(const key_type& key)  { return tree_.extract(key); }
+  iterator           insert(node_handle_type&& nh) { return tree_.insert_multi(mystl::move(nh)); }
+  void               merge(multimap& source)       { tree_.merge_multi(source.tree_); }
+  void               merge(multimap&& source)      { tree_.merge_multi(source.tree_); }
+
   // multimap 相关操作
 
   iterator       find(const key_type& key)              { return tree_.find(key); }
@@ -492,6 +569,45 @@ public:
     equal_range(const key_type& key) const 
   { return tree_.equal_range_multi(key); }
 
+  // 比较函数定义了 is_transparent 时，可以直接用能与 key_type 比较的类型查找
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       find(const K& key)                     { return tree_.find(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const K& key)               const { return tree_.find(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  size_type      count(const K& key)              const { return tree_.count_multi(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       lower_bound(const K& key)              { return tree_.lower_bound(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator lower_bound(const K& key)        const { return tree_.lower_bound(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       upper_bound(const K& key)              { return tree_.upper_bound(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator upper_bound(const K& key)        const { return tree_.upper_bound(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  pair<iterator, iterator>
+    equal_range(const K& key)
+  { return tree_.equal_range_multi(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  pair<const_iterator, const_iterator>
+    equal_range(const K& key) const
+  { return tree_.equal_range_multi(key); }
+
+  // 顺序统计，默认需要中序遍历，为 O(n)；定义 RB_TREE_ORDER_STATISTIC 为 1 时为 O(log n)
+  iterator       nth(size_type k)                     { return tree_.nth(k); }
+  const_iterator nth(size_type k)               const { return tree_.nth(k); }
+  size_type      rank(const key_type& key)      const { return tree_.rank(key); }
+
+  // 整树操作，rhs 的元素会被移入或销毁，操作完成后 rhs 为空
+  // split 把键值不小于 key 的元素移到 rhs 中，join 要求 rhs 的键值都不小于本容器的键值
+  void           split(const key_type& key, multimap& rhs) { tree_.split(key, rhs.tree_); }
+  void           join(multimap& rhs)                       { tree_.join(rhs.tree_); }
+
   void swap(multimap& rhs) noexcept
   { tree_.swap(rhs.tree_); }
 
@@ -101,6 +101,7 @@ private:
 template <class ForwardIterator, class T>
 temporary_buffer<ForwardIterator, T>::
 temporary_buffer(ForwardIterator first, ForwardIterator last)
+  :original_len(0), len(0), buffer(nullptr)
 {
   try
   {
@@ -0,0 +1,139 @@
+#ifndef MYTINYSTL_NODE_HANDLE_H_
+#define MYTINYSTL_NODE_HANDLE_H_
+
+// 这个头文件包含两个模板类 node_handle 和 node_insert_return
+// node_handle        : 节点句柄，持有一个从关联式容器中摘下的节点
+// node_insert_return : 把节点句柄插入到键值不允许重复的容器时的返回值
+
+// notes:
+//
+// extract 把节点从容器中摘下并交给 node_handle，节点与其中的值都不会被复制或移动，
+// 之后可以用 insert(node_handle&&) 把节点重新接到同类型的容器中。
+// 容器的节点分配器都是无状态的，因此节点可以在容器之间转移；
+// node_handle 析构时若仍持有节点，则由它销毁节点。
+// 本库中 node_type 已经用来表示容器内部的节点类型，所以容器中句柄的型别名为 node_handle_type
+
+#include "memory.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl
+{
+
+template <class T, class Compare> class rb_tree;
+template <class T, class Hash, class KeyEqual> class hashtable;
+
+// 模板类 node_handle
+// 参数一代表节点类型，参数二代表容器的 value_traits，参数三代表节点的分配器
+template <class Node, class ValueTraits, class NodeAllocator>
+class node_handle
+{
+  template <class T, class Compare> friend class rb_tree;
+  template <class T, class Hash, class KeyEqual> friend class hashtable;
+
+public:
+  typedef typename ValueTraits::key_type    key_type;
+  typedef typename ValueTraits::mapped_type mapped_type;
+  typedef typename ValueTraits::value_type  value_type;
+  typedef mystl::allocator<value_type>      allocator_type;
+
+private:
+  Node* node_;  // 持有的节点，为空时表示空句柄
+
+  explicit node_handle(Node* node) noexcept :node_(node) {}
+
+public:
+  // 构造、移动、析构函数
+  constexpr node_handle() noexcept :node_(nullptr) {}
+
+  node_handle(node_handle&& rhs) noexcept :node_(rhs.node_)
+  {
+    rhs.node_ = nullptr;
+  }
+
+  node_handle& operator=(node_handle&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      reset();
+      node_ = rhs.node_;
+      rhs.node_ = nullptr;
+    }
+    return *this;
+  }
+
+  node_handle(const node_handle&) = delete;
+  node_handle& operator=(const node_handle&) = delete;
+
+  ~node_handle() { reset(); }
+
+  // 访问元素
+  // key 与 mapped 只用于 map 类的容器，value 只用于 set 类的容器
+  value_type&  value()  const
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    return node_->value;
+  }
+  key_type&    key()    const
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    return const_cast<key_type&>(ValueTraits::get_key(node_->value));
+  }
+  mapped_type& mapped() const
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    return node_->value.second;
+  }
+
+  allocator_type get_allocator() const { return allocator_type(); }
+
+  bool empty() const noexcept { return node_ == nullptr; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+
+  void swap(node_handle& rhs) noexcept
+  {
+    mystl::swap(node_, rhs.node_);
+  }
+
+private:
+  // 交出节点的所有权，由容器调用
+  Node* release() noexcept
+  {
+    Node* p = node_;
+    node_ = nullptr;
+    return p;
+  }
+
+  // 销毁持有的节点
+  void reset() noexcept
+  {
+    if (node_ != nullptr)
+    {
+      mystl::destroy(mystl::address_of(node_->value));
+      NodeAllocator::deallocate(node_);
+      node_ = nullptr;
+    }
+  }
+};
+
+// 重载 mystl 的 swap
+template <class Node, class ValueTraits, class NodeAllocator>
+void swap(node_handle<Node, ValueTraits, NodeAllocator>& lhs,
+          node_handle<Node, ValueTraits, NodeAllocator>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+// 模板类 node_insert_return
+// inserted 为 false 时，node 中保存着没有插入的节点，position 指向容器中键值相同的元素
+template <class Iterator, class NodeHandle>
+struct node_insert_return
+{
+  Iterator   position;
+  bool       inserted;
+  NodeHandle node;
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_NODE_HANDLE_H_
+
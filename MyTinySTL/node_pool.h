@@ -0,0 +1,307 @@
+#ifndef MYTINYSTL_NODE_POOL_H_
+#define MYTINYSTL_NODE_POOL_H_
+
+// 这个头文件包含一个模板类 node_pool
+// node_pool : 节点内存池，供链式容器按块分配节点
+
+// notes:
+//
+// 每个线程、每种节点类型各有一个池，节点所需的内存按块向 ::operator new 申请。
+// 内存块按块的大小对齐，块首存放块头，由节点的地址就能找到它所在的块以及块所属的线程：
+// 1. 在所属线程中释放的节点放回该线程的空闲链表，不加锁
+// 2. 在其他线程中释放的节点加锁后挂到所属线程的远程链表上，所属线程的空闲链表用完时再把它们收回，
+//    所以生产者 / 消费者式的使用、把容器或节点移到其他线程都不会使内存无限增长
+// 3. 线程结束时，没有节点在使用的块归还给系统，仍有节点在使用的块成为无主块，
+//    其中最后一个节点被释放时归还
+// 块的对齐不小于节点的对齐，alignof(Node) 大于 __STDCPP_DEFAULT_NEW_ALIGNMENT__ 的节点也可以使用
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <atomic>
+
+namespace mystl
+{
+
+// 每次向系统申请的内存块大小，需要是 2 的幂，节点较大时会自动加倍
+#ifndef NODE_POOL_CHUNK_BYTES
+#define NODE_POOL_CHUNK_BYTES 4096
+#endif
+
+static_assert((NODE_POOL_CHUNK_BYTES & (NODE_POOL_CHUNK_BYTES - 1)) == 0,
+              "NODE_POOL_CHUNK_BYTES must be a power of two");
+
+// 保护远程链表与无主块的锁，所有节点类型共用
+// 线程结束与程序退出时仍可能用到，所以不析构
+inline std::mutex& node_pool_mutex()
+{
+  static std::mutex* m = new std::mutex;
+  return *m;
+}
+
+// 模板类: node_pool
+// 模板参数 Node 代表节点类型，接口与 allocator 的 allocate / deallocate 一致
+template <class Node>
+class node_pool
+{
+public:
+  typedef Node         value_type;
+  typedef Node*        pointer;
+  typedef size_t       size_type;
+
+private:
+  // 空闲时存放链表指针，使用时存放节点
+  union slot
+  {
+    slot* next;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  struct pool_state;
+
+  // 块头，位于每个内存块的起始处
+  struct chunk_header
+  {
+    std::atomic<pool_state*> owner;  // 所属线程的池，线程结束后为空
+    chunk_header*            next;   // 所属线程的块链表
+    size_type                live;   // 成为无主块后仍在使用的节点数，受锁保护
+  };
+
+  // 线程内的池，平凡析构，线程结束时由 pool_guard 归还内存
+  struct pool_state
+  {
+    slot*         free_list    = nullptr;
+    slot*         remote_list  = nullptr;  // 其他线程释放的节点，受锁保护
+    chunk_header* chunk_list   = nullptr;
+    size_type     free_count   = 0;
+    size_type     remote_count = 0;        // 受锁保护
+    size_type     chunk_count  = 0;
+    bool          registered   = false;
+    bool          exited       = false;
+  };
+
+  struct pool_guard
+  {
+    ~pool_guard() { release(state()); }
+  };
+
+  static constexpr size_type header_size =
+    (sizeof(chunk_header) + alignof(slot) - 1) / alignof(slot) * alignof(slot);
+
+  // 块的大小至少能放下 8 个节点
+  static constexpr size_type round_chunk_bytes(size_type need)
+  {
+    size_type n = NODE_POOL_CHUNK_BYTES;
+    while (n < need)
+      n <<= 1;
+    return n;
+  }
+
+  static constexpr size_type chunk_bytes = round_chunk_bytes(header_size + 8 * sizeof(slot));
+  static constexpr size_type chunk_size = (chunk_bytes - header_size) / sizeof(slot);
+
+public:
+  static Node*     allocate();
+  static void      deallocate(Node* ptr) noexcept;
+
+  // 保证当前线程的空闲链表中至少有 n 个节点
+  static void      reserve(size_type n);
+  static size_type free_count() noexcept { return state().free_count; }
+  // 当前线程持有的内存块个数
+  static size_type chunk_count() noexcept { return state().chunk_count; }
+
+private:
+  static pool_state& state() noexcept
+  {
+    static thread_local pool_state s;
+    return s;
+  }
+
+  static chunk_header* chunk_of(void* p) noexcept
+  {
+    return reinterpret_cast<chunk_header*>(
+      reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(chunk_bytes - 1));
+  }
+
+  static slot* first_slot(chunk_header* c) noexcept
+  {
+    return reinterpret_cast<slot*>(reinterpret_cast<unsigned char*>(c) + header_size);
+  }
+
+  static chunk_header* new_chunk(pool_state* owner);
+  static void          delete_chunk(chunk_header* c) noexcept;
+  static void          add_chunk(pool_state& s);
+  static void          take_remote(pool_state& s);
+  static Node*         allocate_orphan();
+  static void          deallocate_remote(chunk_header* c, slot* p) noexcept;
+  static void          release(pool_state& s) noexcept;
+};
+
+/*****************************************************************************************/
+
+template <class Node>
+Node* node_pool<Node>::allocate()
+{
+  auto& s = state();
+  if (s.free_list == nullptr)
+  {
+    if (s.exited)
+      return allocate_orphan();
+    take_remote(s);
+    if (s.free_list == nullptr)
+      add_chunk(s);
+  }
+  slot* p = s.free_list;
+  s.free_list = p->next;
+  --s.free_count;
+  return reinterpret_cast<Node*>(p);
+}
+
+template <class Node>
+void node_pool<Node>::deallocate(Node* ptr) noexcept
+{
+  if (ptr == nullptr)
+    return;
+  auto& s = state();
+  auto c = chunk_of(ptr);
+  slot* p = ::new (static_cast<void*>(ptr)) slot;
+  // 只有所属线程会看到 owner 等于自己的池，这个比较不需要加锁
+  if (c->owner.load(std::memory_order_relaxed) == &s)
+  {
+    p->next = s.free_list;
+    s.free_list = p;
+    ++s.free_count;
+    return;
+  }
+  deallocate_remote(c, p);
+}
+
+template <class Node>
+void node_pool<Node>::reserve(size_type n)
+{
+  auto& s = state();
+  if (s.free_count < n)
+    take_remote(s);
+  while (s.free_count < n)
+    add_chunk(s);
+}
+
+// 申请一个块，所有节点都在块内，owner 为空时是无主块
+template <class Node>
+typename node_pool<Node>::chunk_header*
+node_pool<Node>::new_chunk(pool_state* owner)
+{
+  void* mem = ::operator new(chunk_bytes, std::align_val_t(chunk_bytes));
+  auto c = ::new (mem) chunk_header;
+  c->owner.store(owner, std::memory_order_relaxed);
+  c->next = nullptr;
+  c->live = 0;
+  return c;
+}
+
+template <class Node>
+void node_pool<Node>::delete_chunk(chunk_header* c) noexcept
+{
+  c->~chunk_header();
+  ::operator delete(static_cast<void*>(c), std::align_val_t(chunk_bytes));
+}
+
+// 为当前线程申请一个块，第一次申请时登记线程结束时的清理
+template <class Node>
+void node_pool<Node>::add_chunk(pool_state& s)
+{
+  if (!s.registered)
+  {
+    static thread_local pool_guard guard;
+    (void)guard;
+    s.registered = true;
+  }
+  auto c = new_chunk(&s);
+  c->next = s.chunk_list;
+  s.chunk_list = c;
+  ++s.chunk_count;
+  // 从后往前挂到空闲链表，使得分配顺序与地址顺序一致
+  slot* first = first_slot(c);
+  for (slot* p = first + chunk_size; p != first; )
+  {
+    --p;
+    p->next = s.free_list;
+    s.free_list = p;
+  }
+  s.free_count += chunk_size;
+}
+
+// 把其他线程释放的节点收回到空闲链表
+template <class Node>
+void node_pool<Node>::take_remote(pool_state& s)
+{
+  std::lock_guard<std::mutex> lock(node_pool_mutex());
+  while (s.remote_list != nullptr)
+  {
+    slot* p = s.remote_list;
+    s.remote_list = p->next;
+    p->next = s.free_list;
+    s.free_list = p;
+  }
+  s.free_count += s.remote_count;
+  s.remote_count = 0;
+}
+
+// 线程的池已经清理（例如线程结束后的析构中）仍要分配时，单独申请一个无主块
+template <class Node>
+Node* node_pool<Node>::allocate_orphan()
+{
+  auto c = new_chunk(nullptr);
+  c->live = 1;
+  return reinterpret_cast<Node*>(first_slot(c));
+}
+
+// 释放不属于当前线程的节点：所属线程还在时挂到它的远程链表上，否则减少无主块的计数
+template <class Node>
+void node_pool<Node>::deallocate_remote(chunk_header* c, slot* p) noexcept
+{
+  std::lock_guard<std::mutex> lock(node_pool_mutex());
+  auto owner = c->owner.load(std::memory_order_relaxed);
+  if (owner != nullptr)
+  {
+    p->next = owner->remote_list;
+    owner->remote_list = p;
+    ++owner->remote_count;
+    return;
+  }
+  if (--c->live == 0)
+    delete_chunk(c);
+}
+
+// 线程结束时调用：归还没有节点在使用的块，其余的块成为无主块
+template <class Node>
+void node_pool<Node>::release(pool_state& s) noexcept
+{
+  std::lock_guard<std::mutex> lock(node_pool_mutex());
+  for (auto c = s.chunk_list; c != nullptr; c = c->next)
+    c->live = chunk_size;
+  for (auto p = s.free_list; p != nullptr; p = p->next)
+    --chunk_of(p)->live;
+  for (auto p = s.remote_list; p != nullptr; p = p->next)
+    --chunk_of(p)->live;
+  for (auto c = s.chunk_list; c != nullptr; )
+  {
+    auto next = c->next;
+    if (c->live == 0)
+      delete_chunk(c);
+    else
+      c->owner.store(nullptr, std::memory_order_relaxed);
+    c = next;
+  }
+  s.free_list = nullptr;
+  s.remote_list = nullptr;
+  s.chunk_list = nullptr;
+  s.free_count = 0;
+  s.remote_count = 0;
+  s.chunk_count = 0;
+  s.exited = true;
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_NODE_POOL_H_
@@ -0,0 +1,822 @@
+#ifndef MYTINYSTL_PERSISTENT_MAP_H_
+#define MYTINYSTL_PERSISTENT_MAP_H_
+
+// 这个头文件包含一个模板类 persistent_map
+// persistent_map : 持久化（不可变）映射，修改操作返回新版本，旧版本保持不变，键值不允许重复
+
+// notes:
+//
+// persistent_map 底层为红黑树，节点带有引用计数且创建后不再修改
+// insert / insert_or_assign / erase 只复制从根节点到修改位置的一条路径（path copying），
+// 其余子树由新旧版本共享，因此每次修改为 O(log n) 的时间与空间，复制一个版本为 O(1)
+//
+// rb_tree 的节点带有父指针，无法在多个版本之间共享，所以这里的节点只有左右孩子，
+// 平衡操作采用自底向上返回新子树的函数式写法：插入沿用 Okasaki 的 balance，删除采用 Kahrs 的算法，
+// 颜色与 rb_tree 一致，仍满足红黑树的性质
+//
+// 节点与 rb_tree 一样由 RB_TREE_USE_NODE_POOL 决定是否从 node_pool 中分配
+// 节点的引用计数是原子的，同一个版本可以被多个线程同时读取、复制和析构，
+// 适合让读线程持有某一时刻的快照，而写线程继续生成新版本
+// 迭代器内保存从根到当前节点的路径，只要还有 persistent_map 持有该版本，迭代器就保持有效
+//
+// 异常保证：
+// 修改操作不改变原有版本，因此所有操作都满足强异常安全保证
+
+#include <atomic>
+#include <initializer_list>
+
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "exceptdef.h"
+#include "map.h"
+
+namespace mystl
+{
+
+// 迭代器中路径的最大长度，红黑树的高度不超过 2log(n + 1)，默认值支持 2^32 - 1 个元素
+#ifndef PERSISTENT_MAP_MAX_HEIGHT
+#define PERSISTENT_MAP_MAX_HEIGHT 64
+#endif
+
+// persistent_map 的节点，创建后 value、孩子与颜色都不再改变
+template <class T>
+struct persistent_map_node
+{
+  typedef persistent_map_node<T>* node_ptr;
+
+  T                   value;
+  node_ptr            left;
+  node_ptr            right;
+  std::atomic<size_t> refs;   // 引用计数，来自父节点或 persistent_map 的根
+  rb_tree_color_type  color;
+};
+
+// persistent_map 的迭代器，所有元素都是只读的
+template <class T>
+struct persistent_map_iterator :public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+  typedef T                           value_type;
+  typedef const T*                    pointer;
+  typedef const T&                    reference;
+  typedef persistent_map_node<T>*     node_ptr;
+  typedef persistent_map_iterator<T>  self;
+
+  node_ptr root;                               // 所属版本的根节点
+  node_ptr path[PERSISTENT_MAP_MAX_HEIGHT];    // 从根到当前节点的路径
+  int      depth;                              // 路径长度，为 0 时表示 end
+
+  // 构造、复制函数
+  persistent_map_iterator() :root(nullptr), depth(0) {}
+  explicit persistent_map_iterator(node_ptr r) :root(r), depth(0) {}
+
+  persistent_map_iterator(const persistent_map_iterator& rhs)
+    :root(rhs.root), depth(rhs.depth)
+  {
+    for (int i = 0; i < depth; ++i)
+      path[i] = rhs.path[i];
+  }
+
+  persistent_map_iterator& operator=(const persistent_map_iterator& rhs)
+  {
+    root = rhs.root;
+    depth = rhs.depth;
+    for (int i = 0; i < depth; ++i)
+      path[i] = rhs.path[i];
+    return *this;
+  }
+
+  node_ptr node() const { return depth == 0 ? nullptr : path[depth - 1]; }
+
+  // 从 x 出发沿左孩子（或右孩子）一直走到底
+  void push_leftmost(node_ptr x)
+  {
+    for (; x != nullptr; x = x->left)
+    {
+      MYSTL_DEBUG(depth < PERSISTENT_MAP_MAX_HEIGHT);
+      path[depth++] = x;
+    }
+  }
+  void push_rightmost(node_ptr x)
+  {
+    for (; x != nullptr; x = x->right)
+    {
+      MYSTL_DEBUG(depth < PERSISTENT_MAP_MAX_HEIGHT);
+      path[depth++] = x;
+    }
+  }
+
+  // 重载操作符
+  reference operator*()  const { return node()->value; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    MYSTL_DEBUG(depth > 0);
+    node_ptr x = path[depth - 1];
+    if (x->right != nullptr)
+    {
+      push_leftmost(x->right);
+    }
+    else
+    { // 回溯到第一个从左子树上来的祖先，没有时到达 end
+      while (depth > 1 && path[depth - 2]->right == path[depth - 1])
+        --depth;
+      --depth;
+    }
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  self& operator--()
+  {
+    if (depth == 0)
+    { // end 的前一个位置为最大的元素
+      push_rightmost(root);
+      return *this;
+    }
+    node_ptr x = path[depth - 1];
+    if (x->left != nullptr)
+    {
+      push_rightmost(x->left);
+    }
+    else
+    {
+      while (depth > 1 && path[depth - 2]->left == path[depth - 1])
+        --depth;
+      --depth;
+    }
+    return *this;
+  }
+  self operator--(int)
+  {
+    self tmp(*this);
+    --*this;
+    return tmp;
+  }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return node() == rhs.node(); }
+  bool operator!=(const self& rhs) const { return node() != rhs.node(); }
+};
+
+// 模板类 persistent_map，键值不允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl::less
+template <class Key, class T, class Compare = mystl::less<Key>>
+class persistent_map
+{
+public:
+  // persistent_map 的型别定义
+  typedef Key                        key_type;
+  typedef T                          mapped_type;
+  typedef mystl::pair<const Key, T>  value_type;
+  typedef Compare                    key_compare;
+
+  typedef const value_type*                           pointer;
+  typedef const value_type*                           const_pointer;
+  typedef const value_type&                           reference;
+  typedef const value_type&                           const_reference;
+  typedef persistent_map_iterator<value_type>         iterator;
+  typedef persistent_map_iterator<value_type>         const_iterator;
+  typedef mystl::reverse_iterator<iterator>           reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>     const_reverse_iterator;
+  typedef size_t                                      size_type;
+  typedef ptrdiff_t                                   difference_type;
+  typedef mystl::allocator<value_type>                allocator_type;
+
+private:
+  typedef persistent_map_node<value_type>    node_type;
+  typedef node_type*                         node_ptr;
+#if RB_TREE_USE_NODE_POOL
+  typedef mystl::node_pool<node_type>        node_allocator;
+#else
+  typedef mystl::allocator<node_type>        node_allocator;
+#endif
+
+  // 持有一个节点引用的句柄，复制时增加引用计数，析构时减少引用计数
+  class node_ref
+  {
+  public:
+    node_ref() noexcept :p_(nullptr) {}
+    explicit node_ref(node_ptr p) noexcept :p_(p) {}  // 接管一个已计数的引用
+    node_ref(const node_ref& rhs) noexcept :p_(acquire(rhs.p_)) {}
+    node_ref(node_ref&& rhs) noexcept :p_(rhs.p_) { rhs.p_ = nullptr; }
+    ~node_ref() { release(p_); }
+
+    node_ref& operator=(node_ref rhs) noexcept
+    {
+      mystl::swap(p_, rhs.p_);
+      return *this;
+    }
+
+    node_ptr get()        const noexcept { return p_; }
+    node_ptr operator->() const noexcept { return p_; }
+
+    // 交出引用
+    node_ptr detach() noexcept
+    {
+      node_ptr p = p_;
+      p_ = nullptr;
+      return p;
+    }
+
+  private:
+    node_ptr p_;
+  };
+
+private:
+  node_ref    root_;
+  size_type   size_;
+  key_compare comp_;
+
+  persistent_map(node_ref root, size_type n, const key_compare& comp)
+    :root_(mystl::move(root)), size_(n), comp_(comp)
+  {
+  }
+
+public:
+  // 构造、复制、移动函数，复制只增加根节点的引用计数
+  persistent_map() :root_(), size_(0), comp_() {}
+
+  template <class InputIterator>
+  persistent_map(InputIterator first, InputIterator last)
+    :root_(), size_(0), comp_()
+  {
+    build(first, last);
+  }
+
+  persistent_map(std::initializer_list<value_type> ilist)
+    :root_(), size_(0), comp_()
+  {
+    build(ilist.begin(), ilist.end());
+  }
+
+  persistent_map(const persistent_map& rhs)
+    :root_(rhs.root_), size_(rhs.size_), comp_(rhs.comp_)
+  {
+  }
+  persistent_map(persistent_map&& rhs) noexcept
+    :root_(mystl::move(rhs.root_)), size_(rhs.size_), comp_(rhs.comp_)
+  {
+    rhs.size_ = 0;
+  }
+
+  persistent_map& operator=(const persistent_map& rhs)
+  {
+    root_ = rhs.root_;
+    size_ = rhs.size_;
+    comp_ = rhs.comp_;
+    return *this;
+  }
+  persistent_map& operator=(persistent_map&& rhs) noexcept
+  {
+    root_ = mystl::move(rhs.root_);
+    size_ = rhs.size_;
+    comp_ = rhs.comp_;
+    rhs.size_ = 0;
+    return *this;
+  }
+
+public:
+  // 相关接口
+  key_compare    key_comp()      const { return comp_; }
+  allocator_type get_allocator() const { return allocator_type(); }
+
+  // 迭代器相关
+  const_iterator begin() const noexcept
+  {
+    const_iterator it(root_.get());
+    it.push_leftmost(root_.get());
+    return it;
+  }
+  const_iterator end()   const noexcept
+  { return const_iterator(root_.get()); }
+
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return size_ == 0; }
+  size_type size()     const noexcept { return size_; }
+  size_type max_size() const noexcept
+  { return (static_cast<size_type>(1) << (PERSISTENT_MAP_MAX_HEIGHT / 2)) - 1; }
+
+  // 修改操作，返回修改后的新版本，*this 保持不变
+
+  // 键值已存在时返回与 *this 相同的版本
+  persistent_map insert(const value_type& value) const;
+
+  // 键值已存在时替换它的实值
+  persistent_map insert_or_assign(const key_type& key, const mapped_type& obj) const;
+
+  // 键值不存在时返回与 *this 相同的版本
+  persistent_map erase(const key_type& key) const;
+
+  // 访问元素
+  const mapped_type& at(const key_type& key) const
+  {
+    node_ptr x = find_node(key);
+    THROW_OUT_OF_RANGE_IF(x == nullptr, "persistent_map<Key, T> no such element exists");
+    return x->value.second;
+  }
+
+  // persistent_map 相关操作
+
+  const_iterator find(const key_type& key) const
+  {
+    const_iterator it = lower_bound(key);
+    return (it == end() || comp_(key, it->first)) ? end() : it;
+  }
+
+  size_type      count(const key_type& key)    const
+  { return find_node(key) != nullptr ? 1 : 0; }
+  bool           contains(const key_type& key) const
+  { return find_node(key) != nullptr; }
+
+  const_iterator lower_bound(const key_type& key) const
+  { return bound(key, false); }
+  const_iterator upper_bound(const key_type& key) const
+  { return bound(key, true); }
+
+  pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const
+  { return mystl::make_pair(lower_bound(key), upper_bound(key)); }
+
+  // 两个版本是否共享同一棵树，为 true 时两者的内容一定相同
+  bool shares_root_with(const persistent_map& rhs) const noexcept
+  { return root_.get() == rhs.root_.get(); }
+
+  void swap(persistent_map& rhs) noexcept
+  {
+    mystl::swap(root_, rhs.root_);
+    mystl::swap(size_, rhs.size_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+
+private:
+  // helper functions
+
+  // node
+  static node_ptr acquire(node_ptr p) noexcept;
+  static void     release(node_ptr p) noexcept;
+  static node_ref share(node_ptr p) noexcept { return node_ref(acquire(p)); }
+  static node_ref make_node(rb_tree_color_type color, node_ref left,
+                            const value_type& value, node_ref right);
+  static node_ref recolor(node_ref x, rb_tree_color_type color);
+
+  static bool is_red(node_ptr p)   noexcept { return p != nullptr && p->color == rb_tree_red; }
+  static bool is_black(node_ptr p) noexcept { return p != nullptr && p->color == rb_tree_black; }
+
+  // search
+  node_ptr       find_node(const key_type& key) const;
+  const_iterator bound(const key_type& key, bool upper) const;
+
+  // balance
+  static node_ref balance(node_ref a, const value_type& value, node_ref b);
+  static node_ref balance_left(node_ref a, const value_type& value, node_ref b);
+  static node_ref balance_right(node_ref a, const value_type& value, node_ref b);
+
+  // insert / erase
+  node_ref insert_node(node_ptr x, const value_type& value) const;
+  node_ref assign_node(node_ptr x, const value_type& value) const;
+  node_ref erase_node(node_ptr x, const key_type& key) const;
+  static node_ref join(node_ptr a, node_ptr b);
+
+  // build
+  template <class InputIterator>
+  void build(InputIterator first, InputIterator last);
+  template <class Iter>
+  static node_ref build_range(Iter& it, size_type n, int depth, int red_depth);
+
+public:
+  friend bool operator==(const persistent_map& lhs, const persistent_map& rhs)
+  {
+    return lhs.size_ == rhs.size_ &&
+      (lhs.shares_root_with(rhs) || mystl::equal(lhs.begin(), lhs.end(), rhs.begin()));
+  }
+  friend bool operator<(const persistent_map& lhs, const persistent_map& rhs)
+  {
+    return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+};
+
+/*****************************************************************************************/
+
+// 插入元素，返回新版本
+template <class Key, class T, class Compare>
+persistent_map<Key, T, Compare>
+persistent_map<Key, T, Compare>::
+insert(const value_type& value) const
+{
+  if (find_node(value.first) != nullptr)
+    return *this;
+  return persistent_map(recolor(insert_node(root_.get(), value), rb_tree_black),
+                        size_ + 1, comp_);
+}
+
+// 插入元素，键值已存在时替换实值，返回新版本
+template <class Key, class T, class Compare>
+persistent_map<Key, T, Compare>
+persistent_map<Key, T, Compare>::
+insert_or_assign(const key_type& key, const mapped_type& obj) const
+{
+  const value_type value(key, obj);
+  if (find_node(key) != nullptr)
+    return persistent_map(assign_node(root_.get(), value), size_, comp_);
+  return persistent_map(recolor(insert_node(root_.get(), value), rb_tree_black),
+                        size_ + 1, comp_);
+}
+
+// 删除键值为 key 的元素，返回新版本
+template <class Key, class T, class Compare>
+persistent_map<Key, T, Compare>
+persistent_map<Key, T, Compare>::
+erase(const key_type& key) const
+{
+  if (find_node(key) == nullptr)
+    return *this;
+  node_ref root = erase_node(root_.get(), key);
+  if (root.get() != nullptr)
+    root = recolor(mystl::move(root), rb_tree_black);
+  return persistent_map(mystl::move(root), size_ - 1, comp_);
+}
+
+// 增加节点的引用计数
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ptr
+persistent_map<Key, T, Compare>::
+acquire(node_ptr p) noexcept
+{
+  if (p != nullptr)
+    p->refs.fetch_add(1, std::memory_order_relaxed);
+  return p;
+}
+
+// 减少节点的引用计数，减到 0 时销毁节点并释放它对孩子的引用
+template <class Key, class T, class Compare>
+void persistent_map<Key, T, Compare>::
+release(node_ptr p) noexcept
+{
+  while (p != nullptr && p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+  {
+    node_ptr right = p->right;
+    release(p->left);
+    mystl::destroy(mystl::address_of(p->value));
+    node_allocator::deallocate(p);
+    p = right;  // 右孩子用循环处理，减少递归深度
+  }
+}
+
+// 创建节点，接管 left 与 right 的引用
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ref
+persistent_map<Key, T, Compare>::
+make_node(rb_tree_color_type color, node_ref left, const value_type& value, node_ref right)
+{
+#if RB_TREE_USE_NODE_POOL
+  node_ptr p = node_allocator::allocate();
+#else
+  node_ptr p = node_allocator::allocate(1);
+#endif
+  try
+  {
+    mystl::construct(mystl::address_of(p->value), value);
+  }
+  catch (...)
+  {
+    node_allocator::deallocate(p);
+    throw;
+  }
+  p->left = left.detach();
+  p->right = right.detach();
+  ::new (static_cast<void*>(&p->refs)) std::atomic<size_t>(1);
+  p->color = color;
+  return node_ref(p);
+}
+
+// 返回颜色为 color 的 x，颜色不同时复制节点
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ref
+persistent_map<Key, T, Compare>::
+recolor(node_ref x, rb_tree_color_type color)
+{
+  if (x->color == color)
+    return x;
+  return make_node(color, share(x->left), x->value, share(x->right));
+}
+
+// 查找键值为 key 的节点，不存在时返回 nullptr
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ptr
+persistent_map<Key, T, Compare>::
+find_node(const key_type& key) const
+{
+  node_ptr x = root_.get();
+  while (x != nullptr)
+  {
+    if (comp_(key, x->value.first))
+      x = x->left;
+    else if (comp_(x->value.first, key))
+      x = x->right;
+    else
+      return x;
+  }
+  return nullptr;
+}
+
+// 返回第一个不小于 key（upper 为 true 时为大于 key）的位置，迭代器的路径截到该节点为止
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::const_iterator
+persistent_map<Key, T, Compare>::
+bound(const key_type& key, bool upper) const
+{
+  const_iterator it(root_.get());
+  int result = 0;
+  for (node_ptr x = root_.get(); x != nullptr; )
+  {
+    MYSTL_DEBUG(it.depth < PERSISTENT_MAP_MAX_HEIGHT);
+    it.path[it.depth++] = x;
+    if (upper ? comp_(key, x->value.first) : !comp_(x->value.first, key))
+    {
+      result = it.depth;
+      x = x->left;
+    }
+    else
+    {
+      x = x->right;
+    }
+  }
+  it.depth = result;
+  return it;
+}
+
+// balance：a 与 b 的黑高相同，其中一棵的根与它的某个孩子可能同为红色
+// 返回以 value 为中心重新平衡后的子树，出现红红相连时变为红根黑孩子的形状，否则为黑根
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ref
+persistent_map<Key, T, Compare>::
+balance(node_ref a, const value_type& value, node_ref b)
+{
+  if (is_red(a.get()) && is_red(b.get()))
+  {
+    return make_node(rb_tree_red, recolor(mystl::move(a), rb_tree_black), value,
+                     recolor(mystl::move(b), rb_tree_black));
+  }
+  if (is_red(a.get()))
+  {
+    node_ptr al = a->left;
+    node_ptr ar = a->right;
+    if (is_red(al))
+    { // R(R(x, y), z) -> R(B(x), B(z))
+      node_ref left = recolor(share(al), rb_tree_black);
+      node_ref right = make_node(rb_tree_black, share(ar), value, mystl::move(b));
+      return make_node(rb_tree_red, mystl::move(left), a->value, mystl::move(right));
+    }
+    if (is_red(ar))
+    { // R(x, R(y, z)) -> R(B(x), B(z))
+      node_ref left = make_node(rb_tree_black, share(al), a->value, share(ar->left));
+      node_ref right = make_node(rb_tree_black, share(ar->right), value, mystl::move(b));
+      return make_node(rb_tree_red, mystl::move(left), ar->value, mystl::move(right));
+    }
+  }
+  if (is_red(b.get()))
+  {
+    node_ptr bl = b->left;
+    node_ptr br = b->right;
+    if (is_red(br))
+    {
+      node_ref left = make_node(rb_tree_black, mystl::move(a), value, share(bl));
+      node_ref right = recolor(share(br), rb_tree_black);
+      return make_node(rb_tree_red, mystl::move(left), b->value, mystl::move(right));
+    }
+    if (is_red(bl))
+    {
+      node_ref left = make_node(rb_tree_black, mystl::move(a), value, share(bl->left));
+      node_ref right = make_node(rb_tree_black, share(bl->right), b->value, share(br));
+      return make_node(rb_tree_red, mystl::move(left), bl->value, mystl::move(right));
+    }
+  }
+  return make_node(rb_tree_black, mystl::move(a), value, mystl::move(b));
+}
+
+// balance_left：左子树 a 的黑高比右子树 b 少 1，返回黑高与 b 相同的子树
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ref
+persistent_map<Key, T, Compare>::
+balance_left(node_ref a, const value_type& value, node_ref b)
+{
+  if (is_red(a.get()))
+    return make_node(rb_tree_red, recolor(mystl::move(a), rb_tree_black), value, mystl::move(b));
+  if (is_black(b.get()))
+    return balance(mystl::move(a), value, recolor(mystl::move(b), rb_tree_red));
+  // b 为红色，它的左孩子必为黑色节点
+  MYSTL_DEBUG(is_red(b.get()) && is_black(b->left));
+  node_ptr bl = b->left;
+  node_ref left = make_node(rb_tree_black, mystl::move(a), value, share(bl->left));
+  node_ref right = balance(share(bl->right), b->value, recolor(share(b->right), rb_tree_red));
+  return make_node(rb_tree_red, mystl::move(left), bl->value, mystl::move(right));
+}
+
+// balance_right：右子树 b 的黑高比左子树 a 少 1，返回黑高与 a 相同的子树
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ref
+persistent_map<Key, T, Compare>::
+balance_right(node_ref a, const value_type& value, node_ref b)
+{
+  if (is_red(b.get()))
+    return make_node(rb_tree_red, mystl::move(a), value, recolor(mystl::move(b), rb_tree_black));
+  if (is_black(a.get()))
+    return balance(recolor(mystl::move(a), rb_tree_red), value, mystl::move(b));
+  // a 为红色，它的右孩子必为黑色节点
+  MYSTL_DEBUG(is_red(a.get()) && is_black(a->right));
+  node_ptr ar = a->right;
+  node_ref left = balance(recolor(share(a->left), rb_tree_red), a->value, share(ar->left));
+  node_ref right = make_node(rb_tree_black, share(ar->right), value, mystl::move(b));
+  return make_node(rb_tree_red, mystl::move(left), ar->value, mystl::move(right));
+}
+
+// 在以 x 为根的子树中插入 value（键值一定不存在），返回新的子树，根可能与孩子同为红色
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ref
+persistent_map<Key, T, Compare>::
+insert_node(node_ptr x, const value_type& value) const
+{
+  if (x == nullptr)
+    return make_node(rb_tree_red, node_ref(), value, node_ref());
+  if (comp_(value.first, x->value.first))
+  {
+    node_ref left = insert_node(x->left, value);
+    if (x->color == rb_tree_red)
+      return make_node(rb_tree_red, mystl::move(left), x->value, share(x->right));
+    return balance(mystl::move(left), x->value, share(x->right));
+  }
+  node_ref right = insert_node(x->right, value);
+  if (x->color == rb_tree_red)
+    return make_node(rb_tree_red, share(x->left), x->value, mystl::move(right));
+  return balance(share(x->left), x->value, mystl::move(right));
+}
+
+// 复制从 x 到键值等于 value.first 的节点的路径，并把该节点的值替换为 value
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ref
+persistent_map<Key, T, Compare>::
+assign_node(node_ptr x, const value_type& value) const
+{
+  if (comp_(value.first, x->value.first))
+    return make_node(x->color, assign_node(x->left, value), x->value, share(x->right));
+  if (comp_(x->value.first, value.first))
+    return make_node(x->color, share(x->left), x->value, assign_node(x->right, value));
+  return make_node(x->color, share(x->left), value, share(x->right));
+}
+
+// 在以 x 为根的子树中删除 key（键值一定存在），x 为黑色时返回的子树黑高减 1
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ref
+persistent_map<Key, T, Compare>::
+erase_node(node_ptr x, const key_type& key) const
+{
+  if (comp_(key, x->value.first))
+  {
+    node_ref left = erase_node(x->left, key);
+    if (is_black(x->left))
+      return balance_left(mystl::move(left), x->value, share(x->right));
+    return make_node(rb_tree_red, mystl::move(left), x->value, share(x->right));
+  }
+  if (comp_(x->value.first, key))
+  {
+    node_ref right = erase_node(x->right, key);
+    if (is_black(x->right))
+      return balance_right(share(x->left), x->value, mystl::move(right));
+    return make_node(rb_tree_red, share(x->left), x->value, mystl::move(right));
+  }
+  return join(x->left, x->right);
+}
+
+// 把黑高相同的两棵子树 a、b 连接起来，a 中的元素都小于 b 中的元素
+template <class Key, class T, class Compare>
+typename persistent_map<Key, T, Compare>::node_ref
+persistent_map<Key, T, Compare>::
+join(node_ptr a, node_ptr b)
+{
+  if (a == nullptr)
+    return share(b);
+  if (b == nullptr)
+    return share(a);
+  if (is_red(a) && is_red(b))
+  {
+    node_ref mid = join(a->right, b->left);
+    if (is_red(mid.get()))
+    {
+      node_ref left = make_node(rb_tree_red, share(a->left), a->value, share(mid->left));
+      node_ref right = make_node(rb_tree_red, share(mid->right), b->value, share(b->right));
+      return make_node(rb_tree_red, mystl::move(left), mid->value, mystl::move(right));
+    }
+    node_ref right = make_node(rb_tree_red, mystl::move(mid), b->value, share(b->right));
+    return make_node(rb_tree_red, share(a->left), a->value, mystl::move(right));
+  }
+  if (is_black(a) && is_black(b))
+  {
+    node_ref mid = join(a->right, b->left);
+    if (is_red(mid.get()))
+    {
+      node_ref left = make_node(rb_tree_black, share(a->left), a->value, share(mid->left));
+      node_ref right = make_node(rb_tree_black, share(mid->right), b->value, share(b->right));
+      return make_node(rb_tree_red, mystl::move(left), mid->value, mystl::move(right));
+    }
+    node_ref right = make_node(rb_tree_black, mystl::move(mid), b->value, share(b->right));
+    return balance_left(share(a->left), a->value, mystl::move(right));
+  }
+  if (is_red(b))
+    return make_node(rb_tree_red, join(a, b->left), b->value, share(b->right));
+  return make_node(rb_tree_red, share(a->left), a->value, join(a->right, b));
+}
+
+// 用 [first, last) 构建初始版本，键值重复时保留先出现的元素
+// 先借助 map 排序去重，再自底向上一次建成平衡的树，避免逐个插入时反复复制路径
+template <class Key, class T, class Compare>
+template <class InputIterator>
+void persistent_map<Key, T, Compare>::
+build(InputIterator first, InputIterator last)
+{
+  mystl::map<Key, T, Compare> sorted(first, last);
+  const size_type n = sorted.size();
+  if (n == 0)
+    return;
+  // 节点数为 n 的平衡树，最深一层的深度为 floor(log2(n))，这一层的节点染成红色
+  int red_depth = 0;
+  while ((static_cast<size_type>(2) << red_depth) <= n)
+    ++red_depth;
+  auto it = sorted.begin();
+  root_ = recolor(build_range(it, n, 0, red_depth), rb_tree_black);
+  size_ = n;
+}
+
+// 按中序用 it 开始的 n 个元素建成平衡的子树
+template <class Key, class T, class Compare>
+template <class Iter>
+typename persistent_map<Key, T, Compare>::node_ref
+persistent_map<Key, T, Compare>::
+build_range(Iter& it, size_type n, int depth, int red_depth)
+{
+  if (n == 0)
+    return node_ref();
+  const size_type half = (n - 1) / 2;
+  node_ref left = build_range(it, half, depth + 1, red_depth);
+  const value_type& value = *it;
+  ++it;
+  node_ref right = build_range(it, n - 1 - half, depth + 1, red_depth);
+  return make_node(depth == red_depth ? rb_tree_red : rb_tree_black,
+                   mystl::move(left), value, mystl::move(right));
+}
+
+// 重载比较操作符
+template <class Key, class T, class Compare>
+bool operator!=(const persistent_map<Key, T, Compare>& lhs, const persistent_map<Key, T, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>(const persistent_map<Key, T, Compare>& lhs, const persistent_map<Key, T, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Key, class T, class Compare>
+bool operator<=(const persistent_map<Key, T, Compare>& lhs, const persistent_map<Key, T, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>=(const persistent_map<Key, T, Compare>& lhs, const persistent_map<Key, T, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Compare>
+void swap(persistent_map<Key, T, Compare>& lhs, persistent_map<Key, T, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_PERSISTENT_MAP_H_
+
@@ -7,16 +7,41 @@
 #include <initializer_list>
 
 #include <cassert>
+#include <cstdint>
 
 #include "functional.h"
 #include "iterator.h"
 #include "memory.h"
 #include "type_traits.h"
 #include "exceptdef.h"
+#include "node_pool.h"
+#include "node_handle.h"
 
 namespace mystl
 {
 
+// 是否把节点颜色压缩进父节点指针的最低位，节点因此少占 8 字节
+#ifndef RB_TREE_COMPACT_NODE
+#define RB_TREE_COMPACT_NODE 1
+#endif
+
+// rb tree 的节点是否从 node_pool 中按块分配
+#ifndef RB_TREE_USE_NODE_POOL
+#define RB_TREE_USE_NODE_POOL 1
+#endif
+
+// 是否在每个节点中维护子树的节点数，开启后 nth / rank / count_multi 为 O(log n)，否则为 O(n)
+// 开启后每个节点多占 8 字节，插入和删除需要额外更新一条到根节点的路径
+#ifndef RB_TREE_ORDER_STATISTIC
+#define RB_TREE_ORDER_STATISTIC 0
+#endif
+
+// erase 一个区间时，元素个数不超过这个值就逐个删除
+// 逐个删除时每个节点的平衡调整摊还为 O(1)，分割再连接的代价与区间长度无关，但要沿两条到根节点的路径
+// 做 O(log n) 次连接，常数较大。在 1000 到 20 万个元素的 set<int> 上实测，两者在区间长度约 20 到 35
+// 时持平，取 16 使得走逐个删除的区间总是更快，数到这个值的代价也很小
+static constexpr size_t rb_tree_erase_range_threshold = 16;
+
 // rb tree 节点颜色的类型
 
 typedef bool rb_tree_color_type;
@@ -123,10 +148,54 @@ struct rb_tree_node_base
   typedef rb_tree_node_base<T>* base_ptr;
   typedef rb_tree_node<T>*      node_ptr;
 
-  base_ptr   parent;  // 父节点
-  base_ptr   left;    // 左子节点
-  base_ptr   right;   // 右子节点
-  color_type color;   // 节点颜色
+#if RB_TREE_COMPACT_NODE
+  uintptr_t  parent_color;  // 父节点指针，最低位存放节点颜色
+#else
+  base_ptr   parent_;       // 父节点
+  color_type color_;        // 节点颜色
+#endif
+  base_ptr   left;          // 左子节点
+  base_ptr   right;         // 右子节点
+#if RB_TREE_ORDER_STATISTIC
+  size_t     count;         // 以该节点为根的子树的节点数
+#endif
+
+#if RB_TREE_COMPACT_NODE
+  base_ptr   parent() const
+  {
+    return reinterpret_cast<base_ptr>(parent_color & ~static_cast<uintptr_t>(1));
+  }
+
+  void       set_parent(base_ptr p)
+  {
+    parent_color = reinterpret_cast<uintptr_t>(p) | (parent_color & 1);
+  }
+
+  color_type color() const
+  {
+    return static_cast<color_type>(parent_color & 1);
+  }
+
+  void       set_color(color_type c)
+  {
+    parent_color = (parent_color & ~static_cast<uintptr_t>(1)) | static_cast<uintptr_t>(c);
+  }
+
+  void       init_parent(base_ptr p, color_type c)
+  {
+    parent_color = reinterpret_cast<uintptr_t>(p) | static_cast<uintptr_t>(c);
+  }
+#else
+  base_ptr   parent() const          { return parent_; }
+  void       set_parent(base_ptr p)  { parent_ = p; }
+  color_type color() const           { return color_; }
+  void       set_color(color_type c) { color_ = c; }
+  void       init_parent(base_ptr p, color_type c)
+  {
+    parent_ = p;
+    color_ = c;
+  }
+#endif
 
   base_ptr get_base_ptr()
   {
@@ -206,11 +275,11 @@ struct rb_tree_iterator_base :public mystl::iterator<mystl::bidirectional_iterat
     }
     else
     {  // 如果没有右子节点
-      auto y = node->parent;
+      auto y = node->parent();
       while (y->right == node)
       {
         node = y;
-        y = y->parent;
+        y = y->parent();
       }
       if (node->right != y)  // 应对“寻找根节点的下一节点，而根节点没有右子节点”的特殊情况
         node = y;
@@ -220,7 +289,7 @@ struct rb_tree_iterator_base :public mystl::iterator<mystl::bidirectional_iterat
   // 使迭代器后退
   void dec()
   {
-    if (node->parent->parent == node && rb_tree_is_red(node))
+    if (node->parent()->parent() == node && rb_tree_is_red(node))
     { // 如果 node 为 header
       node = node->right;  // 指向整棵树的 max 节点
     }
@@ -230,11 +299,11 @@ struct rb_tree_iterator_base :public mystl::iterator<mystl::bidirectional_iterat
     }
     else
     {  // 非 header 节点，也无左子节点
-      auto y = node->parent;
+      auto y = node->parent();
       while (node == y->left)
       {
         node = y;
-        y = y->parent;
+        y = y->parent();
       }
       node = y;
     }
@@ -369,26 +438,51 @@ NodePtr rb_tree_max(NodePtr x) noexcept
 template <class NodePtr>
 bool rb_tree_is_lchild(NodePtr node) noexcept
 {
-  return node == node->parent->left;
+  return node == node->parent()->left;
 }
 
 template <class NodePtr>
 bool rb_tree_is_red(NodePtr node) noexcept
 {
-  return node->color == rb_tree_red;
+  return node->color() == rb_tree_red;
+}
+
+template <class NodePtr>
+void rb_tree_set_black(NodePtr node) noexcept
+{
+  node->set_color(rb_tree_black);
+}
+
+template <class NodePtr>
+void rb_tree_set_red(NodePtr node) noexcept
+{
+  node->set_color(rb_tree_red);
 }
 
+#if RB_TREE_ORDER_STATISTIC
 template <class NodePtr>
-void rb_tree_set_black(NodePtr& node) noexcept
+size_t rb_tree_count(NodePtr node) noexcept
 {
-  node->color = rb_tree_black;
+  return node == nullptr ? 0 : node->count;
 }
 
 template <class NodePtr>
-void rb_tree_set_red(NodePtr& node) noexcept
+void rb_tree_update_count(NodePtr node) noexcept
 {
-  node->color = rb_tree_red;
+  node->count = rb_tree_count(node->left) + rb_tree_count(node->right) + 1;
 }
+#endif
+
+// rb tree 节点的增广信息
+// 默认的节点没有增广信息，需要在子树上维护额外信息的节点（如 interval_map 的节点）特化此模板
+// update    : 根据左右孩子重新计算 x 的信息，每次旋转后依次对降下去的节点与升上来的节点调用
+// propagate : 从 x 开始沿父节点向上逐个 update，直到遇到 end 为止，用于插入、删除改变了一条路径之后
+template <class NodePtr>
+struct rb_tree_augment
+{
+  static void update(NodePtr) noexcept {}
+  static void propagate(NodePtr, NodePtr) noexcept {}
+};
 
 template <class NodePtr>
 NodePtr rb_tree_next(NodePtr node) noexcept
@@ -396,8 +490,8 @@ NodePtr rb_tree_next(NodePtr node) noexcept
   if (node->right != nullptr)
     return rb_tree_min(node->right);
   while (!rb_tree_is_lchild(node))
-    node = node->parent;
-  return node->parent;
+    node = node->parent();
+  return node->parent();
 }
 
 /*---------------------------------------*\
@@ -416,8 +510,8 @@ void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept
   auto y = x->right;  // y 为 x 的右子节点
   x->right = y->left;
   if (y->left != nullptr)
-    y->left->parent = x;
-  y->parent = x->parent;
+    y->left->set_parent(x);
+  y->set_parent(x->parent());
 
   if (x == root)
   { // 如果 x 为根节点，让 y 顶替 x 成为根节点
@@ -425,15 +519,21 @@ void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept
   }
   else if (rb_tree_is_lchild(x))
   { // 如果 x 是左子节点
-    x->parent->left = y;
+    x->parent()->left = y;
   }
   else
   { // 如果 x 是右子节点
-    x->parent->right = y;
+    x->parent()->right = y;
   }
   // 调整 x 与 y 的关系
   y->left = x;  
-  x->parent = y;
+  x->set_parent(y);
+#if RB_TREE_ORDER_STATISTIC
+  y->count = x->count;  // y 接管了 x 原来的整颗子树
+  rb_tree_update_count(x);
+#endif
+  rb_tree_augment<NodePtr>::update(x);
+  rb_tree_augment<NodePtr>::update(y);
 }
 
 /*----------------------------------------*\
@@ -452,8 +552,8 @@ void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept
   auto y = x->left;
   x->left = y->right;
   if (y->right)
-    y->right->parent = x;
-  y->parent = x->parent;
+    y->right->set_parent(x);
+  y->set_parent(x->parent());
 
   if (x == root)
   { // 如果 x 为根节点，让 y 顶替 x 成为根节点
@@ -461,18 +561,25 @@ void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept
   }
   else if (rb_tree_is_lchild(x))
   { // 如果 x 是右子节点
-    x->parent->left = y;
+    x->parent()->left = y;
   }
   else
   { // 如果 x 是左子节点
-    x->parent->right = y;
+    x->parent()->right = y;
   }
   // 调整 x 与 y 的关系
   y->right = x;                      
-  x->parent = y;
+  x->set_parent(y);
+#if RB_TREE_ORDER_STATISTIC
+  y->count = x->count;
+  rb_tree_update_count(x);
+#endif
+  rb_tree_augment<NodePtr>::update(x);
+  rb_tree_augment<NodePtr>::update(y);
 }
 
-// 插入节点后使 rb tree 重新平衡，参数一为新增节点，参数二为根节点
+// 以红色节点 x 为起点修复红黑树的性质，参数一为当前节点，参数二为根节点
+// 返回根节点是否由红变黑，此时树的黑高增加了一
 //
 // case 1: 新增节点位于根节点，令新增节点为黑
 // case 2: 新增节点的父节点为黑，没有破坏平衡，直接返回
@@ -486,43 +593,43 @@ void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept
 // 参考博客: http://blog.csdn.net/v_JULY_v/article/details/6105630
 //          http://blog.csdn.net/v_JULY_v/article/details/6109153
 template <class NodePtr>
-void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept
+bool rb_tree_insert_fixup(NodePtr x, NodePtr& root) noexcept
 {
   rb_tree_set_red(x);  // 新增节点为红色
-  while (x != root && rb_tree_is_red(x->parent))
+  while (x != root && rb_tree_is_red(x->parent()))
   {
-    if (rb_tree_is_lchild(x->parent))
+    if (rb_tree_is_lchild(x->parent()))
     { // 如果父节点是左子节点
-      auto uncle = x->parent->parent->right;
+      auto uncle = x->parent()->parent()->right;
       if (uncle != nullptr && rb_tree_is_red(uncle))
       { // case 3: 父节点和叔叔节点都为红
-        rb_tree_set_black(x->parent);
+        rb_tree_set_black(x->parent());
         rb_tree_set_black(uncle);
-        x = x->parent->parent;
+        x = x->parent()->parent();
         rb_tree_set_red(x);
       }
       else
       { // 无叔叔节点或叔叔节点为黑
         if (!rb_tree_is_lchild(x))
         { // case 4: 当前节点 x 为右子节点
-          x = x->parent;
+          x = x->parent();
           rb_tree_rotate_left(x, root);
         }
         // 都转换成 case 5： 当前节点为左子节点
-        rb_tree_set_black(x->parent);
-        rb_tree_set_red(x->parent->parent);
-        rb_tree_rotate_right(x->parent->parent, root);
+        rb_tree_set_black(x->parent());
+        rb_tree_set_red(x->parent()->parent());
+        rb_tree_rotate_right(x->parent()->parent(), root);
         break;
       }
     }
     else  // 如果父节点是右子节点，对称处理
     { 
-      auto uncle = x->parent->parent->left;
+      auto uncle = x->parent()->parent()->left;
       if (uncle != nullptr && rb_tree_is_red(uncle))
       { // case 3: 父节点和叔叔节点都为红
-        rb_tree_set_black(x->parent);
+        rb_tree_set_black(x->parent());
         rb_tree_set_black(uncle);
-        x = x->parent->parent;
+        x = x->parent()->parent();
         rb_tree_set_red(x);
         // 此时祖父节点为红，可能会破坏红黑树的性质，令当前节点为祖父节点，继续处理
       }
@@ -530,18 +637,38 @@ void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept
       { // 无叔叔节点或叔叔节点为黑
         if (rb_tree_is_lchild(x))
         { // case 4: 当前节点 x 为左子节点
-          x = x->parent;
+          x = x->parent();
           rb_tree_rotate_right(x, root);
         }
         // 都转换成 case 5： 当前节点为左子节点
-        rb_tree_set_black(x->parent);
-        rb_tree_set_red(x->parent->parent);
-        rb_tree_rotate_left(x->parent->parent, root);
+        rb_tree_set_black(x->parent());
+        rb_tree_set_red(x->parent()->parent());
+        rb_tree_rotate_left(x->parent()->parent(), root);
         break;
       }
     }
   }
+  const bool grown = rb_tree_is_red(root);
   rb_tree_set_black(root);  // 根节点永远为黑
+  return grown;
+}
+
+// 插入节点后使 rb tree 重新平衡，参数一为新增节点，参数二为根节点
+template <class NodePtr>
+void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept
+{
+#if RB_TREE_ORDER_STATISTIC
+  // 新增节点到根节点路径上的每颗子树都多了一个节点
+  x->count = 1;
+  for (auto p = x; p != root; )
+  {
+    p = p->parent();
+    ++p->count;
+  }
+#endif
+  // 新增节点到根节点的路径上，子树的增广信息都可能改变
+  rb_tree_augment<NodePtr>::propagate(x, root->parent());
+  rb_tree_insert_fixup(x, root);
 }
 
 // 删除节点后使 rb tree 重新平衡，参数一为要删除的节点，参数二为根节点，参数三为最小节点，参数四为最大节点
@@ -558,23 +685,32 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
   // xp 为 x 的父节点
   NodePtr xp = nullptr;
 
+#if RB_TREE_ORDER_STATISTIC
+  // y 是实际从树中摘下的位置，它到根节点路径上的每颗子树都少了一个节点
+  for (auto p = y; p != root; )
+  {
+    p = p->parent();
+    --p->count;
+  }
+#endif
+
   // y != z 说明 z 有两个非空子节点，此时 y 指向 z 右子树的最左节点，x 指向 y 的右子节点。
   // 用 y 顶替 z 的位置，用 x 顶替 y 的位置，最后用 y 指向 z
   if (y != z)
   {
-    z->left->parent = y;
+    z->left->set_parent(y);
     y->left = z->left;
 
     // 如果 y 不是 z 的右子节点，那么 z 的右子节点一定有左孩子
     if (y != z->right)
     { // x 替换 y 的位置
-      xp = y->parent;
+      xp = y->parent();
       if (x != nullptr)
-        x->parent = y->parent;
+        x->set_parent(y->parent());
 
-      y->parent->left = x;
+      y->parent()->left = x;
       y->right = z->right;
-      z->right->parent = y;
+      z->right->set_parent(y);
     }
     else
     {
@@ -585,27 +721,32 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
     if (root == z)
       root = y;
     else if (rb_tree_is_lchild(z))
-      z->parent->left = y;
+      z->parent()->left = y;
     else
-      z->parent->right = y;
-    y->parent = z->parent;
-    mystl::swap(y->color, z->color);
+      z->parent()->right = y;
+    y->set_parent(z->parent());
+#if RB_TREE_ORDER_STATISTIC
+    y->count = z->count;
+#endif
+    auto color = y->color();
+    y->set_color(z->color());
+    z->set_color(color);
     y = z;
   }
   // y == z 说明 z 至多只有一个孩子
   else
   { 
-    xp = y->parent;
+    xp = y->parent();
     if (x)  
-      x->parent = y->parent;
+      x->set_parent(y->parent());
 
     // 连接 x 与 z 的父节点
     if (root == z)
       root = x;
     else if (rb_tree_is_lchild(z))
-      z->parent->left = x;
+      z->parent()->left = x;
     else
-      z->parent->right = x;
+      z->parent()->right = x;
 
     // 此时 z 有可能是最左节点或最右节点，更新数据
     if (leftmost == z)
@@ -614,6 +755,10 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
       rightmost = x == nullptr ? xp : rb_tree_max(x);
   }
 
+  // 摘除节点后，从 xp 到根节点的路径上，子树的增广信息都可能改变
+  if (root != nullptr)
+    rb_tree_augment<NodePtr>::propagate(xp, root->parent());
+
   // 此时，y 指向要删除的节点，x 为替代节点，从 x 节点开始调整。
   // 如果删除的节点为红色，树的性质没有被破坏，否则按照以下情况调整（x 为左子节点为例）：
   // case 1: 兄弟节点为红色，令父节点为红，兄弟节点为黑，进行左（右）旋，继续处理
@@ -642,7 +787,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
         { // case 2
           rb_tree_set_red(brother);
           x = xp;
-          xp = xp->parent;
+          xp = xp->parent();
         }
         else
         { 
@@ -655,7 +800,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
             brother = xp->right;
           }
           // 转为 case 4
-          brother->color = xp->color;
+          brother->set_color(xp->color());
           rb_tree_set_black(xp);
           if (brother->right != nullptr)  
             rb_tree_set_black(brother->right);
@@ -678,7 +823,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
         { // case 2
           rb_tree_set_red(brother);
           x = xp;
-          xp = xp->parent;
+          xp = xp->parent();
         }
         else
         {
@@ -691,7 +836,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
             brother = xp->left;
           }
           // 转为 case 4
-          brother->color = xp->color;
+          brother->set_color(xp->color());
           rb_tree_set_black(xp);
           if (brother->left != nullptr)  
             rb_tree_set_black(brother->left);
@@ -706,6 +851,218 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
   return y;
 }
 
+// 以下函数用于基于 join 的整树操作，操作的对象是脱离了 header 的子树：根节点的父节点为空且为黑色
+// 黑高指从子树根节点到叶子的任一路径上黑色节点的个数（按根节点当前的颜色计），空树的黑高为 0
+// 各函数都带着黑高传递，连接时不必重新沿脊下降求黑高
+
+// 让子树 x 成为一颗独立的红黑树，根节点变黑不会破坏红黑树的性质
+template <class NodePtr>
+NodePtr rb_tree_detach(NodePtr x) noexcept
+{
+  if (x != nullptr)
+  {
+    x->set_parent(nullptr);
+    rb_tree_set_black(x);
+  }
+  return x;
+}
+
+// 同上，h 为 x 的黑高，红色的根节点变黑时黑高加一
+template <class NodePtr>
+NodePtr rb_tree_detach(NodePtr x, size_t& h) noexcept
+{
+  if (x != nullptr && rb_tree_is_red(x))
+    ++h;
+  return rb_tree_detach(x);
+}
+
+// 子树的黑高，需要沿左脊下降，复杂度为 O(log n)，只在整树操作的入口处使用
+template <class NodePtr>
+size_t rb_tree_black_height(NodePtr x) noexcept
+{
+  size_t h = 0;
+  for (; x != nullptr; x = x->left)
+  {
+    if (!rb_tree_is_red(x))
+      ++h;
+  }
+  return h;
+}
+
+// 黑高为 h 的节点 x 的子节点的黑高
+template <class NodePtr>
+size_t rb_tree_child_height(NodePtr x, size_t h) noexcept
+{
+  return rb_tree_is_red(x) ? h : h - 1;
+}
+
+// 以 k 为分隔把 l、r 两颗树连接起来，要求 l 的键值都不大于 k，r 的键值都不小于 k，返回新的根节点
+// hl、hr 为 l、r 的黑高，h 返回新树的黑高
+// 在黑高较大的一颗树上沿右（左）脊下降到黑高相同的黑色节点 y，用红色的 k 连接 y 与另一颗树，
+// 再按插入的方式修复，复杂度为 O(|黑高之差| + 1)
+template <class NodePtr>
+NodePtr rb_tree_join(NodePtr l, size_t hl, NodePtr k, NodePtr r, size_t hr, size_t& h) noexcept
+{
+  l = rb_tree_detach(l, hl);
+  r = rb_tree_detach(r, hr);
+  if (hl == hr)
+  {
+    k->left = l;
+    k->right = r;
+    if (l != nullptr)
+      l->set_parent(k);
+    if (r != nullptr)
+      r->set_parent(k);
+    k->init_parent(nullptr, rb_tree_black);
+#if RB_TREE_ORDER_STATISTIC
+    rb_tree_update_count(k);
+#endif
+    h = hl + 1;
+    return k;
+  }
+  const bool right_spine = hl > hr;
+  NodePtr root = right_spine ? l : r;
+  NodePtr other = right_spine ? r : l;
+  h = right_spine ? hl : hr;
+  auto cur = h;
+  const auto target = right_spine ? hr : hl;
+  NodePtr p = nullptr;
+  NodePtr y = root;
+  while (y != nullptr && (rb_tree_is_red(y) || cur != target))
+  {
+    cur = rb_tree_child_height(y, cur);
+    p = y;
+    y = right_spine ? y->right : y->left;
+  }
+  if (right_spine)
+  {
+    k->left = y;
+    k->right = other;
+    p->right = k;
+  }
+  else
+  {
+    k->left = other;
+    k->right = y;
+    p->left = k;
+  }
+  if (y != nullptr)
+    y->set_parent(k);
+  if (other != nullptr)
+    other->set_parent(k);
+  k->init_parent(p, rb_tree_red);
+#if RB_TREE_ORDER_STATISTIC
+  rb_tree_update_count(k);
+  const auto add = rb_tree_count(other) + 1;
+  for (auto q = p; q != nullptr; q = q->parent())
+    q->count += add;
+#endif
+  if (rb_tree_insert_fixup(k, root))
+    ++h;
+  return root;
+}
+
+// 摘下黑高为 ht 的树 t 的最大节点放入 last，返回剩余部分，h 返回其黑高
+// 沿右脊记下路径，再自底向上把每个节点与它的左子树、已处理的部分连接起来
+template <class NodePtr>
+NodePtr rb_tree_split_last(NodePtr t, size_t ht, NodePtr& last, size_t& h) noexcept
+{
+  NodePtr path[128];
+  size_t  height[128];
+  size_t  n = 0;
+  for (; t->right != nullptr; t = t->right, ++n)
+  {
+    path[n] = t;
+    height[n] = ht;
+    ht = rb_tree_child_height(t, ht);
+  }
+  last = t;
+  h = rb_tree_child_height(t, ht);
+  NodePtr r = rb_tree_detach(t->left, h);
+  while (n > 0)
+  {
+    --n;
+    auto x = path[n];
+    r = rb_tree_join(x->left, rb_tree_child_height(x, height[n]), x, r, h, h);
+  }
+  return r;
+}
+
+// 连接 l、r 两颗树，要求 l 的键值都不大于 r 的键值，hl、hr 为 l、r 的黑高，h 返回新树的黑高
+template <class NodePtr>
+NodePtr rb_tree_join2(NodePtr l, size_t hl, NodePtr r, size_t hr, size_t& h) noexcept
+{
+  if (l == nullptr)
+  {
+    h = hr;
+    return rb_tree_detach(r, h);
+  }
+  if (r == nullptr)
+  {
+    h = hl;
+    return rb_tree_detach(l, h);
+  }
+  NodePtr last = nullptr;
+  size_t hm = 0;
+  l = rb_tree_detach(l, hl);
+  l = rb_tree_split_last(l, hl, last, hm);
+  return rb_tree_join(l, hm, last, r, hr, h);
+}
+
+// 连接两颗不知道黑高的树，先各求一次黑高，复杂度为 O(log n)
+template <class NodePtr>
+NodePtr rb_tree_join2(NodePtr l, NodePtr r) noexcept
+{
+  l = rb_tree_detach(l);
+  r = rb_tree_detach(r);
+  size_t h = 0;
+  return rb_tree_join2(l, rb_tree_black_height(l), r, rb_tree_black_height(r), h);
+}
+
+// 沿 path[0..n) 这条从黑高为 ht 的根节点到 path[n - 1] 的路径把树分为 path[n - 1] 之前的 l 与其余部分 r，
+// hl、hr 返回 l、r 的黑高
+// 自底向上的各次连接中，被连接的树黑高单调变化，代价之和为 O(log n)
+template <class NodePtr>
+void rb_tree_split_path(NodePtr* path, size_t n, size_t ht,
+                        NodePtr& l, size_t& hl, NodePtr& r, size_t& hr) noexcept
+{
+  auto t = path[0];
+  auto tl = t->left;
+  auto tr = t->right;
+  const auto hc = rb_tree_child_height(t, ht);
+  NodePtr m = nullptr;
+  size_t hm = 0;
+  if (n == 1)
+  {
+    hl = hc;
+    l = rb_tree_detach(tl, hl);
+    r = rb_tree_join(m, hm, t, tr, hc, hr);
+  }
+  else if (path[1] == tl)
+  {
+    rb_tree_split_path(path + 1, n - 1, hc, l, hl, m, hm);
+    r = rb_tree_join(m, hm, t, tr, hc, hr);
+  }
+  else
+  {
+    rb_tree_split_path(path + 1, n - 1, hc, m, hm, r, hr);
+    l = rb_tree_join(tl, hc, t, m, hm, hl);
+  }
+}
+
+// 把 x 所在的树分为 x 之前的 l 与从 x 开始的 r，要求 x 所在的树已脱离 header，ht 为该树的黑高
+// 节点数不超过 2^64 时红黑树的高度不超过 128，路径保存在栈上的数组中
+template <class NodePtr>
+void rb_tree_split_before(NodePtr x, size_t ht,
+                          NodePtr& l, size_t& hl, NodePtr& r, size_t& hr) noexcept
+{
+  NodePtr path[128];
+  size_t n = 128;
+  for (; x != nullptr; x = x->parent())
+    path[--n] = x;
+  rb_tree_split_path(path + n, 128 - n, ht, l, hl, r, hr);
+}
+
 // 模板类 rb_tree
 // 参数一代表数据类型，参数二代表键值比较类型
 template <class T, class Compare>
@@ -729,7 +1086,11 @@ public:
   typedef mystl::allocator<T>                      allocator_type;
   typedef mystl::allocator<T>                      data_allocator;
   typedef mystl::allocator<base_type>              base_allocator;
+#if RB_TREE_USE_NODE_POOL
+  typedef mystl::node_pool<node_type>              node_allocator;
+#else
   typedef mystl::allocator<node_type>              node_allocator;
+#endif
 
   typedef typename allocator_type::pointer         pointer;
   typedef typename allocator_type::const_pointer   const_pointer;
@@ -743,7 +1104,10 @@ public:
   typedef mystl::reverse_iterator<iterator>        reverse_iterator;
   typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
 
-  allocator_type get_allocator() const { return node_allocator(); }
+  typedef mystl::node_handle<node_type, value_traits, node_allocator> node_handle_type;
+  typedef mystl::node_insert_return<iterator, node_handle_type>       insert_return_type;
+
+  allocator_type get_allocator() const { return allocator_type(); }
   key_compare    key_comp()      const { return key_comp_; }
 
 private:
@@ -753,8 +1117,9 @@ private:
   key_compare key_comp_;    // 节点键值比较的准则
 
 private:
-  // 以下三个函数用于取得根节点，最小节点和最大节点
-  base_ptr& root()      const { return header_->parent; }
+  // 以下函数用于取得根节点，最小节点和最大节点，根节点保存在 header_ 的父节点域中
+  base_ptr  root()      const { return header_->parent(); }
+  void      set_root(base_ptr x) const { header_->set_parent(x); }
   base_ptr& leftmost()  const { return header_->left; }
   base_ptr& rightmost() const { return header_->right; }
 
@@ -768,7 +1133,12 @@ public:
   rb_tree& operator=(const rb_tree& rhs);
   rb_tree& operator=(rb_tree&& rhs);
 
-  ~rb_tree() { clear(); }
+  ~rb_tree()
+  {
+    clear();
+    if (header_ != nullptr)
+      base_allocator::deallocate(header_);
+  }
 
 public:
   // 迭代器相关操作
@@ -822,6 +1192,13 @@ public:
   template <class ...Args>
   iterator  emplace_unique_use_hint(iterator hint, Args&& ...args);
 
+  // 以下两个函数只用于 map，先按 key 查找，键值已存在时不会创建节点
+  template <class K, class ...Args>
+  mystl::pair<iterator, bool> try_emplace_unique(K&& key, Args&& ...args);
+
+  template <class K, class M>
+  mystl::pair<iterator, bool> insert_or_assign_unique(K&& key, M&& obj);
+
   // insert
 
   iterator  insert_multi(const value_type& value);
@@ -844,6 +1221,11 @@ public:
   {
     size_type n = mystl::distance(first, last);
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
+    if (node_count_ == 0 && n != 0 && sorted_count(first, last, false) == n)
+    { // 空树且输入有序，直接以 O(n) 构建平衡树
+      build_from_sorted(first, last, n, false);
+      return;
+    }
     for (; n > 0; --n, ++first)
       insert_multi(end(), *first);
   }
@@ -868,6 +1250,15 @@ public:
   {
     size_type n = mystl::distance(first, last);
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
+    if (node_count_ == 0 && n != 0)
+    { // 空树且输入有序，直接以 O(n) 构建平衡树
+      const size_type count = sorted_count(first, last, true);
+      if (count != 0)
+      {
+        build_from_sorted(first, last, count, true);
+        return;
+      }
+    }
     for (; n > 0; --n, ++first)
       insert_unique(end(), *first);
   }
@@ -883,52 +1274,127 @@ public:
 
   void      clear();
 
-  // rb_tree 相关操作
+  // extract / insert node / merge
+  // 节点在容器之间转移时不会重新分配内存，也不会复制或移动元素
 
-  iterator       find(const key_type& key);
-  const_iterator find(const key_type& key) const;
+  node_handle_type   extract(iterator position);
+  node_handle_type   extract(const key_type& key);
 
-  size_type      count_multi(const key_type& key) const
-  {
-    auto p = equal_range_multi(key);
-    return static_cast<size_type>(mystl::distance(p.first, p.second));
-  }
-  size_type      count_unique(const key_type& key) const
-  {
-    return find(key) != end() ? 1 : 0;
-  }
+  insert_return_type insert_unique(node_handle_type&& nh);
+  iterator           insert_multi(node_handle_type&& nh);
+
+  void               merge_unique(rb_tree& rhs);
+  void               merge_multi(rb_tree& rhs);
+
+  // rb_tree 相关操作
+  // 若 Compare 定义了 is_transparent，查找函数还接受任何能与 key_type 比较的类型 K，
+  // 此时不会为了查找而构造 key_type 的临时对象
 
-  iterator       lower_bound(const key_type& key);
-  const_iterator lower_bound(const key_type& key) const;
+  iterator       find(const key_type& key)
+  { return iterator(find_node(key)); }
+  const_iterator find(const key_type& key) const
+  { return const_iterator(find_node(key)); }
 
-  iterator       upper_bound(const key_type& key);
-  const_iterator upper_bound(const key_type& key) const;
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       find(const K& key)
+  { return iterator(find_node(key)); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const K& key) const
+  { return const_iterator(find_node(key)); }
 
-  mystl::pair<iterator, iterator>             
+  size_type      count_multi(const key_type& key) const
+  { return count_multi_tr(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  size_type      count_multi(const K& key) const
+  { return count_multi_tr(key); }
+
+  size_type      count_unique(const key_type& key) const
+  { return find_node(key) != header_ ? 1 : 0; }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  size_type      count_unique(const K& key) const
+  { return find_node(key) != header_ ? 1 : 0; }
+
+  iterator       lower_bound(const key_type& key)
+  { return iterator(lower_bound_node(key)); }
+  const_iterator lower_bound(const key_type& key) const
+  { return const_iterator(lower_bound_node(key)); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       lower_bound(const K& key)
+  { return iterator(lower_bound_node(key)); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator lower_bound(const K& key) const
+  { return const_iterator(lower_bound_node(key)); }
+
+  iterator       upper_bound(const key_type& key)
+  { return iterator(upper_bound_node(key)); }
+  const_iterator upper_bound(const key_type& key) const
+  { return const_iterator(upper_bound_node(key)); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       upper_bound(const K& key)
+  { return iterator(upper_bound_node(key)); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator upper_bound(const K& key) const
+  { return const_iterator(upper_bound_node(key)); }
+
+  mystl::pair<iterator, iterator>
   equal_range_multi(const key_type& key)
-  {
-    return mystl::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
-  }
+  { return equal_range_multi_tr<iterator>(key); }
   mystl::pair<const_iterator, const_iterator>
   equal_range_multi(const key_type& key) const
-  {
-    return mystl::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
-  }
+  { return equal_range_multi_tr<const_iterator>(key); }
 
-  mystl::pair<iterator, iterator>             
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  mystl::pair<iterator, iterator>
+  equal_range_multi(const K& key)
+  { return equal_range_multi_tr<iterator>(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  mystl::pair<const_iterator, const_iterator>
+  equal_range_multi(const K& key) const
+  { return equal_range_multi_tr<const_iterator>(key); }
+
+  mystl::pair<iterator, iterator>
   equal_range_unique(const key_type& key)
-  {
-    iterator it = find(key);
-    auto next = it;
-    return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
-  }
-  mystl::pair<const_iterator, const_iterator> 
+  { return equal_range_unique_tr<iterator>(key); }
+  mystl::pair<const_iterator, const_iterator>
   equal_range_unique(const key_type& key) const
-  {
-    const_iterator it = find(key);
-    auto next = it;
-    return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
-  }
+  { return equal_range_unique_tr<const_iterator>(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  mystl::pair<iterator, iterator>
+  equal_range_unique(const K& key)
+  { return equal_range_unique_tr<iterator>(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  mystl::pair<const_iterator, const_iterator>
+  equal_range_unique(const K& key) const
+  { return equal_range_unique_tr<const_iterator>(key); }
+
+  // 顺序统计
+  // 默认（RB_TREE_ORDER_STATISTIC 为 0）时节点不记录子树大小，nth / rank 需要中序遍历，为 O(n)，
+  // 定义 RB_TREE_ORDER_STATISTIC 为 1 后为 O(log n)
+
+  // 返回第 k 小（从 0 开始计数）的元素，k >= size() 时返回 end()
+  iterator       nth(size_type k)
+  { return iterator(nth_node(k)); }
+  const_iterator nth(size_type k) const
+  { return const_iterator(nth_node(k)); }
+
+  // 返回键值小于 key 的元素个数，即 lower_bound(key) 在序列中的位置
+  size_type      rank(const key_type& key) const;
+
+  // 基于 join 的整树操作，rhs 的节点会被移入 *this 或被销毁，操作完成后 rhs 为空
+
+  // 把键值不小于 key 的元素移到 rhs 中，rhs 原有的元素会被清除
+  void split(const key_type& key, rb_tree& rhs);
+  // 把 rhs 的元素接到末尾，要求 rhs 的键值都不小于 *this 的键值
+  void join(rb_tree& rhs);
+
+  // 以下集合操作只用于键值不允许重复的 rb_tree，键值相同时保留 *this 中的元素
+  // 设 m、n 为两颗树中较小、较大的元素个数，复杂度为 O(m log(n / m + 1))
+  void union_unique(rb_tree& rhs);
+  void intersection_unique(rb_tree& rhs);
+  void difference_unique(rb_tree& rhs);
 
   void swap(rb_tree& rhs) noexcept;
 
@@ -958,9 +1424,48 @@ private:
   iterator insert_multi_use_hint(iterator hint, key_type key, node_ptr node);
   iterator insert_unique_use_hint(iterator hint, key_type key, node_ptr node);
 
+  // lookup
+  template <class K>
+  base_ptr  lower_bound_node(const K& key) const;
+  template <class K>
+  base_ptr  upper_bound_node(const K& key) const;
+  template <class K>
+  base_ptr  find_node(const K& key) const;
+  template <class K>
+  size_type count_multi_tr(const K& key) const;
+  template <class Iter, class K>
+  mystl::pair<Iter, Iter> equal_range_multi_tr(const K& key) const;
+  template <class Iter, class K>
+  mystl::pair<Iter, Iter> equal_range_unique_tr(const K& key) const;
+
+  // order statistic
+  base_ptr  nth_node(size_type k) const;
+  size_type rank_node(base_ptr x) const;
+
+  // join based operations
+  size_type erase_range(iterator first, iterator last);
+  base_ptr  release_root();
+  void      reset_root(base_ptr r, size_type n);
+  void      split_lower(base_ptr t, size_t ht, const key_type& key,
+                        base_ptr& l, size_t& hl, base_ptr& r, size_t& hr);
+  base_ptr  split_unique(base_ptr t, size_t ht, const key_type& key,
+                         base_ptr& l, size_t& hl, base_ptr& r, size_t& hr);
+  base_ptr  union_since(base_ptr t1, size_t h1, base_ptr t2, size_t h2, size_t& h, size_type& erased);
+  base_ptr  intersection_since(base_ptr t1, size_t h1, base_ptr t2, size_t h2, size_t& h, size_type& erased);
+  base_ptr  difference_since(base_ptr t1, size_t h1, base_ptr t2, size_t h2, size_t& h, size_type& erased);
+
   // copy tree / erase tree
   base_ptr copy_from(base_ptr x, base_ptr p);
-  void     erase_since(base_ptr x);
+  size_type erase_since(base_ptr x);
+
+  // build from sorted range
+  template <class ForwardIter>
+  size_type sorted_count(ForwardIter first, ForwardIter last, bool unique) const;
+  template <class ForwardIter>
+  void      build_from_sorted(ForwardIter first, ForwardIter last, size_type n, bool unique);
+  template <class ForwardIter>
+  base_ptr  build_subtree(ForwardIter& first, ForwardIter last, size_type n,
+                          size_type level, size_type red_level, bool unique);
 };
 
 /*****************************************************************************************/
@@ -973,7 +1478,7 @@ rb_tree(const rb_tree& rhs)
   rb_tree_init();
   if (rhs.node_count_ != 0)
   {
-    root() = copy_from(rhs.root(), header_);
+    set_root(copy_from(rhs.root(), header_));
     leftmost() = rb_tree_min(root());
     rightmost() = rb_tree_max(root());
   }
@@ -1004,7 +1509,7 @@ operator=(const rb_tree& rhs)
 
     if (rhs.node_count_ != 0)
     {
-      root() = copy_from(rhs.root(), header_);
+      set_root(copy_from(rhs.root(), header_));
       leftmost() = rb_tree_min(root());
       rightmost() = rb_tree_max(root());
     }
@@ -1021,11 +1526,16 @@ rb_tree<T, Compare>&
 rb_tree<T, Compare>::
 operator=(rb_tree&& rhs)
 {
-  clear();
-  header_ = mystl::move(rhs.header_);
-  node_count_ = rhs.node_count_;
-  key_comp_ = rhs.key_comp_;
-  rhs.reset();
+  if (this != &rhs)
+  {
+    clear();
+    if (header_ != nullptr)
+      base_allocator::deallocate(header_);
+    header_ = mystl::move(rhs.header_);
+    node_count_ = rhs.node_count_;
+    key_comp_ = rhs.key_comp_;
+    rhs.reset();
+  }
   return *this;
 }
 
@@ -1152,6 +1662,41 @@ emplace_unique_use_hint(iterator hint, Args&& ...args)
   return insert_unique_use_hint(hint, key, np);
 }
 
+// 键值为 key 的元素不存在时，以 key 和 mapped_type(args...) 构造新元素
+// 键值已存在时直接返回，args 不会被移动，也不会分配内存
+template <class T, class Compare>
+template <class K, class ...Args>
+mystl::pair<typename rb_tree<T, Compare>::iterator, bool>
+rb_tree<T, Compare>::
+try_emplace_unique(K&& key, Args&& ...args)
+{
+  auto res = get_insert_unique_pos(key);
+  if (!res.second)
+    return mystl::make_pair(iterator(res.first.first), false);
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+  node_ptr np = create_node(mystl::forward<K>(key), mapped_type(mystl::forward<Args>(args)...));
+  return mystl::make_pair(insert_node_at(res.first.first, np, res.first.second), true);
+}
+
+// 键值为 key 的元素存在时把 obj 赋给它的 mapped 值，否则以 key 和 obj 构造新元素
+template <class T, class Compare>
+template <class K, class M>
+mystl::pair<typename rb_tree<T, Compare>::iterator, bool>
+rb_tree<T, Compare>::
+insert_or_assign_unique(K&& key, M&& obj)
+{
+  auto res = get_insert_unique_pos(key);
+  if (!res.second)
+  {
+    iterator it(res.first.first);
+    it->second = mystl::forward<M>(obj);
+    return mystl::make_pair(it, false);
+  }
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+  node_ptr np = create_node(mystl::forward<K>(key), mystl::forward<M>(obj));
+  return mystl::make_pair(insert_node_at(res.first.first, np, res.first.second), true);
+}
+
 // 插入元素，节点键值允许重复
 template <class T, class Compare>
 typename rb_tree<T, Compare>::iterator
@@ -1188,12 +1733,114 @@ erase(iterator hint)
   iterator next(node);
   ++next;
   
-  rb_tree_erase_rebalance(hint.node, root(), leftmost(), rightmost());
+  auto r = root();
+  rb_tree_erase_rebalance(hint.node, r, leftmost(), rightmost());
+  set_root(r);
   destroy_node(node);
   --node_count_;
   return next;
 }
 
+// 把 position 所指的节点从树中摘下，交给节点句柄
+template <class T, class Compare>
+typename rb_tree<T, Compare>::node_handle_type
+rb_tree<T, Compare>::
+extract(iterator position)
+{
+  auto node = position.node;
+  auto r = root();
+  rb_tree_erase_rebalance(node, r, leftmost(), rightmost());
+  set_root(r);
+  --node_count_;
+  // 恢复成新建节点的状态，以便之后接到其它树中
+  node->left = nullptr;
+  node->right = nullptr;
+  node->init_parent(nullptr, rb_tree_red);
+#if RB_TREE_ORDER_STATISTIC
+  node->count = 1;
+#endif
+  return node_handle_type(node->get_node_ptr());
+}
+
+// 摘下第一个键值等于 key 的节点，没有这样的节点时返回空句柄
+template <class T, class Compare>
+typename rb_tree<T, Compare>::node_handle_type
+rb_tree<T, Compare>::
+extract(const key_type& key)
+{
+  auto it = lower_bound(key);
+  if (it == end() || key_comp_(key, value_traits::get_key(*it)))
+    return node_handle_type();
+  return extract(it);
+}
+
+// 插入节点句柄持有的节点，键值不允许重复
+// 插入失败时节点仍留在返回值的 node 中
+template <class T, class Compare>
+typename rb_tree<T, Compare>::insert_return_type
+rb_tree<T, Compare>::
+insert_unique(node_handle_type&& nh)
+{
+  if (nh.empty())
+    return insert_return_type{ end(), false, node_handle_type() };
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+  auto res = get_insert_unique_pos(value_traits::get_key(nh.node_->value));
+  if (!res.second)
+    return insert_return_type{ iterator(res.first.first), false, mystl::move(nh) };
+  auto it = insert_node_at(res.first.first, nh.release(), res.first.second);
+  return insert_return_type{ it, true, node_handle_type() };
+}
+
+// 插入节点句柄持有的节点，键值允许重复
+template <class T, class Compare>
+typename rb_tree<T, Compare>::iterator
+rb_tree<T, Compare>::
+insert_multi(node_handle_type&& nh)
+{
+  if (nh.empty())
+    return end();
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
+  auto res = get_insert_multi_pos(value_traits::get_key(nh.node_->value));
+  return insert_node_at(res.first, nh.release(), res.second);
+}
+
+// 把 rhs 中的节点移到 *this 中，键值不允许重复，与 *this 中键值相同的节点留在 rhs 中
+template <class T, class Compare>
+void rb_tree<T, Compare>::
+merge_unique(rb_tree& rhs)
+{
+  if (this == &rhs)
+    return;
+  for (auto it = rhs.begin(); it != rhs.end(); )
+  {
+    auto res = get_insert_unique_pos(value_traits::get_key(*it));
+    if (!res.second)
+    {
+      ++it;
+      continue;
+    }
+    auto cur = it++;
+    insert_node_at(res.first.first, rhs.extract(cur).release(), res.first.second);
+  }
+}
+
+// 把 rhs 中的节点全部移到 *this 中，键值允许重复
+template <class T, class Compare>
+void rb_tree<T, Compare>::
+merge_multi(rb_tree& rhs)
+{
+  if (this == &rhs)
+    return;
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - rhs.node_count_,
+                        "rb_tree<T, Comp>'s size too big");
+  for (auto it = rhs.begin(); it != rhs.end(); )
+  {
+    auto res = get_insert_multi_pos(value_traits::get_key(*it));
+    auto cur = it++;
+    insert_node_at(res.first, rhs.extract(cur).release(), res.second);
+  }
+}
+
 // 删除键值等于 key 的元素，返回删除的个数
 template <class T, class Compare>
 typename rb_tree<T, Compare>::size_type
@@ -1201,9 +1848,7 @@ rb_tree<T, Compare>::
 erase_multi(const key_type& key)
 {
   auto p = equal_range_multi(key);
-  size_type n = mystl::distance(p.first, p.second);
-  erase(p.first, p.second);
-  return n;
+  return erase_range(p.first, p.second);
 }
 
 // 删除键值等于 key 的元素，返回删除的个数
@@ -1226,15 +1871,7 @@ template <class T, class Compare>
 void rb_tree<T, Compare>::
 erase(iterator first, iterator last)
 {
-  if (first == begin() && last == end())
-  {
-    clear();
-  }
-  else
-  {
-    while (first != last)
-      erase(first++);
-  }
+  erase_range(first, last);
 }
 
 // 清空 rb tree
@@ -1246,141 +1883,235 @@ clear()
   {
     erase_since(root());
     leftmost() = header_;
-    root() = nullptr;
+    set_root(nullptr);
     rightmost() = header_;
     node_count_ = 0;
   }
 }
 
-// 查找键值为 k 的节点，返回指向它的迭代器
+// 查找第一个键值不小于 key 的节点，没有这样的节点时返回 header_
 template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
+template <class K>
+typename rb_tree<T, Compare>::base_ptr
 rb_tree<T, Compare>::
-find(const key_type& key)
+lower_bound_node(const K& key) const
 {
-  auto y = header_;  // 最后一个不小于 key 的节点
+  auto y = header_;
   auto x = root();
   while (x != nullptr)
   {
     if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
-    { // key 小于等于 x 键值，向左走
+    { // key <= x
       y = x, x = x->left;
     }
     else
-    { // key 大于 x 键值，向右走
+    {
       x = x->right;
     }
   }
-  iterator j = iterator(y);
-  return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
+  return y;
 }
 
+// 查找第一个键值大于 key 的节点，没有这样的节点时返回 header_
 template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
+template <class K>
+typename rb_tree<T, Compare>::base_ptr
 rb_tree<T, Compare>::
-find(const key_type& key) const
+upper_bound_node(const K& key) const
 {
-  auto y = header_;  // 最后一个不小于 key 的节点
+  auto y = header_;
   auto x = root();
   while (x != nullptr)
   {
-    if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
-    { // key 小于等于 x 键值，向左走
+    if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value)))
+    { // key < x
       y = x, x = x->left;
     }
     else
-    { // key 大于 x 键值，向右走
+    {
       x = x->right;
     }
   }
-  const_iterator j = const_iterator(y);
-  return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
+  return y;
 }
 
-// 键值不小于 key 的第一个位置
+// 查找键值等于 key 的第一个节点，没有这样的节点时返回 header_
 template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
+template <class K>
+typename rb_tree<T, Compare>::base_ptr
 rb_tree<T, Compare>::
-lower_bound(const key_type& key)
+find_node(const K& key) const
 {
-  auto y = header_;
-  auto x = root();
-  while (x != nullptr)
-  {
-    if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
-    { // key <= x
-      y = x, x = x->left;
-    }
-    else
-    {
-      x = x->right;
-    }
-  }
-  return iterator(y);
+  auto y = lower_bound_node(key);
+  return (y == header_ || key_comp_(key, value_traits::get_key(y->get_node_ptr()->value)))
+    ? header_ : y;
+}
+
+// 键值等于 key 的元素个数
+template <class T, class Compare>
+template <class K>
+typename rb_tree<T, Compare>::size_type
+rb_tree<T, Compare>::
+count_multi_tr(const K& key) const
+{
+#if RB_TREE_ORDER_STATISTIC
+  return rank_node(upper_bound_node(key)) - rank_node(lower_bound_node(key));
+#else
+  auto p = equal_range_multi_tr<const_iterator>(key);
+  return static_cast<size_type>(mystl::distance(p.first, p.second));
+#endif
 }
 
+// 键值等于 key 的区间，键值允许重复
 template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
+template <class Iter, class K>
+mystl::pair<Iter, Iter>
 rb_tree<T, Compare>::
-lower_bound(const key_type& key) const
+equal_range_multi_tr(const K& key) const
 {
-  auto y = header_;
-  auto x = root();
-  while (x != nullptr)
-  {
-    if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
-    { // key <= x
-      y = x, x = x->left;
-    }
-    else
-    {
-      x = x->right;
-    }
-  }
-  return const_iterator(y);
+  return mystl::pair<Iter, Iter>(Iter(lower_bound_node(key)), Iter(upper_bound_node(key)));
 }
 
-// 键值不小于 key 的最后一个位置
+// 键值等于 key 的区间，键值不允许重复
 template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
+template <class Iter, class K>
+mystl::pair<Iter, Iter>
 rb_tree<T, Compare>::
-upper_bound(const key_type& key)
+equal_range_unique_tr(const K& key) const
 {
-  auto y = header_;
-  auto x = root();
-  while (x != nullptr)
-  {
-    if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value)))
-    { // key < x
-      y = x, x = x->left;
-    }
-    else
-    {
-      x = x->right;
-    }
-  }
-  return iterator(y);
+  Iter it(find_node(key));
+  auto next = it;
+  return it == Iter(header_) ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
 }
 
+// 返回键值小于 key 的元素个数
 template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
+typename rb_tree<T, Compare>::size_type
 rb_tree<T, Compare>::
-upper_bound(const key_type& key) const
+rank(const key_type& key) const
 {
-  auto y = header_;
+#if RB_TREE_ORDER_STATISTIC
+  size_type r = 0;
   auto x = root();
   while (x != nullptr)
   {
-    if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value)))
-    { // key < x
-      y = x, x = x->left;
+    if (key_comp_(value_traits::get_key(x->get_node_ptr()->value), key))
+    { // x 及其左子树都小于 key
+      r += rb_tree_count(x->left) + 1;
+      x = x->right;
     }
     else
     {
-      x = x->right;
+      x = x->left;
     }
   }
-  return const_iterator(y);
+  return r;
+#else
+  return static_cast<size_type>(mystl::distance(begin(), lower_bound(key)));
+#endif
+}
+
+// 把键值不小于 key 的元素移到 rhs 中
+template <class T, class Compare>
+void rb_tree<T, Compare>::
+split(const key_type& key, rb_tree& rhs)
+{
+  if (this == &rhs)
+    return;
+  rhs.clear();
+  const auto n = node_count_;
+  base_ptr l = nullptr;
+  base_ptr r = nullptr;
+  size_t hl = 0;
+  size_t hr = 0;
+  auto t = release_root();
+  split_lower(t, rb_tree_black_height(t), key, l, hl, r, hr);
+#if RB_TREE_ORDER_STATISTIC
+  const size_type rn = rb_tree_count(r);
+  reset_root(l, n - rn);
+  rhs.reset_root(r, rn);
+#else
+  // 没有子树节点数时，从两颗树的头部同时遍历，代价为较小一颗树的元素个数
+  reset_root(l, 0);
+  rhs.reset_root(r, 0);
+  size_type walked = 0;
+  auto lit = begin();
+  auto rit = rhs.begin();
+  while (lit != end() && rit != rhs.end())
+  {
+    ++lit;
+    ++rit;
+    ++walked;
+  }
+  node_count_ = lit == end() ? walked : n - walked;
+  rhs.node_count_ = n - node_count_;
+#endif
+}
+
+// 把 rhs 的元素接到末尾
+template <class T, class Compare>
+void rb_tree<T, Compare>::
+join(rb_tree& rhs)
+{
+  if (this == &rhs || rhs.node_count_ == 0)
+    return;
+  MYSTL_DEBUG(node_count_ == 0 ||
+              !key_comp_(value_traits::get_key(rhs.leftmost()->get_node_ptr()->value),
+                         value_traits::get_key(rightmost()->get_node_ptr()->value)));
+  const auto n = node_count_ + rhs.node_count_;
+  auto r = rb_tree_join2(release_root(), rhs.release_root());
+  reset_root(r, n);
+}
+
+// 并集：把 rhs 中 *this 没有的键值移入 *this
+template <class T, class Compare>
+void rb_tree<T, Compare>::
+union_unique(rb_tree& rhs)
+{
+  if (this == &rhs)
+    return;
+  const auto n = node_count_ + rhs.node_count_;
+  size_type erased = 0;
+  auto t1 = release_root();
+  auto t2 = rhs.release_root();
+  size_t h = 0;
+  auto r = union_since(t1, rb_tree_black_height(t1), t2, rb_tree_black_height(t2), h, erased);
+  reset_root(r, n - erased);
+}
+
+// 交集：只保留 rhs 中也存在的键值
+template <class T, class Compare>
+void rb_tree<T, Compare>::
+intersection_unique(rb_tree& rhs)
+{
+  if (this == &rhs)
+    return;
+  const auto n = node_count_ + rhs.node_count_;
+  size_type erased = 0;
+  auto t1 = release_root();
+  auto t2 = rhs.release_root();
+  size_t h = 0;
+  auto r = intersection_since(t1, rb_tree_black_height(t1), t2, rb_tree_black_height(t2), h, erased);
+  reset_root(r, n - erased);
+}
+
+// 差集：删除 rhs 中存在的键值
+template <class T, class Compare>
+void rb_tree<T, Compare>::
+difference_unique(rb_tree& rhs)
+{
+  if (this == &rhs)
+  {
+    clear();
+    return;
+  }
+  const auto n = node_count_ + rhs.node_count_;
+  size_type erased = 0;
+  auto t1 = release_root();
+  auto t2 = rhs.release_root();
+  size_t h = 0;
+  auto r = difference_since(t1, rb_tree_black_height(t1), t2, rb_tree_black_height(t2), h, erased);
+  reset_root(r, n - erased);
 }
 
 // 交换 rb tree
@@ -1406,13 +2137,20 @@ typename rb_tree<T, Compare>::node_ptr
 rb_tree<T, Compare>::
 create_node(Args&&... args)
 {
+#if RB_TREE_USE_NODE_POOL
+  auto tmp = node_allocator::allocate();
+#else
   auto tmp = node_allocator::allocate(1);
+#endif
   try
   {
     data_allocator::construct(mystl::address_of(tmp->value), mystl::forward<Args>(args)...);
     tmp->left = nullptr;
     tmp->right = nullptr;
-    tmp->parent = nullptr;
+    tmp->init_parent(nullptr, rb_tree_red);
+#if RB_TREE_ORDER_STATISTIC
+    tmp->count = 1;
+#endif
   }
   catch (...)
   {
@@ -1429,9 +2167,12 @@ rb_tree<T, Compare>::
 clone_node(base_ptr x)
 {
   node_ptr tmp = create_node(x->get_node_ptr()->value);
-  tmp->color = x->color;
+  tmp->set_color(x->color());
   tmp->left = nullptr;
   tmp->right = nullptr;
+#if RB_TREE_ORDER_STATISTIC
+  tmp->count = x->count;
+#endif
   return tmp;
 }
 
@@ -1450,8 +2191,7 @@ void rb_tree<T, Compare>::
 rb_tree_init()
 {
   header_ = base_allocator::allocate(1);
-  header_->color = rb_tree_red;  // header_ 节点颜色为红，与 root 区分
-  root() = nullptr;
+  header_->init_parent(nullptr, rb_tree_red);  // header_ 节点颜色为红，与 root 区分
   leftmost() = header_;
   rightmost() = header_;
   node_count_ = 0;
@@ -1487,7 +2227,7 @@ template <class T, class Compare>
 mystl::pair<mystl::pair<typename rb_tree<T, Compare>::base_ptr, bool>, bool>
 rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key)
 { // 返回一个 pair，第一个值为一个 pair，包含插入点的父节点和一个 bool 表示是否在左边插入，
-  // 第二个值为一个 bool，表示是否插入成功
+  // 第二个值为一个 bool，表示是否插入成功，插入失败时第一个值中的节点为键值重复的节点
   auto x = root();
   auto y = header_;
   bool add_to_left = true;  // 树为空时也在 header_ 左边插入
@@ -1513,8 +2253,8 @@ rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key)
   { // 表明新节点没有重复
     return mystl::make_pair(mystl::make_pair(y, add_to_left), true);
   }
-  // 进行至此，表示新节点与现有节点键值重复
-  return mystl::make_pair(mystl::make_pair(y, add_to_left), false);
+  // 进行至此，表示新节点与现有节点键值重复，返回重复的节点
+  return mystl::make_pair(mystl::make_pair(j.node, add_to_left), false);
 }
 
 // insert_value_at 函数
@@ -1525,11 +2265,11 @@ rb_tree<T, Compare>::
 insert_value_at(base_ptr x, const value_type& value, bool add_to_left)
 {
   node_ptr node = create_node(value);
-  node->parent = x;
+  node->set_parent(x);
   auto base_node = node->get_base_ptr();
   if (x == header_)
   {
-    root() = base_node;
+    set_root(base_node);
     leftmost() = base_node;
     rightmost() = base_node;
   }
@@ -1545,7 +2285,9 @@ insert_value_at(base_ptr x, const value_type& value, bool add_to_left)
     if (rightmost() == x)
       rightmost() = base_node;
   }
-  rb_tree_insert_rebalance(base_node, root());
+  auto r = root();
+  rb_tree_insert_rebalance(base_node, r);
+  set_root(r);
   ++node_count_;
   return iterator(node);
 }
@@ -1557,11 +2299,11 @@ typename rb_tree<T, Compare>::iterator
 rb_tree<T, Compare>::
 insert_node_at(base_ptr x, node_ptr node, bool add_to_left)
 {
-  node->parent = x;
+  node->set_parent(x);
   auto base_node = node->get_base_ptr();
   if (x == header_)
   {
-    root() = base_node;
+    set_root(base_node);
     leftmost() = base_node;
     rightmost() = base_node;
   }
@@ -1577,7 +2319,9 @@ insert_node_at(base_ptr x, node_ptr node, bool add_to_left)
     if (rightmost() == x)
       rightmost() = base_node;
   }
-  rb_tree_insert_rebalance(base_node, root());
+  auto r = root();
+  rb_tree_insert_rebalance(base_node, r);
+  set_root(r);
   ++node_count_;
   return iterator(node);
 }
@@ -1641,6 +2385,61 @@ insert_unique_use_hint(iterator hint, key_type key, node_ptr node)
   return insert_node_at(pos.first.first, node, pos.first.second);
 }
 
+// nth_node 函数
+// 找到中序第 k 个节点，k >= size() 时返回 header_
+template <class T, class Compare>
+typename rb_tree<T, Compare>::base_ptr
+rb_tree<T, Compare>::nth_node(size_type k) const
+{
+  if (k >= node_count_)
+    return header_;
+#if RB_TREE_ORDER_STATISTIC
+  auto x = root();
+  while (true)
+  {
+    const auto left_count = rb_tree_count(x->left);
+    if (k < left_count)
+    {
+      x = x->left;
+    }
+    else if (k == left_count)
+    {
+      return x;
+    }
+    else
+    {
+      k -= left_count + 1;
+      x = x->right;
+    }
+  }
+#else
+  auto it = begin();
+  mystl::advance(it, k);
+  return it.node;
+#endif
+}
+
+// rank_node 函数
+// 返回节点 x 在中序中的位置，x 为 header_ 时返回 size()
+template <class T, class Compare>
+typename rb_tree<T, Compare>::size_type
+rb_tree<T, Compare>::rank_node(base_ptr x) const
+{
+  if (x == header_)
+    return node_count_;
+#if RB_TREE_ORDER_STATISTIC
+  size_type r = rb_tree_count(x->left);
+  for (auto p = x->parent(); p != header_; x = p, p = p->parent())
+  {
+    if (x == p->right)
+      r += rb_tree_count(p->left) + 1;
+  }
+  return r;
+#else
+  return static_cast<size_type>(mystl::distance(const_iterator(leftmost()), const_iterator(x)));
+#endif
+}
+
 // copy_from 函数
 // 递归复制一颗树，节点从 x 开始，p 为 x 的父节点
 template <class T, class Compare>
@@ -1648,7 +2447,7 @@ typename rb_tree<T, Compare>::base_ptr
 rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p)
 {
   auto top = clone_node(x);
-  top->parent = p;
+  top->set_parent(p);
   try
   {
     if (x->right)
@@ -1659,7 +2458,7 @@ rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p)
     {
       auto y = clone_node(x);
       p->left = y;
-      y->parent = p;
+      y->set_parent(p);
       if (x->right)
         y->right = copy_from(x->right, y);
       p = y;
@@ -1674,19 +2473,377 @@ rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p)
   return top;
 }
 
-// erase_since 函数
-// 从 x 节点开始删除该节点及其子树
+// erase_range 函数
+// 删除 [first, last) 区间内的元素，返回删除的个数
+// 区间不超过 rb_tree_erase_range_threshold 个元素时逐个删除，否则在 first、last 处把树分为三段，
+// 销毁中间一段后再把两边连接起来。分割与连接都带着黑高进行，调整结构的代价为 O(log n)，
+// 不必为每个被删除的节点做一次平衡，销毁 k 个节点另需 O(k)
+template <class T, class Compare>
+typename rb_tree<T, Compare>::size_type
+rb_tree<T, Compare>::
+erase_range(iterator first, iterator last)
+{
+  if (first == begin() && last == end())
+  {
+    const auto n = node_count_;
+    clear();
+    return n;
+  }
+  size_type n = 0;
+  auto it = first;
+  for (; it != last && n < rb_tree_erase_range_threshold; ++it)
+    ++n;
+  if (it == last)
+  {
+    while (first != last)
+      erase(first++);
+    return n;
+  }
+  const auto total = node_count_;
+  const bool to_end = last.node == header_;
+  base_ptr l = nullptr;
+  base_ptr m = nullptr;
+  base_ptr r = nullptr;
+  size_t hl = 0;
+  size_t hm = 0;
+  size_t hr = 0;
+  auto t = release_root();
+  rb_tree_split_before(first.node, rb_tree_black_height(t), l, hl, m, hm);
+  if (!to_end)
+    rb_tree_split_before(last.node, hm, m, hm, r, hr);
+  n = erase_since(m);
+  size_t h = 0;
+  reset_root(rb_tree_join2(l, hl, r, hr, h), total - n);
+  return n;
+}
+
+// release_root 函数
+// 把整颗树从 header_ 上摘下并返回其根节点，容器变为空
+template <class T, class Compare>
+typename rb_tree<T, Compare>::base_ptr
+rb_tree<T, Compare>::release_root()
+{
+  auto r = rb_tree_detach(root());
+  set_root(nullptr);
+  leftmost() = header_;
+  rightmost() = header_;
+  node_count_ = 0;
+  return r;
+}
+
+// reset_root 函数
+// 以 r 为根节点、n 为节点数重新设置容器，要求容器为空
+template <class T, class Compare>
+void rb_tree<T, Compare>::reset_root(base_ptr r, size_type n)
+{
+  if (r == nullptr)
+    return;
+  r->set_parent(header_);
+  rb_tree_set_black(r);
+  set_root(r);
+  leftmost() = rb_tree_min(r);
+  rightmost() = rb_tree_max(r);
+  node_count_ = n;
+}
+
+// split_lower 函数
+// 把黑高为 ht 的树 t 分为键值小于 key 的 l 与键值不小于 key 的 r，hl、hr 返回它们的黑高
 template <class T, class Compare>
 void rb_tree<T, Compare>::
+split_lower(base_ptr t, size_t ht, const key_type& key,
+            base_ptr& l, size_t& hl, base_ptr& r, size_t& hr)
+{
+  if (t == nullptr)
+  {
+    l = r = nullptr;
+    hl = hr = 0;
+    return;
+  }
+  auto tl = t->left;
+  auto tr = t->right;
+  const auto hc = rb_tree_child_height(t, ht);
+  base_ptr m = nullptr;
+  size_t hm = 0;
+  if (key_comp_(value_traits::get_key(t->get_node_ptr()->value), key))
+  {
+    split_lower(tr, hc, key, m, hm, r, hr);
+    l = rb_tree_join(tl, hc, t, m, hm, hl);
+  }
+  else
+  {
+    split_lower(tl, hc, key, l, hl, m, hm);
+    r = rb_tree_join(m, hm, t, tr, hc, hr);
+  }
+}
+
+// split_unique 函数
+// 把黑高为 ht 的树 t 分为键值小于 key 的 l 与键值大于 key 的 r，hl、hr 返回它们的黑高，
+// 返回键值等于 key 的节点，没有则返回 nullptr
+template <class T, class Compare>
+typename rb_tree<T, Compare>::base_ptr
+rb_tree<T, Compare>::
+split_unique(base_ptr t, size_t ht, const key_type& key,
+             base_ptr& l, size_t& hl, base_ptr& r, size_t& hr)
+{
+  if (t == nullptr)
+  {
+    l = r = nullptr;
+    hl = hr = 0;
+    return nullptr;
+  }
+  auto tl = t->left;
+  auto tr = t->right;
+  const auto hc = rb_tree_child_height(t, ht);
+  const auto& tkey = value_traits::get_key(t->get_node_ptr()->value);
+  base_ptr m = nullptr;
+  size_t hm = 0;
+  base_ptr found = nullptr;
+  if (key_comp_(tkey, key))
+  {
+    found = split_unique(tr, hc, key, m, hm, r, hr);
+    l = rb_tree_join(tl, hc, t, m, hm, hl);
+  }
+  else if (key_comp_(key, tkey))
+  {
+    found = split_unique(tl, hc, key, l, hl, m, hm);
+    r = rb_tree_join(m, hm, t, tr, hc, hr);
+  }
+  else
+  {
+    hl = hr = hc;
+    l = rb_tree_detach(tl, hl);
+    r = rb_tree_detach(tr, hr);
+    found = t;
+  }
+  return found;
+}
+
+// union_since 函数
+// 以 t1 的根节点分割 t2，递归合并左右两部分后再以根节点连接，重复的节点被销毁并计入 erased
+// h1、h2 为 t1、t2 的黑高，h 返回结果的黑高
+template <class T, class Compare>
+typename rb_tree<T, Compare>::base_ptr
+rb_tree<T, Compare>::
+union_since(base_ptr t1, size_t h1, base_ptr t2, size_t h2, size_t& h, size_type& erased)
+{
+  if (t1 == nullptr)
+  {
+    h = h2;
+    return t2;
+  }
+  if (t2 == nullptr)
+  {
+    h = h1;
+    return t1;
+  }
+  auto htl = rb_tree_child_height(t1, h1);
+  auto htr = htl;
+  auto tl = rb_tree_detach(t1->left, htl);
+  auto tr = rb_tree_detach(t1->right, htr);
+  base_ptr l2 = nullptr;
+  base_ptr r2 = nullptr;
+  size_t hl2 = 0;
+  size_t hr2 = 0;
+  auto dup = split_unique(t2, h2, value_traits::get_key(t1->get_node_ptr()->value), l2, hl2, r2, hr2);
+  if (dup != nullptr)
+  {
+    destroy_node(dup->get_node_ptr());
+    ++erased;
+  }
+  // 左右两部分互不相关，可以并行处理
+  size_t hl = 0;
+  size_t hr = 0;
+  auto l = union_since(tl, htl, l2, hl2, hl, erased);
+  auto r = union_since(tr, htr, r2, hr2, hr, erased);
+  return rb_tree_join(l, hl, t1, r, hr, h);
+}
+
+// intersection_since 函数
+// 以 t1 的根节点分割 t2，不在交集中的节点被销毁并计入 erased
+// h1、h2 为 t1、t2 的黑高，h 返回结果的黑高
+template <class T, class Compare>
+typename rb_tree<T, Compare>::base_ptr
+rb_tree<T, Compare>::
+intersection_since(base_ptr t1, size_t h1, base_ptr t2, size_t h2, size_t& h, size_type& erased)
+{
+  if (t1 == nullptr || t2 == nullptr)
+  {
+    erased += erase_since(t1) + erase_since(t2);
+    h = 0;
+    return nullptr;
+  }
+  auto htl = rb_tree_child_height(t1, h1);
+  auto htr = htl;
+  auto tl = rb_tree_detach(t1->left, htl);
+  auto tr = rb_tree_detach(t1->right, htr);
+  base_ptr l2 = nullptr;
+  base_ptr r2 = nullptr;
+  size_t hl2 = 0;
+  size_t hr2 = 0;
+  auto dup = split_unique(t2, h2, value_traits::get_key(t1->get_node_ptr()->value), l2, hl2, r2, hr2);
+  size_t hl = 0;
+  size_t hr = 0;
+  auto l = intersection_since(tl, htl, l2, hl2, hl, erased);
+  auto r = intersection_since(tr, htr, r2, hr2, hr, erased);
+  ++erased;
+  if (dup != nullptr)
+  {
+    destroy_node(dup->get_node_ptr());
+    return rb_tree_join(l, hl, t1, r, hr, h);
+  }
+  destroy_node(t1->get_node_ptr());
+  return rb_tree_join2(l, hl, r, hr, h);
+}
+
+// difference_since 函数
+// 以 t2 的根节点分割 t1，t2 的节点与被删除的节点都被销毁并计入 erased
+// h1、h2 为 t1、t2 的黑高，h 返回结果的黑高
+template <class T, class Compare>
+typename rb_tree<T, Compare>::base_ptr
+rb_tree<T, Compare>::
+difference_since(base_ptr t1, size_t h1, base_ptr t2, size_t h2, size_t& h, size_type& erased)
+{
+  if (t1 == nullptr || t2 == nullptr)
+  {
+    erased += erase_since(t2);
+    h = h1;
+    return t1;
+  }
+  auto htl = rb_tree_child_height(t2, h2);
+  auto htr = htl;
+  auto tl = rb_tree_detach(t2->left, htl);
+  auto tr = rb_tree_detach(t2->right, htr);
+  base_ptr l1 = nullptr;
+  base_ptr r1 = nullptr;
+  size_t hl1 = 0;
+  size_t hr1 = 0;
+  auto dup = split_unique(t1, h1, value_traits::get_key(t2->get_node_ptr()->value), l1, hl1, r1, hr1);
+  destroy_node(t2->get_node_ptr());
+  ++erased;
+  if (dup != nullptr)
+  {
+    destroy_node(dup->get_node_ptr());
+    ++erased;
+  }
+  size_t hl = 0;
+  size_t hr = 0;
+  auto l = difference_since(l1, hl1, tl, htl, hl, erased);
+  auto r = difference_since(r1, hr1, tr, htr, hr, erased);
+  return rb_tree_join2(l, hl, r, hr, h);
+}
+
+// erase_since 函数
+// 从 x 节点开始删除该节点及其子树，返回删除的节点数
+template <class T, class Compare>
+typename rb_tree<T, Compare>::size_type
+rb_tree<T, Compare>::
 erase_since(base_ptr x)
 {
+  size_type n = 0;
   while (x != nullptr)
   {
-    erase_since(x->right);
+    n += erase_since(x->right);
     auto y = x->left;
     destroy_node(x->get_node_ptr());
     x = y;
+    ++n;
+  }
+  return n;
+}
+
+// sorted_count 函数
+// 检查 [first, last) 是否按键值非递减排列，有序时返回要插入的元素个数（unique 时不计重复键值），
+// 无序时返回 0
+template <class T, class Compare>
+template <class ForwardIter>
+typename rb_tree<T, Compare>::size_type
+rb_tree<T, Compare>::
+sorted_count(ForwardIter first, ForwardIter last, bool unique) const
+{
+  if (first == last)
+    return 0;
+  size_type count = 1;
+  auto prev = first;
+  for (++first; first != last; prev = first, ++first)
+  {
+    if (key_comp_(value_traits::get_key(*first), value_traits::get_key(*prev)))
+      return 0;
+    if (!unique || key_comp_(value_traits::get_key(*prev), value_traits::get_key(*first)))
+      ++count;
+  }
+  return count;
+}
+
+// build_from_sorted 函数
+// 用有序区间中的 n 个元素在空树上构建一颗完全平衡的红黑树，复杂度为 O(n)
+// 除最底层未填满的一层节点为红色外，其余节点均为黑色，因此每条路径的黑高相同
+template <class T, class Compare>
+template <class ForwardIter>
+void rb_tree<T, Compare>::
+build_from_sorted(ForwardIter first, ForwardIter last, size_type n, bool unique)
+{
+  size_type red_level = 0;
+  for (auto m = static_cast<difference_type>(n) - 1; m >= 0; m = m / 2 - 1)
+    ++red_level;
+#if RB_TREE_USE_NODE_POOL
+  node_allocator::reserve(n);
+#endif
+  auto r = build_subtree(first, last, n, 0, red_level, unique);
+  r->set_parent(header_);
+  set_root(r);
+  leftmost() = rb_tree_min(r);
+  rightmost() = rb_tree_max(r);
+  node_count_ = n;
+}
+
+// build_subtree 函数
+// 按中序消耗 first 开始的 n 个元素构建一颗子树，level 为子树根节点的深度
+template <class T, class Compare>
+template <class ForwardIter>
+typename rb_tree<T, Compare>::base_ptr
+rb_tree<T, Compare>::
+build_subtree(ForwardIter& first, ForwardIter last, size_type n,
+              size_type level, size_type red_level, bool unique)
+{
+  if (n == 0)
+    return nullptr;
+  const size_type left_n = (n - 1) / 2;
+  base_ptr left = build_subtree(first, last, left_n, level + 1, red_level, unique);
+  base_ptr mid = nullptr;
+  try
+  {
+    mid = create_node(*first);
+  }
+  catch (...)
+  {
+    erase_since(left);
+    throw;
+  }
+  mid->set_color(level == red_level ? rb_tree_red : rb_tree_black);
+#if RB_TREE_ORDER_STATISTIC
+  mid->count = n;
+#endif
+  mid->left = left;
+  if (left != nullptr)
+    left->set_parent(mid);
+  try
+  {
+    auto prev = first;
+    ++first;
+    // unique 时跳过与刚插入的元素键值相同的元素，保留第一个
+    while (unique && first != last &&
+           !key_comp_(value_traits::get_key(*prev), value_traits::get_key(*first)))
+      ++first;
+    mid->right = build_subtree(first, last, n - 1 - left_n, level + 1, red_level, unique);
+  }
+  catch (...)
+  {
+    erase_since(mid);
+    throw;
   }
+  if (mid->right != nullptr)
+    mid->right->set_parent(mid);
+  return mid;
 }
 
 // 重载比较操作符
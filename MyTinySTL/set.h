@@ -48,6 +48,8 @@ public:
   typedef typename base_type::size_type              size_type;
   typedef typename base_type::difference_type        difference_type;
   typedef typename base_type::allocator_type         allocator_type;
+  typedef typename base_type::node_handle_type       node_handle_type;
+  typedef mystl::node_insert_return<iterator, node_handle_type> insert_return_type;
 
 public:
   // 构造、复制、移动函数
@@ -171,6 +173,17 @@ public:
 
   void      clear() { tree_.clear(); }
 
+  // 节点句柄相关操作，节点在容器之间转移时不会重新分配内存或复制元素
+  node_handle_type   extract(iterator position)    { return tree_.extract(position); }
+  node_handle_type   extract(const key_type& key)  { return tree_.extract(key); }
+  insert_return_type insert(node_handle_type&& nh)
+  {
+    auto res = tree_.insert_unique(mystl::move(nh));
+    return insert_return_type{ res.position, res.inserted, mystl::move(res.node) };
+  }
+  void               merge(set& source)            { tree_.merge_unique(source.tree_); }
+  void               merge(set&& source)           { tree_.merge_unique(source.tree_); }
+
   // set 相关操作
 
   iterator       find(const key_type& key)              { return tree_.find(key); }
@@ -192,6 +205,49 @@ public:
     equal_range(const key_type& key) const
   { return tree_.equal_range_unique(key); }
 
+  // 比较函数定义了 is_transparent 时，可以直接用能与 key_type 比较的类型查找
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       find(const K& key)                     { return tree_.find(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const K& key)               const { return tree_.find(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  size_type      count(const K& key)              const { return tree_.count_unique(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       lower_bound(const K& key)              { return tree_.lower_bound(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator lower_bound(const K& key)        const { return tree_.lower_bound(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       upper_bound(const K& key)              { return tree_.upper_bound(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator upper_bound(const K& key)        const { return tree_.upper_bound(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  pair<iterator, iterator>
+    equal_range(const K& key)
+  { return tree_.equal_range_unique(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  pair<const_iterator, const_iterator>
+    equal_range(const K& key) const
+  { return tree_.equal_range_unique(key); }
+
+  // 顺序统计，默认需要中序遍历，为 O(n)；定义 RB_TREE_ORDER_STATISTIC 为 1 时为 O(log n)
+  iterator       nth(size_type k)               const { return tree_.nth(k); }
+  size_type      rank(const key_type& key)      const { return tree_.rank(key); }
+
+  // 整树操作，rhs 的元素会被移入或销毁，操作完成后 rhs 为空
+  // split 把键值不小于 key 的元素移到 rhs 中，join 要求 rhs 的键值都不小于本容器的键值
+  void           split(const key_type& key, set& rhs) { tree_.split(key, rhs.tree_); }
+  void           join(set& rhs)                       { tree_.join(rhs.tree_); }
+
+  // 集合操作，键值相同时保留本容器中的元素
+  void           union_with(set& rhs)                 { tree_.union_unique(rhs.tree_); }
+  void           intersection_with(set& rhs)          { tree_.intersection_unique(rhs.tree_); }
+  void           difference_with(set& rhs)            { tree_.difference_unique(rhs.tree_); }
+
   void swap(set& rhs) noexcept
   { tree_.swap(rhs.tree_); }
 
@@ -276,6 +332,7 @@ public:
   typedef typename base_type::size_type              size_type;
   typedef typename base_type::difference_type        difference_type;
   typedef typename base_type::allocator_type         allocator_type;
+  typedef typename base_type::node_handle_type       node_handle_type;
 
 public:
   // 构造、复制、移动函数
@@ -399,6 +456,13 @@ public:
 
   void           clear() { tree_.clear(); }
 
+  // 节点句柄相关操作，节点在容器之间转移时不会重新分配内存或复制元素
+  node_handle_type   extract(iterator position)    { return tree_.extract(position); }
+  node_handle_type   extract(const key_type& key)  { return tree_.extract(key); }
+  iterator           insert(node_handle_type&& nh) { return tree_.insert_multi(mystl::move(nh)); }
+  void               merge(multiset& source)       { tree_.merge_multi(source.tree_); }
+  void               merge(multiset&& source)      { tree_.merge_multi(source.tree_); }
+
   // multiset 相关操作
 
   iterator       find(const key_type& key)              { return tree_.find(key); }
@@ -420,6 +484,44 @@ public:
     equal_range(const key_type& key) const
   { return tree_.equal_range_multi(key); }
 
+  // 比较函数定义了 is_transparent 时，可以直接用能与 key_type 比较的类型查找
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       find(const K& key)                     { return tree_.find(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const K& key)               const { return tree_.find(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  size_type      count(const K& key)              const { return tree_.count_multi(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       lower_bound(const K& key)              { return tree_.lower_bound(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator lower_bound(const K& key)        const { return tree_.lower_bound(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator       upper_bound(const K& key)              { return tree_.upper_bound(key); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator upper_bound(const K& key)        const { return tree_.upper_bound(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  pair<iterator, iterator>
+    equal_range(const K& key)
+  { return tree_.equal_range_multi(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  pair<const_iterator, const_iterator>
+    equal_range(const K& key) const
+  { return tree_.equal_range_multi(key); }
+
+  // 顺序统计，默认需要中序遍历，为 O(n)；定义 RB_TREE_ORDER_STATISTIC 为 1 时为 O(log n)
+  iterator       nth(size_type k)               const { return tree_.nth(k); }
+  size_type      rank(const key_type& key)      const { return tree_.rank(key); }
+
+  // 整树操作，rhs 的元素会被移入或销毁，操作完成后 rhs 为空
+  // split 把键值不小于 key 的元素移到 rhs 中，join 要求 rhs 的键值都不小于本容器的键值
+  void           split(const key_type& key, multiset& rhs) { tree_.split(key, rhs.tree_); }
+  void           join(multiset& rhs)                       { tree_.join(rhs.tree_); }
+
   void swap(multiset& rhs) noexcept
   { tree_.swap(rhs.tree_); }
 
@@ -50,6 +50,9 @@ public:
   typedef typename base_type::local_iterator       local_iterator;
   typedef typename base_type::const_local_iterator const_local_iterator;
 
+  typedef typename base_type::node_handle_type     node_handle_type;
+  typedef typename base_type::insert_return_type   insert_return_type;
+
   allocator_type get_allocator() const { return ht_.get_allocator(); }
 
 public:
@@ -153,6 +156,22 @@ public:
   iterator emplace_hint(const_iterator hint, Args&& ...args)
   { return ht_.emplace_unique_use_hint(hint, mystl::forward<Args>(args)...); }
 
+  // 键值不存在时才构造新元素，键值已存在时不会分配内存，args 也不会被移动
+  template <class ...Args>
+  pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+  { return ht_.try_emplace_unique(key, mystl::forward<Args>(args)...); }
+  template <class ...Args>
+  pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+  { return ht_.try_emplace_unique(mystl::move(key), mystl::forward<Args>(args)...); }
+
+  // 键值存在时把 obj 赋给对应的值，否则插入新元素
+  template <class M>
+  pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+  { return ht_.insert_or_assign_unique(key, mystl::forward<M>(obj)); }
+  template <class M>
+  pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+  { return ht_.insert_or_assign_unique(mystl::move(key), mystl::forward<M>(obj)); }
+
   // insert
 
   pair<iterator, bool> insert(const value_type& value)
@@ -182,6 +201,18 @@ public:
   void      clear()
   { ht_.clear(); }
 
+  // 节点句柄相关操作，节点在容器之间转移时不会重新分配内存或复制元素
+  node_handle_type   extract(const_iterator position)
+  { return ht_.extract(position); }
+  node_handle_type   extract(const key_type& key)
+  { return ht_.extract(key); }
+  insert_return_type insert(node_handle_type&& nh)
+  { return ht_.insert_unique(mystl::move(nh)); }
+  void               merge(unordered_map& source)
+  { ht_.merge_unique(source.ht_); }
+  void               merge(unordered_map&& source)
+  { ht_.merge_unique(source.ht_); }
+
   void      swap(unordered_map& other) noexcept
   { ht_.swap(other.ht_); }
 
@@ -202,17 +233,11 @@ public:
 
   mapped_type& operator[](const key_type& key)
   {
-    iterator it = ht_.find(key);
-    if (it.node == nullptr)
-      it = ht_.emplace_unique(key, T{}).first;
-    return it->second;
+    return ht_.try_emplace_unique(key).first->second;
   }
   mapped_type& operator[](key_type&& key)
   {
-    iterator it = ht_.find(key);
-    if (it.node == nullptr)
-      it = ht_.emplace_unique(mystl::move(key), T{}).first;
-    return it->second;
+    return ht_.try_emplace_unique(mystl::move(key)).first->second;
   }
 
   size_type      count(const key_type& key) const 
@@ -228,6 +253,30 @@ public:
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const
   { return ht_.equal_range_unique(key); }
 
+  // 哈希函数与判等函数都定义了 is_transparent 时，可以直接用能与 key_type 比较的类型查找
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  size_type      count(const K& key) const
+  { return ht_.count(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  iterator       find(const K& key)
+  { return ht_.find(key); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  const_iterator find(const K& key) const
+  { return ht_.find(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<iterator, iterator> equal_range(const K& key)
+  { return ht_.equal_range_unique(key); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const
+  { return ht_.equal_range_unique(key); }
+
   // bucket interface
 
   local_iterator       begin(size_type n)        noexcept
@@ -335,6 +384,8 @@ public:
   typedef typename base_type::local_iterator       local_iterator;
   typedef typename base_type::const_local_iterator const_local_iterator;
 
+  typedef typename base_type::node_handle_type     node_handle_type;
+
   allocator_type get_allocator() const { return ht_.get_allocator(); }
 
 public:
@@ -467,6 +518,18 @@ public:
   void      clear()
   { ht_.clear(); }
 
+  // 节点句柄相关操作，节点在容器之间转移时不会重新分配内存或复制元素
+  node_handle_type   extract(const_iterator position)
+  { return ht_.extract(position); }
+  node_handle_type   extract(const key_type& key)
+  { return ht_.extract(key); }
+  iterator           insert(node_handle_type&& nh)
+  { return ht_.insert_multi(mystl::move(nh)); }
+  void               merge(unordered_multimap& source)
+  { ht_.merge_multi(source.ht_); }
+  void               merge(unordered_multimap&& source)
+  { ht_.merge_multi(source.ht_); }
+
   void      swap(unordered_multimap& other) noexcept 
   { ht_.swap(other.ht_); }
 
@@ -485,6 +548,30 @@ public:
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const 
   { return ht_.equal_range_multi(key); }
 
+  // 哈希函数与判等函数都定义了 is_transparent 时，可以直接用能与 key_type 比较的类型查找
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  size_type      count(const K& key) const
+  { return ht_.count(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  iterator       find(const K& key)
+  { return ht_.find(key); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  const_iterator find(const K& key) const
+  { return ht_.find(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<iterator, iterator> equal_range(const K& key)
+  { return ht_.equal_range_multi(key); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const
+  { return ht_.equal_range_multi(key); }
+
   // bucket interface
 
   local_iterator       begin(size_type n)        noexcept
@@ -48,6 +48,9 @@ public:
   typedef typename base_type::const_local_iterator local_iterator;
   typedef typename base_type::const_local_iterator const_local_iterator;
 
+  typedef typename base_type::node_handle_type     node_handle_type;
+  typedef typename base_type::insert_return_type   insert_return_type;
+
   allocator_type get_allocator() const { return ht_.get_allocator(); }
 
 public:
@@ -180,6 +183,18 @@ public:
   void      clear()
   { ht_.clear(); }
 
+  // 节点句柄相关操作，节点在容器之间转移时不会重新分配内存或复制元素
+  node_handle_type   extract(const_iterator position)
+  { return ht_.extract(position); }
+  node_handle_type   extract(const key_type& key)
+  { return ht_.extract(key); }
+  insert_return_type insert(node_handle_type&& nh)
+  { return ht_.insert_unique(mystl::move(nh)); }
+  void               merge(unordered_set& source)
+  { ht_.merge_unique(source.ht_); }
+  void               merge(unordered_set&& source)
+  { ht_.merge_unique(source.ht_); }
+
   void      swap(unordered_set& other) noexcept
   { ht_.swap(other.ht_); }
 
@@ -198,6 +213,30 @@ public:
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const
   { return ht_.equal_range_unique(key); }
 
+  // 哈希函数与判等函数都定义了 is_transparent 时，可以直接用能与 key_type 比较的类型查找
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  size_type      count(const K& key) const
+  { return ht_.count(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  iterator       find(const K& key)
+  { return ht_.find(key); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  const_iterator find(const K& key) const
+  { return ht_.find(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<iterator, iterator> equal_range(const K& key)
+  { return ht_.equal_range_unique(key); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const
+  { return ht_.equal_range_unique(key); }
+
   // bucket interface
 
   local_iterator       begin(size_type n)        noexcept
@@ -305,6 +344,8 @@ public:
   typedef typename base_type::const_local_iterator local_iterator;
   typedef typename base_type::const_local_iterator const_local_iterator;
 
+  typedef typename base_type::node_handle_type     node_handle_type;
+
   allocator_type get_allocator() const { return ht_.get_allocator(); }
 
 public:
@@ -438,6 +479,18 @@ public:
   void      clear()
   { ht_.clear(); }
 
+  // 节点句柄相关操作，节点在容器之间转移时不会重新分配内存或复制元素
+  node_handle_type   extract(const_iterator position)
+  { return ht_.extract(position); }
+  node_handle_type   extract(const key_type& key)
+  { return ht_.extract(key); }
+  iterator           insert(node_handle_type&& nh)
+  { return ht_.insert_multi(mystl::move(nh)); }
+  void               merge(unordered_multiset& source)
+  { ht_.merge_multi(source.ht_); }
+  void               merge(unordered_multiset&& source)
+  { ht_.merge_multi(source.ht_); }
+
   void      swap(unordered_multiset& other) noexcept 
   { ht_.swap(other.ht_); }
 
@@ -456,6 +509,30 @@ public:
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const
   { return ht_.equal_range_multi(key); }
 
+  // 哈希函数与判等函数都定义了 is_transparent 时，可以直接用能与 key_type 比较的类型查找
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  size_type      count(const K& key) const
+  { return ht_.count(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  iterator       find(const K& key)
+  { return ht_.find(key); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  const_iterator find(const K& key) const
+  { return ht_.find(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<iterator, iterator> equal_range(const K& key)
+  { return ht_.equal_range_multi(key); }
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = typename H::is_transparent, class = typename E::is_transparent>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const
+  { return ht_.equal_range_multi(key); }
+
   // bucket interface
 
   local_iterator       begin(size_type n)        noexcept
@@ -0,0 +1,1010 @@
+#ifndef MYTINYSTL_UNROLLED_LIST_H_
+#define MYTINYSTL_UNROLLED_LIST_H_
+
+// 这个头文件包含了一个模板类 unrolled_list
+// unrolled_list : 展开链表，每个节点保存一小段连续的元素
+
+// notes:
+//
+// 节点组成一个带哨兵的双向链表，每个节点内最多连续存放 BlockSize 个元素：
+//   * 遍历时大部分步进只在节点内的数组上移动，接近 vector 的遍历速度
+//   * 在任意位置插入 / 删除只需移动一个节点内的元素，节点满时一分为二，过空时与后继合并
+//   * splice 最多拆分一个节点，然后以节点为单位接合，代价为 O(BlockSize)
+// 插入与删除会使所在节点及被拆分、合并的节点上的迭代器失效
+//
+// 异常保证：
+// mystl::unrolled_list<T> 满足基本异常保证
+
+#include <initializer_list>
+
+#include "iterator.h"
+#include "memory.h"
+#include "functional.h"
+#include "util.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif // min
+
+// 每个节点默认保存的元素个数，按每个节点约 512 字节确定
+// 比 deque 的 4096 字节缓冲区小：节点内插入、删除要移动元素，节点越大，中间插入的代价越高
+template <class T>
+struct unrolled_list_block_size
+{
+  static constexpr size_t value = sizeof(T) < 64 ? 512 / sizeof(T) : 8;
+};
+
+// unrolled_list 的节点结构
+
+template <class T>
+struct unrolled_list_node_base
+{
+  typedef unrolled_list_node_base<T>* base_ptr;
+
+  base_ptr prev;   // 前一节点
+  base_ptr next;   // 下一节点
+  size_t   count;  // 节点内的元素个数
+
+  void unlink()
+  {
+    prev = next = this;
+    count = 0;
+  }
+};
+
+template <class T, size_t N>
+struct unrolled_list_node : public unrolled_list_node_base<T>
+{
+  alignas(T) unsigned char storage[N * sizeof(T)];  // 未初始化的元素空间
+
+  T* data()
+  {
+    return reinterpret_cast<T*>(storage);
+  }
+};
+
+// unrolled_list 的迭代器设计，由所在节点与节点内下标组成
+template <class T, size_t N>
+struct unrolled_list_iterator : public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+  typedef T                                   value_type;
+  typedef T*                                  pointer;
+  typedef T&                                  reference;
+  typedef unrolled_list_node_base<T>*         base_ptr;
+  typedef unrolled_list_node<T, N>*           node_ptr;
+  typedef unrolled_list_iterator<T, N>        self;
+
+  base_ptr node_;   // 当前节点
+  size_t   index_;  // 节点内的下标
+
+  // 构造函数
+  unrolled_list_iterator() = default;
+  unrolled_list_iterator(base_ptr x, size_t i)
+    :node_(x), index_(i) {}
+
+  // 重载操作符
+  reference operator*()  const { return static_cast<node_ptr>(node_)->data()[index_]; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    if (++index_ == node_->count)
+    {
+      node_ = node_->next;
+      index_ = 0;
+    }
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  self& operator--()
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    if (index_ == 0)
+    {
+      node_ = node_->prev;
+      index_ = node_->count;
+    }
+    --index_;
+    return *this;
+  }
+  self operator--(int)
+  {
+    self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return node_ == rhs.node_ && index_ == rhs.index_; }
+  bool operator!=(const self& rhs) const { return !(*this == rhs); }
+};
+
+template <class T, size_t N>
+struct unrolled_list_const_iterator : public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+  typedef T                                   value_type;
+  typedef const T*                            pointer;
+  typedef const T&                            reference;
+  typedef unrolled_list_node_base<T>*         base_ptr;
+  typedef unrolled_list_node<T, N>*           node_ptr;
+  typedef unrolled_list_const_iterator<T, N>  self;
+
+  base_ptr node_;
+  size_t   index_;
+
+  unrolled_list_const_iterator() = default;
+  unrolled_list_const_iterator(base_ptr x, size_t i)
+    :node_(x), index_(i) {}
+  unrolled_list_const_iterator(const unrolled_list_iterator<T, N>& rhs)
+    :node_(rhs.node_), index_(rhs.index_) {}
+
+  reference operator*()  const { return static_cast<node_ptr>(node_)->data()[index_]; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    if (++index_ == node_->count)
+    {
+      node_ = node_->next;
+      index_ = 0;
+    }
+    return *this;
+  }
+  self operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  self& operator--()
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    if (index_ == 0)
+    {
+      node_ = node_->prev;
+      index_ = node_->count;
+    }
+    --index_;
+    return *this;
+  }
+  self operator--(int)
+  {
+    self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return node_ == rhs.node_ && index_ == rhs.index_; }
+  bool operator!=(const self& rhs) const { return !(*this == rhs); }
+};
+
+// 模板类: unrolled_list
+// 模板参数 T 代表数据类型，BlockSize 代表每个节点最多保存的元素个数
+template <class T, size_t BlockSize = unrolled_list_block_size<T>::value>
+class unrolled_list
+{
+  static_assert(BlockSize >= 2, "unrolled_list block size must be at least 2");
+public:
+  // unrolled_list 的嵌套型别定义
+  typedef mystl::allocator<T>                              allocator_type;
+  typedef mystl::allocator<T>                              data_allocator;
+  typedef mystl::allocator<unrolled_list_node_base<T>>     base_allocator;
+  typedef mystl::allocator<unrolled_list_node<T, BlockSize>> node_allocator;
+
+  typedef typename allocator_type::value_type              value_type;
+  typedef typename allocator_type::pointer                 pointer;
+  typedef typename allocator_type::const_pointer           const_pointer;
+  typedef typename allocator_type::reference               reference;
+  typedef typename allocator_type::const_reference         const_reference;
+  typedef typename allocator_type::size_type               size_type;
+  typedef typename allocator_type::difference_type         difference_type;
+
+  typedef unrolled_list_iterator<T, BlockSize>             iterator;
+  typedef unrolled_list_const_iterator<T, BlockSize>       const_iterator;
+  typedef mystl::reverse_iterator<iterator>                reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>          const_reverse_iterator;
+
+  typedef unrolled_list_node_base<T>*                      base_ptr;
+  typedef unrolled_list_node<T, BlockSize>*                node_ptr;
+
+  static constexpr size_type block_size = BlockSize;
+
+  allocator_type get_allocator() { return allocator_type(); }
+
+private:
+  base_ptr  node_;  // 哨兵节点，不保存元素
+  size_type size_;  // 大小
+
+public:
+  // 构造、复制、移动、析构函数
+  unrolled_list()
+  { init(); }
+
+  explicit unrolled_list(size_type n)
+  {
+    init();
+    insert(end(), n, value_type());
+  }
+
+  unrolled_list(size_type n, const T& value)
+  {
+    init();
+    insert(end(), n, value);
+  }
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  unrolled_list(Iter first, Iter last)
+  {
+    init();
+    insert(end(), first, last);
+  }
+
+  unrolled_list(std::initializer_list<T> ilist)
+  {
+    init();
+    insert(end(), ilist.begin(), ilist.end());
+  }
+
+  unrolled_list(const unrolled_list& rhs)
+  {
+    init();
+    insert(end(), rhs.begin(), rhs.end());
+  }
+
+  unrolled_list(unrolled_list&& rhs) noexcept
+    :node_(rhs.node_), size_(rhs.size_)
+  {
+    rhs.node_ = nullptr;
+    rhs.size_ = 0;
+  }
+
+  unrolled_list& operator=(const unrolled_list& rhs)
+  {
+    if (this != &rhs)
+    {
+      assign(rhs.begin(), rhs.end());
+    }
+    return *this;
+  }
+
+  unrolled_list& operator=(unrolled_list&& rhs) noexcept
+  {
+    unrolled_list tmp(mystl::move(rhs));
+    swap(tmp);
+    return *this;
+  }
+
+  unrolled_list& operator=(std::initializer_list<T> ilist)
+  {
+    assign(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  ~unrolled_list()
+  {
+    if (node_)
+    {
+      clear();
+      base_allocator::deallocate(node_);
+      node_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+public:
+  // 迭代器相关操作
+  iterator               begin()         noexcept
+  { return iterator(node_->next, 0); }
+  const_iterator         begin()   const noexcept
+  { return const_iterator(node_->next, 0); }
+  iterator               end()           noexcept
+  { return iterator(node_, 0); }
+  const_iterator         end()     const noexcept
+  { return const_iterator(node_, 0); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept
+  { return size_ == 0; }
+
+  size_type size()     const noexcept
+  { return size_; }
+
+  size_type max_size() const noexcept
+  { return static_cast<size_type>(-1); }
+
+  // 访问元素相关操作
+  reference       front()
+  {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+
+  const_reference front() const
+  {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+
+  reference       back()
+  {
+    MYSTL_DEBUG(!empty());
+    return *(--end());
+  }
+
+  const_reference back()  const
+  {
+    MYSTL_DEBUG(!empty());
+    return *(--end());
+  }
+
+  // 调整容器相关操作
+
+  // assign
+
+  void     assign(size_type n, const value_type& value);
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  void     assign(Iter first, Iter last);
+
+  void     assign(std::initializer_list<T> ilist)
+  { assign(ilist.begin(), ilist.end()); }
+
+  // emplace_front / emplace_back / emplace
+
+  template <class ...Args>
+  void     emplace_front(Args&& ...args)
+  { emplace(cbegin(), mystl::forward<Args>(args)...); }
+
+  template <class ...Args>
+  void     emplace_back(Args&& ...args)
+  { emplace(cend(), mystl::forward<Args>(args)...); }
+
+  template <class ...Args>
+  iterator emplace(const_iterator pos, Args&& ...args);
+
+  // insert
+
+  iterator insert(const_iterator pos, const value_type& value)
+  { return emplace(pos, value); }
+
+  iterator insert(const_iterator pos, value_type&& value)
+  { return emplace(pos, mystl::move(value)); }
+
+  iterator insert(const_iterator pos, size_type n, const value_type& value);
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_input_iterator<Iter>::value, int>::type = 0>
+  iterator insert(const_iterator pos, Iter first, Iter last);
+
+  iterator insert(const_iterator pos, std::initializer_list<T> ilist)
+  { return insert(pos, ilist.begin(), ilist.end()); }
+
+  // push_front / push_back
+
+  void push_front(const value_type& value)
+  { emplace(cbegin(), value); }
+
+  void push_front(value_type&& value)
+  { emplace(cbegin(), mystl::move(value)); }
+
+  void push_back(const value_type& value)
+  { emplace(cend(), value); }
+
+  void push_back(value_type&& value)
+  { emplace(cend(), mystl::move(value)); }
+
+  // pop_front / pop_back
+
+  void pop_front()
+  {
+    MYSTL_DEBUG(!empty());
+    erase(cbegin());
+  }
+
+  void pop_back()
+  {
+    MYSTL_DEBUG(!empty());
+    erase(--cend());
+  }
+
+  // erase / clear
+
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+
+  void     clear();
+
+  // resize
+
+  void     resize(size_type new_size) { resize(new_size, value_type()); }
+  void     resize(size_type new_size, const value_type& value);
+
+  void     swap(unrolled_list& rhs) noexcept
+  {
+    mystl::swap(node_, rhs.node_);
+    mystl::swap(size_, rhs.size_);
+  }
+
+  // unrolled_list 相关操作
+
+  void splice(const_iterator pos, unrolled_list& other);
+
+  template <class UnaryPredicate>
+  void remove_if(UnaryPredicate pred);
+  void remove(const value_type& value)
+  { remove_if([&](const value_type& v) {return v == value; }); }
+
+  void reverse();
+
+private:
+  // helper functions
+
+  void     init();
+
+  // create / destroy node
+  node_ptr create_node();
+  void     destroy_node(base_ptr p);
+
+  static T* data(base_ptr p)
+  { return static_cast<node_ptr>(p)->data(); }
+
+  // link / unlink
+  void     link_node_before(base_ptr pos, base_ptr node);
+  void     unlink_node(base_ptr node);
+
+  // split / merge
+  base_ptr split_node(base_ptr p, size_type index);
+  void     merge_next_if_need(base_ptr p);
+  iterator normalize(base_ptr p, size_type index);
+
+  // insert helper
+  base_ptr prepare_append(const_iterator pos);
+  void     append_node_if_full(base_ptr& p);
+  void     discard_if_empty(base_ptr p) noexcept;
+
+};
+
+/*****************************************************************************************/
+
+// 用 n 个元素为容器赋值
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::assign(size_type n, const value_type& value)
+{
+  auto i = begin();
+  auto e = end();
+  for (; n > 0 && i != e; --n, ++i)
+  {
+    *i = value;
+  }
+  if (n > 0)
+  {
+    insert(e, n, value);
+  }
+  else
+  {
+    erase(i, e);
+  }
+}
+
+// 复制 [first, last) 为容器赋值
+template <class T, size_t BlockSize>
+template <class Iter, typename std::enable_if<
+  mystl::is_input_iterator<Iter>::value, int>::type>
+void unrolled_list<T, BlockSize>::assign(Iter first, Iter last)
+{
+  auto i = begin();
+  auto e = end();
+  for (; first != last && i != e; ++first, ++i)
+  {
+    *i = *first;
+  }
+  if (first == last)
+  {
+    erase(i, e);
+  }
+  else
+  {
+    insert(e, first, last);
+  }
+}
+
+// 在 pos 处就地构造元素
+template <class T, size_t BlockSize>
+template <class ...Args>
+typename unrolled_list<T, BlockSize>::iterator
+unrolled_list<T, BlockSize>::emplace(const_iterator pos, Args&& ...args)
+{
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "unrolled_list<T>'s size too big");
+  base_ptr p = pos.node_;
+  size_type index = pos.index_;
+  if (index == 0 && p->prev != node_ && p->prev->count < BlockSize)
+  { // 插在节点开头时，优先追加到前一节点的末尾
+    p = p->prev;
+    index = p->count;
+  }
+  else if (p == node_)
+  { // 所有节点都满了或容器为空，在尾部新建节点
+    auto n = create_node();
+    link_node_before(node_, n);
+    p = n;
+    index = 0;
+  }
+  else if (p->count == BlockSize)
+  { // 节点已满，一分为二
+    const size_type half = BlockSize / 2;
+    auto n = split_node(p, half);
+    if (index > half)
+    {
+      p = n;
+      index -= half;
+    }
+  }
+
+  T* d = data(p);
+  const size_type count = p->count;
+  if (index == count)
+  {
+    data_allocator::construct(d + count, mystl::forward<Args>(args)...);
+  }
+  else
+  {
+    value_type tmp(mystl::forward<Args>(args)...);
+    data_allocator::construct(d + count, mystl::move(d[count - 1]));
+    mystl::move_backward(d + index, d + count - 1, d + count);
+    d[index] = mystl::move(tmp);
+  }
+  ++p->count;
+  ++size_;
+  return iterator(p, index);
+}
+
+// 在 pos 处插入 n 个元素
+// 与区间插入相同，只在 pos 处拆开一次节点，新元素依次追加，复杂度为 O(n + BlockSize)
+template <class T, size_t BlockSize>
+typename unrolled_list<T, BlockSize>::iterator
+unrolled_list<T, BlockSize>::insert(const_iterator pos, size_type n, const value_type& value)
+{
+  if (n == 0)
+    return iterator(pos.node_, pos.index_);
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "unrolled_list<T>'s size too big");
+  auto p = prepare_append(pos);
+  const auto r = iterator(p, p->count);
+  try
+  {
+    for (; n > 0; --n)
+    {
+      append_node_if_full(p);
+      data_allocator::construct(data(p) + p->count, value);
+      ++p->count;
+      ++size_;
+    }
+  }
+  catch (...)
+  { // 已插入的元素保留
+    discard_if_empty(p);
+    throw;
+  }
+  return r;
+}
+
+// 在 pos 处插入 [first, last) 的元素
+// 先在 pos 处拆开节点（或利用前一节点末尾的空间），再把新元素依次追加到节点末尾，节点满了就新建节点，
+// 复杂度为 O(k + BlockSize)，k 为插入的元素个数
+template <class T, size_t BlockSize>
+template <class Iter, typename std::enable_if<
+  mystl::is_input_iterator<Iter>::value, int>::type>
+typename unrolled_list<T, BlockSize>::iterator
+unrolled_list<T, BlockSize>::insert(const_iterator pos, Iter first, Iter last)
+{
+  if (first == last)
+    return iterator(pos.node_, pos.index_);
+  auto p = prepare_append(pos);
+  const auto r = iterator(p, p->count);
+  try
+  {
+    for (; first != last; ++first)
+    {
+      append_node_if_full(p);
+      data_allocator::construct(data(p) + p->count, *first);
+      ++p->count;
+      ++size_;
+    }
+  }
+  catch (...)
+  { // 已插入的元素保留
+    discard_if_empty(p);
+    throw;
+  }
+  return r;
+}
+
+// 删除 pos 处的元素
+template <class T, size_t BlockSize>
+typename unrolled_list<T, BlockSize>::iterator
+unrolled_list<T, BlockSize>::erase(const_iterator pos)
+{
+  MYSTL_DEBUG(pos != cend());
+  base_ptr p = pos.node_;
+  const size_type index = pos.index_;
+  T* d = data(p);
+  mystl::move(d + index + 1, d + p->count, d + index);
+  data_allocator::destroy(d + p->count - 1);
+  --p->count;
+  --size_;
+  return normalize(p, index);
+}
+
+// 删除 [first, last) 内的元素，整段覆盖的节点直接释放
+template <class T, size_t BlockSize>
+typename unrolled_list<T, BlockSize>::iterator
+unrolled_list<T, BlockSize>::erase(const_iterator first, const_iterator last)
+{
+  size_type n = mystl::distance(first, last);
+  base_ptr p = first.node_;
+  size_type index = first.index_;
+  iterator r(last.node_, last.index_);
+  while (n > 0)
+  {
+    if (index == 0 && n >= p->count)
+    {
+      auto next = p->next;
+      n -= p->count;
+      size_ -= p->count;
+      unlink_node(p);
+      destroy_node(p);
+      r = iterator(next, 0);
+      p = next;
+      continue;
+    }
+    const size_type k = mystl::min(n, p->count - index);
+    T* d = data(p);
+    mystl::move(d + index + k, d + p->count, d + index);
+    data_allocator::destroy(d + p->count - k, d + p->count);
+    p->count -= k;
+    size_ -= k;
+    n -= k;
+    r = normalize(p, index);
+    p = r.node_;
+    index = r.index_;
+  }
+  return r;
+}
+
+// 清空 unrolled_list
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::clear()
+{
+  auto cur = node_->next;
+  while (cur != node_)
+  {
+    auto next = cur->next;
+    destroy_node(cur);
+    cur = next;
+  }
+  node_->unlink();
+  size_ = 0;
+}
+
+// 重置容器大小
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::resize(size_type new_size, const value_type& value)
+{
+  if (new_size < size_)
+  {
+    auto i = begin();
+    mystl::advance(i, new_size);
+    erase(i, end());
+  }
+  else
+  {
+    insert(end(), new_size - size_, value);
+  }
+}
+
+// 将 other 接合于 pos 之前，最多拆分 pos 所在的一个节点
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::splice(const_iterator pos, unrolled_list& x)
+{
+  MYSTL_DEBUG(this != &x);
+  if (x.empty())
+    return;
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_, "unrolled_list<T>'s size too big");
+  base_ptr p = pos.node_;
+  if (pos.index_ != 0)
+    p = split_node(p, pos.index_);
+
+  auto f = x.node_->next;
+  auto l = x.node_->prev;
+  x.node_->unlink();
+  f->prev = p->prev;
+  p->prev->next = f;
+  l->next = p;
+  p->prev = l;
+
+  size_ += x.size_;
+  x.size_ = 0;
+}
+
+// 将一元操作 pred 为 true 的所有元素移除，每个节点内做一次压缩
+template <class T, size_t BlockSize>
+template <class UnaryPredicate>
+void unrolled_list<T, BlockSize>::remove_if(UnaryPredicate pred)
+{
+  auto p = node_->next;
+  while (p != node_)
+  {
+    auto next = p->next;
+    T* d = data(p);
+    size_type keep = 0;
+    for (size_type i = 0; i < p->count; ++i)
+    {
+      if (!pred(d[i]))
+      {
+        if (keep != i)
+          d[keep] = mystl::move(d[i]);
+        ++keep;
+      }
+    }
+    data_allocator::destroy(d + keep, d + p->count);
+    size_ -= p->count - keep;
+    p->count = keep;
+    if (keep == 0)
+    {
+      unlink_node(p);
+      destroy_node(p);
+    }
+    p = next;
+  }
+}
+
+// 将 unrolled_list 反转：反转节点顺序，再反转每个节点内的元素
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::reverse()
+{
+  if (size_ <= 1)
+    return;
+  auto p = node_;
+  do
+  {
+    mystl::swap(p->prev, p->next);
+    T* d = data(p);
+    for (size_type i = 0, j = p->count; i + 1 < j; ++i, --j)
+      mystl::swap(d[i], d[j - 1]);
+    p = p->prev;
+  } while (p != node_);
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 创建哨兵节点
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::init()
+{
+  node_ = base_allocator::allocate(1);
+  node_->unlink();
+  size_ = 0;
+}
+
+// 创建空节点
+template <class T, size_t BlockSize>
+typename unrolled_list<T, BlockSize>::node_ptr
+unrolled_list<T, BlockSize>::create_node()
+{
+  node_ptr p = node_allocator::allocate(1);
+  p->prev = nullptr;
+  p->next = nullptr;
+  p->count = 0;
+  return p;
+}
+
+// 销毁节点及其中的元素
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::destroy_node(base_ptr p)
+{
+  data_allocator::destroy(data(p), data(p) + p->count);
+  node_allocator::deallocate(static_cast<node_ptr>(p));
+}
+
+// 在 pos 之前连接一个节点
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::link_node_before(base_ptr pos, base_ptr node)
+{
+  node->prev = pos->prev;
+  node->next = pos;
+  pos->prev->next = node;
+  pos->prev = node;
+}
+
+// 断开一个节点
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::unlink_node(base_ptr node)
+{
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+}
+
+// 把节点 p 中 [index, count) 的元素移到新节点中，新节点接在 p 之后并返回
+template <class T, size_t BlockSize>
+typename unrolled_list<T, BlockSize>::base_ptr
+unrolled_list<T, BlockSize>::split_node(base_ptr p, size_type index)
+{
+  auto n = create_node();
+  T* src = data(p);
+  try
+  {
+    mystl::uninitialized_move(src + index, src + p->count, n->data());
+  }
+  catch (...)
+  {
+    node_allocator::deallocate(n);
+    throw;
+  }
+  n->count = p->count - index;
+  data_allocator::destroy(src + index, src + p->count);
+  p->count = index;
+  link_node_before(p->next, n);
+  return n;
+}
+
+// 若 p 与后继节点的元素总数不超过半个节点，把后继并入 p
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::merge_next_if_need(base_ptr p)
+{
+  auto next = p->next;
+  if (next == node_ || p->count + next->count > BlockSize / 2)
+    return;
+  mystl::uninitialized_move(data(next), data(next) + next->count, data(p) + p->count);
+  p->count += next->count;
+  unlink_node(next);
+  destroy_node(next);
+}
+
+// 删除后整理节点，返回指向原 index 处（即被删元素之后）元素的迭代器
+template <class T, size_t BlockSize>
+typename unrolled_list<T, BlockSize>::iterator
+unrolled_list<T, BlockSize>::normalize(base_ptr p, size_type index)
+{
+  if (p->count == 0)
+  {
+    auto next = p->next;
+    unlink_node(p);
+    destroy_node(p);
+    return iterator(next, 0);
+  }
+  merge_next_if_need(p);
+  if (index == p->count)
+    return iterator(p->next, 0);
+  return iterator(p, index);
+}
+
+// prepare_append 函数
+// 为在 pos 处插入做准备：在 pos 处拆开节点，或利用前一节点末尾的空间，或在 pos 所在节点之前新建节点，
+// 返回的节点中新元素从末尾开始追加，之后的插入不再移动已有元素
+template <class T, size_t BlockSize>
+typename unrolled_list<T, BlockSize>::base_ptr
+unrolled_list<T, BlockSize>::prepare_append(const_iterator pos)
+{
+  base_ptr p = pos.node_;
+  if (pos.index_ != 0)
+  { // pos 及之后的元素移到新节点中
+    split_node(p, pos.index_);
+    return p;
+  }
+  if (p->prev != node_ && p->prev->count < BlockSize)
+    return p->prev;
+  auto n = create_node();
+  link_node_before(p, n);
+  return n;
+}
+
+// append_node_if_full 函数
+// p 已满时在其后新建节点，并让 p 指向新节点
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::append_node_if_full(base_ptr& p)
+{
+  if (p->count == BlockSize)
+  {
+    auto n = create_node();
+    link_node_before(p->next, n);
+    p = n;
+  }
+}
+
+// discard_if_empty 函数
+// 插入中途抛出异常时，去掉可能留下的空节点
+template <class T, size_t BlockSize>
+void unrolled_list<T, BlockSize>::discard_if_empty(base_ptr p) noexcept
+{
+  if (p->count == 0)
+  {
+    unlink_node(p);
+    destroy_node(p);
+  }
+}
+
+// 重载比较操作符
+template <class T, size_t N>
+bool operator==(const unrolled_list<T, N>& lhs, const unrolled_list<T, N>& rhs)
+{
+  return lhs.size() == rhs.size() && mystl::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+template <class T, size_t N>
+bool operator<(const unrolled_list<T, N>& lhs, const unrolled_list<T, N>& rhs)
+{
+  return mystl::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <class T, size_t N>
+bool operator!=(const unrolled_list<T, N>& lhs, const unrolled_list<T, N>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class T, size_t N>
+bool operator>(const unrolled_list<T, N>& lhs, const unrolled_list<T, N>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class T, size_t N>
+bool operator<=(const unrolled_list<T, N>& lhs, const unrolled_list<T, N>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class T, size_t N>
+bool operator>=(const unrolled_list<T, N>& lhs, const unrolled_list<T, N>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T, size_t N>
+void swap(unrolled_list<T, N>& lhs, unrolled_list<T, N>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_UNROLLED_LIST_H_
+
@@ -137,8 +137,8 @@ struct pair {
     constexpr pair& operator=(pair&& rhs)
         requires(AssignablePair<T1, T2>())
     {
-        first = forward<first_type>(rhs.first);
-        second = forward<second_type>(rhs.second);
+        first = mystl::forward<first_type>(rhs.first);
+        second = mystl::forward<second_type>(rhs.second);
         return *this;
     }
 
@@ -214,4 +214,12 @@ constexpr pair<T1, T2> make_pair(T1&& first, T2&& second) {
                         mystl::forward<T2>(second));
 }
 
+/*----sorted_unique----*/
+
+// 标记输入区间已按比较函数有序且没有重复的键值
+struct sorted_unique_t {
+    explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
 }  // namespace mystl
@@ -0,0 +1,251 @@
+#ifndef MYTINYSTL_BTREE_MAP_TEST_H_
+#define MYTINYSTL_BTREE_MAP_TEST_H_
+
+// btree_map test : 测试 btree_map, btree_multimap 的接口与它们相对于 map 的 emplace, lower_bound 性能
+
+#include "../MyTinySTL/map.h"
+#include "../MyTinySTL/btree_map.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace btree_map_test
+{
+
+// pair 的宏定义
+#define PAIR    mystl::pair<int, int>
+
+// map 的遍历输出
+#define MAP_COUT(m) do { \
+    std::string m_name = #m; \
+    std::cout << " " << m_name << " :"; \
+    for (auto it : m)    std::cout << " <" << it.first << "," << it.second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// map 的函数操作
+#define MAP_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    MAP_COUT(con); \
+} while(0)
+
+// map 的函数值
+#define MAP_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
+} while(0)
+
+// 先 emplace count 个随机元素，再做 count 次 lower_bound，计时两者之和
+#define BTREE_MAP_DO_TEST(con, count) do {                   \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  start = clock();                                           \
+  con<int, int> c;                                           \
+  for (size_t i = 0; i < count; ++i)                         \
+    c.emplace(mystl::make_pair(rand(), rand()));             \
+  long long sum = 0;                                         \
+  for (size_t i = 0; i < count; ++i)                         \
+  {                                                          \
+    auto it = c.lower_bound(rand());                         \
+    if (it != c.end())                                       \
+      sum += it->second;                                     \
+  }                                                          \
+  end = clock();                                             \
+  volatile long long sink = sum; (void)sink;                 \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define BTREE_MAP_TEST(con, name, bcon, bname, len1, len2, len3) \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << name;                                         \
+  BTREE_MAP_DO_TEST(con, len1);                              \
+  BTREE_MAP_DO_TEST(con, len2);                              \
+  BTREE_MAP_DO_TEST(con, len3);                              \
+  std::cout << "\n" << bname;                                \
+  BTREE_MAP_DO_TEST(bcon, len1);                             \
+  BTREE_MAP_DO_TEST(bcon, len2);                             \
+  BTREE_MAP_DO_TEST(bcon, len3);
+
+void btree_map_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[--------------- Run container test : btree_map ----------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  mystl::vector<PAIR> v;
+  for (int i = 0; i < 5; ++i)
+    v.push_back(PAIR(i, i));
+  mystl::btree_map<int, int> m1;
+  mystl::btree_map<int, int> m11;
+  mystl::btree_map<int, int, mystl::greater<int>> m2;
+  mystl::btree_map<int, int> m3(v.begin(), v.end());
+  mystl::btree_map<int, int> m4(v.begin(), v.end());
+  mystl::btree_map<int, int> m5(m3);
+  mystl::btree_map<int, int> m6(std::move(m3));
+  mystl::btree_map<int, int> m7;
+  m7 = m4;
+  mystl::btree_map<int, int> m8;
+  m8 = std::move(m4);
+  mystl::btree_map<int, int> m9{ PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+  mystl::btree_map<int, int> m10;
+  m10 = { PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+
+  for (int i = 5; i > 0; --i)
+  {
+    MAP_FUN_AFTER(m1, m1.emplace(i, i));
+  }
+  MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 0, 0));
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+  MAP_FUN_AFTER(m1, m1.erase(0));
+  MAP_FUN_AFTER(m1, m1.erase(1));
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.end()));
+  for (int i = 0; i < 5; ++i)
+  {
+    MAP_FUN_AFTER(m1, m1.insert(PAIR(i, i)));
+  }
+  MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+  MAP_FUN_AFTER(m1, m1.insert(m1.end(), PAIR(5, 5)));
+  FUN_VALUE(m1.count(1));
+  MAP_VALUE(*m1.find(3));
+  MAP_VALUE(*m1.lower_bound(3));
+  MAP_VALUE(*m1.upper_bound(2));
+  auto first = *m1.equal_range(2).first;
+  auto second = *m1.equal_range(2).second;
+  std::cout << " m1.equal_range(2) : from <" << first.first << ", " << first.second
+    << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+  MAP_FUN_AFTER(m1, m1.erase(1));
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(3)));
+  MAP_FUN_AFTER(m1, m1.clear());
+  MAP_FUN_AFTER(m1, m1.swap(m9));
+  MAP_VALUE(*m1.begin());
+  MAP_VALUE(*m1.rbegin());
+  FUN_VALUE(m1[1]);
+  MAP_FUN_AFTER(m1, m1[1] = 3);
+  FUN_VALUE(m1.at(1));
+  for (int i = 0; i < 1000; ++i)
+    m11.emplace_hint(m11.end(), i, i);
+  for (int i = 0; i < 1000; i += 3)
+    m11.erase(i);
+  FUN_VALUE(m11.size());
+  FUN_VALUE(m11.lower_bound(500)->first);
+  FUN_VALUE(m11.erase(m11.find(500))->first);
+  FUN_VALUE((--m11.end())->first);
+  std::cout << std::boolalpha;
+  FUN_VALUE(m1.empty());
+  std::cout << std::noboolalpha;
+  FUN_VALUE(m1.size());
+  FUN_VALUE(m1.max_size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|  emplace + lookup   |";
+#if LARGER_TEST_DATA_ON
+  BTREE_MAP_TEST(mystl::map, "|     mystl::map      |",
+                 mystl::btree_map, "|  mystl::btree_map   |", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+  BTREE_MAP_TEST(mystl::map, "|     mystl::map      |",
+                 mystl::btree_map, "|  mystl::btree_map   |", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[--------------- End container test : btree_map ----------------]" << std::endl;
+}
+
+void btree_multimap_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------- Run container test : btree_multimap -------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  mystl::vector<PAIR> v;
+  for (int i = 0; i < 5; ++i)
+    v.push_back(PAIR(i, i));
+  mystl::btree_multimap<int, int> m1;
+  mystl::btree_multimap<int, int, mystl::greater<int>> m2;
+  mystl::btree_multimap<int, int> m3(v.begin(), v.end());
+  mystl::btree_multimap<int, int> m4(v.begin(), v.end());
+  mystl::btree_multimap<int, int> m5(m3);
+  mystl::btree_multimap<int, int> m6(std::move(m3));
+  mystl::btree_multimap<int, int> m7;
+  m7 = m4;
+  mystl::btree_multimap<int, int> m8;
+  m8 = std::move(m4);
+  mystl::btree_multimap<int, int> m9{ PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+  mystl::btree_multimap<int, int> m10;
+  m10 = { PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+
+  for (int i = 5; i > 0; --i)
+  {
+    MAP_FUN_AFTER(m1, m1.emplace(i, i));
+  }
+  MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 0, 0));
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+  MAP_FUN_AFTER(m1, m1.erase(0));
+  MAP_FUN_AFTER(m1, m1.erase(1));
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.end()));
+  for (int i = 0; i < 5; ++i)
+  {
+    MAP_FUN_AFTER(m1, m1.insert(mystl::make_pair(i, i)));
+  }
+  MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+  MAP_FUN_AFTER(m1, m1.insert(PAIR(5, 5)));
+  MAP_FUN_AFTER(m1, m1.insert(m1.end(), PAIR(5, 5)));
+  FUN_VALUE(m1.count(3));
+  MAP_VALUE(*m1.find(3));
+  MAP_VALUE(*m1.lower_bound(3));
+  MAP_VALUE(*m1.upper_bound(2));
+  auto first = *m1.equal_range(2).first;
+  auto second = *m1.equal_range(2).second;
+  std::cout << " m1.equal_range(2) : from <" << first.first << ", " << first.second
+    << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+  MAP_FUN_AFTER(m1, m1.erase(1));
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(3)));
+  MAP_FUN_AFTER(m1, m1.clear());
+  MAP_FUN_AFTER(m1, m1.swap(m9));
+  MAP_FUN_AFTER(m1, m1.insert(PAIR(3, 3)));
+  MAP_VALUE(*m1.begin());
+  MAP_VALUE(*m1.rbegin());
+  std::cout << std::boolalpha;
+  FUN_VALUE(m1.empty());
+  std::cout << std::noboolalpha;
+  FUN_VALUE(m1.size());
+  FUN_VALUE(m1.max_size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|  emplace + lookup   |";
+#if LARGER_TEST_DATA_ON
+  BTREE_MAP_TEST(mystl::multimap, "|   mystl::multimap   |",
+                 mystl::btree_multimap, "|mystl::btree_multimap|", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+  BTREE_MAP_TEST(mystl::multimap, "|   mystl::multimap   |",
+                 mystl::btree_multimap, "|mystl::btree_multimap|", SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[------------- End container test : btree_multimap -------------]" << std::endl;
+}
+
+} // namespace btree_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_BTREE_MAP_TEST_H_
+
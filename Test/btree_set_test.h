@@ -0,0 +1,180 @@
+#ifndef MYTINYSTL_BTREE_SET_TEST_H_
+#define MYTINYSTL_BTREE_SET_TEST_H_
+
+// btree_set test : 测试 btree_set, btree_multiset 的接口与它们相对于 set 的 emplace 性能
+
+#include "../MyTinySTL/set.h"
+#include "../MyTinySTL/btree_set.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace btree_set_test
+{
+
+#define BTREE_SET_TEST(con, name, bcon, bname, len1, len2, len3) \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << name;                                         \
+  FUN_TEST_FORMAT1(con, emplace, rand(), len1);              \
+  FUN_TEST_FORMAT1(con, emplace, rand(), len2);              \
+  FUN_TEST_FORMAT1(con, emplace, rand(), len3);              \
+  std::cout << "\n" << bname;                                \
+  FUN_TEST_FORMAT1(bcon, emplace, rand(), len1);             \
+  FUN_TEST_FORMAT1(bcon, emplace, rand(), len2);             \
+  FUN_TEST_FORMAT1(bcon, emplace, rand(), len3);
+
+void btree_set_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[--------------- Run container test : btree_set ----------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int a[] = { 5,4,3,2,1 };
+  mystl::btree_set<int> s1;
+  mystl::btree_set<int, mystl::greater<int>> s2;
+  mystl::btree_set<int> s3(a, a + 5);
+  mystl::btree_set<int> s4(a, a + 5);
+  mystl::btree_set<int> s5(s3);
+  mystl::btree_set<int> s6(std::move(s3));
+  mystl::btree_set<int> s7;
+  s7 = s4;
+  mystl::btree_set<int> s8;
+  s8 = std::move(s4);
+  mystl::btree_set<int> s9{ 1,2,3,4,5 };
+  mystl::btree_set<int> s10;
+  s10 = { 1,2,3,4,5 };
+
+  for (int i = 5; i > 0; --i)
+  {
+    FUN_AFTER(s1, s1.emplace(i));
+  }
+  FUN_AFTER(s1, s1.emplace_hint(s1.begin(), 0));
+  FUN_AFTER(s1, s1.erase(s1.begin()));
+  FUN_AFTER(s1, s1.erase(0));
+  FUN_AFTER(s1, s1.erase(1));
+  FUN_AFTER(s1, s1.erase(s1.begin(), s1.end()));
+  for (int i = 0; i < 5; ++i)
+  {
+    FUN_AFTER(s1, s1.insert(i));
+  }
+  FUN_AFTER(s1, s1.insert(a, a + 5));
+  FUN_AFTER(s1, s1.insert(5));
+  FUN_AFTER(s1, s1.insert(s1.end(), 5));
+  FUN_VALUE(s1.count(5));
+  FUN_VALUE(*s1.find(3));
+  FUN_VALUE(*s1.lower_bound(3));
+  FUN_VALUE(*s1.upper_bound(3));
+  auto first = *s1.equal_range(3).first;
+  auto second = *s1.equal_range(3).second;
+  std::cout << " s1.equal_range(3) : from " << first << " to " << second << std::endl;
+  FUN_AFTER(s1, s1.erase(s1.begin()));
+  FUN_AFTER(s1, s1.erase(1));
+  FUN_AFTER(s1, s1.erase(s1.begin(), s1.find(3)));
+  FUN_AFTER(s1, s1.clear());
+  FUN_AFTER(s1, s1.swap(s5));
+  FUN_VALUE(*s1.begin());
+  FUN_VALUE(*s1.rbegin());
+  std::cout << std::boolalpha;
+  FUN_VALUE(s1.empty());
+  std::cout << std::noboolalpha;
+  FUN_VALUE(s1.size());
+  FUN_VALUE(s1.max_size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|       emplace       |";
+#if LARGER_TEST_DATA_ON
+  BTREE_SET_TEST(mystl::set<int>, "|     mystl::set      |",
+                 mystl::btree_set<int>, "|  mystl::btree_set   |", SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+  BTREE_SET_TEST(mystl::set<int>, "|     mystl::set      |",
+                 mystl::btree_set<int>, "|  mystl::btree_set   |", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[--------------- End container test : btree_set ----------------]" << std::endl;
+}
+
+void btree_multiset_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------- Run container test : btree_multiset -------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int a[] = { 5,4,3,2,1 };
+  mystl::btree_multiset<int> s1;
+  mystl::btree_multiset<int, mystl::greater<int>> s2;
+  mystl::btree_multiset<int> s3(a, a + 5);
+  mystl::btree_multiset<int> s4(a, a + 5);
+  mystl::btree_multiset<int> s5(s3);
+  mystl::btree_multiset<int> s6(std::move(s3));
+  mystl::btree_multiset<int> s7;
+  s7 = s4;
+  mystl::btree_multiset<int> s8;
+  s8 = std::move(s4);
+  mystl::btree_multiset<int> s9{ 1,2,3,4,5 };
+  mystl::btree_multiset<int> s10;
+  s10 = { 1,2,3,4,5 };
+
+  for (int i = 5; i > 0; --i)
+  {
+    FUN_AFTER(s1, s1.emplace(i));
+  }
+  FUN_AFTER(s1, s1.emplace_hint(s1.begin(), 0));
+  FUN_AFTER(s1, s1.erase(s1.begin()));
+  FUN_AFTER(s1, s1.erase(0));
+  FUN_AFTER(s1, s1.erase(1));
+  FUN_AFTER(s1, s1.erase(s1.begin(), s1.end()));
+  for (int i = 0; i < 5; ++i)
+  {
+    FUN_AFTER(s1, s1.insert(i));
+  }
+  FUN_AFTER(s1, s1.insert(a, a + 5));
+  FUN_AFTER(s1, s1.insert(5));
+  FUN_AFTER(s1, s1.insert(s1.end(), 5));
+  FUN_VALUE(s1.count(5));
+  FUN_VALUE(*s1.find(3));
+  FUN_VALUE(*s1.lower_bound(3));
+  FUN_VALUE(*s1.upper_bound(3));
+  auto first = *s1.equal_range(3).first;
+  auto second = *s1.equal_range(3).second;
+  std::cout << " s1.equal_range(3) : from " << first << " to " << second << std::endl;
+  FUN_AFTER(s1, s1.erase(s1.begin()));
+  FUN_AFTER(s1, s1.erase(1));
+  FUN_AFTER(s1, s1.erase(s1.begin(), s1.find(3)));
+  FUN_AFTER(s1, s1.clear());
+  FUN_AFTER(s1, s1.swap(s5));
+  FUN_VALUE(*s1.begin());
+  FUN_VALUE(*s1.rbegin());
+  std::cout << std::boolalpha;
+  FUN_VALUE(s1.empty());
+  std::cout << std::noboolalpha;
+  FUN_VALUE(s1.size());
+  FUN_VALUE(s1.max_size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|       emplace       |";
+#if LARGER_TEST_DATA_ON
+  BTREE_SET_TEST(mystl::multiset<int>, "|   mystl::multiset   |",
+                 mystl::btree_multiset<int>, "|mystl::btree_multiset|", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+  BTREE_SET_TEST(mystl::multiset<int>, "|   mystl::multiset   |",
+                 mystl::btree_multiset<int>, "|mystl::btree_multiset|", SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[------------- End container test : btree_multiset -------------]" << std::endl;
+}
+
+} // namespace btree_set_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_BTREE_SET_TEST_H_
+
@@ -0,0 +1,290 @@
+#ifndef MYTINYSTL_CONCURRENT_MAP_TEST_H_
+#define MYTINYSTL_CONCURRENT_MAP_TEST_H_
+
+// concurrent_map test : 测试 concurrent_map 的接口与它相对于 map + 全局互斥锁的多线程写入性能
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "../MyTinySTL/map.h"
+#include "../MyTinySTL/concurrent_map.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace concurrent_map_test
+{
+
+// pair 的宏定义
+#define PAIR    mystl::pair<int, int>
+
+// map 的遍历输出
+#define MAP_COUT(m) do { \
+    std::string m_name = #m; \
+    std::cout << " " << m_name << " :"; \
+    for (auto it : m)    std::cout << " <" << it.first << "," << it.second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// map 的函数操作
+#define MAP_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    MAP_COUT(con); \
+} while(0)
+
+// map 的函数值
+#define MAP_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
+} while(0)
+
+// 测试用的线程数
+#define CONCURRENT_THREADS 4
+
+// 用 map + 互斥锁模拟只支持全局加锁的容器
+class locked_map
+{
+public:
+  void insert(int key)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.emplace(key, key);
+  }
+  void erase(int key)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.erase(key);
+  }
+
+private:
+  mystl::map<int, int> map_;
+  std::mutex           mutex_;
+};
+
+// CONCURRENT_THREADS 个线程各自插入 len / CONCURRENT_THREADS 个随机元素，再删除其中一半
+// 多线程下 clock 统计的是所有线程的 CPU 时间，因此改用墙上时间
+#define CONCURRENT_MAP_DO_TEST(con, len) do {                          \
+  srand((int)time(0));                                                 \
+  char buf[10];                                                        \
+  mystl::vector<int> v;                                                \
+  v.reserve(len);                                                      \
+  for (size_t i = 0; i < len; ++i)                                     \
+    v.push_back(rand());                                               \
+  con c;                                                               \
+  const size_t per = len / CONCURRENT_THREADS;                         \
+  auto start = std::chrono::steady_clock::now();                       \
+  std::thread workers[CONCURRENT_THREADS];                             \
+  for (int t = 0; t < CONCURRENT_THREADS; ++t)                         \
+  {                                                                    \
+    workers[t] = std::thread([&c, &v, per, t]() {                      \
+      const int* p = v.data() + t * per;                               \
+      for (size_t i = 0; i < per; ++i)                                 \
+        c.insert(p[i]);                                                \
+      for (size_t i = 0; i < per; i += 2)                              \
+        c.erase(p[i]);                                                 \
+    });                                                                \
+  }                                                                    \
+  for (int t = 0; t < CONCURRENT_THREADS; ++t)                         \
+    workers[t].join();                                                 \
+  auto end = std::chrono::steady_clock::now();                         \
+  int n = static_cast<int>(std::chrono::duration_cast<                 \
+      std::chrono::milliseconds>(end - start).count());                \
+  std::snprintf(buf, sizeof(buf), "%d", n);                            \
+  std::string t = buf;                                                 \
+  t += "ms    |";                                                      \
+  std::cout << std::setw(WIDE) << t;                                   \
+} while(0)
+
+#define CONCURRENT_MAP_TEST(con, name, ccon, cname, len1, len2, len3) \
+  TEST_LEN(len1, len2, len3, WIDE);                                  \
+  std::cout << name;                                                 \
+  CONCURRENT_MAP_DO_TEST(con, len1);                                 \
+  CONCURRENT_MAP_DO_TEST(con, len2);                                 \
+  CONCURRENT_MAP_DO_TEST(con, len3);                                 \
+  std::cout << "\n" << cname;                                        \
+  CONCURRENT_MAP_DO_TEST(ccon, len1);                                \
+  CONCURRENT_MAP_DO_TEST(ccon, len2);                                \
+  CONCURRENT_MAP_DO_TEST(ccon, len3);
+
+// 供性能测试使用，接口与 locked_map 一致
+class skiplist_map
+{
+public:
+  void insert(int key) { map_.emplace(key, key); }
+  void erase(int key)  { map_.erase(key); }
+
+private:
+  mystl::concurrent_map<int, int> map_;
+};
+
+TEST(concurrent_map_reclaim_test)
+{
+  // 多个线程分轮持续插入、删除，已删除的节点会自动回收，不需要调用 reclaim
+  // 每一轮结束时所有线程都不在容器的操作中，全局 epoch 在每一轮中至少推进一次，
+  // 所以任一时刻积压的节点不会超过最近四轮删除的个数
+  const int rounds = 50;
+  const int per_round = 500;
+  mystl::concurrent_map<int, int> m;
+  std::atomic<int> arrived(0);
+  std::atomic<size_t> max_retired(0);
+  std::thread workers[CONCURRENT_THREADS];
+  for (int t = 0; t < CONCURRENT_THREADS; ++t)
+  {
+    workers[t] = std::thread([&m, &arrived, &max_retired, t]() {
+      for (int r = 0; r < rounds; ++r)
+      {
+        for (int i = 0; i < per_round; ++i)
+        {
+          const int key = t * 1000 + i % 100;
+          m.emplace(key, i);
+          m.erase(key);
+        }
+        // 等待所有线程完成这一轮，最后到达的线程记录积压的节点数
+        if (arrived.fetch_add(1) + 1 == (r + 1) * CONCURRENT_THREADS)
+        {
+          if (m.retired_size() > max_retired.load())
+            max_retired.store(m.retired_size());
+        }
+        while (arrived.load() < (r + 1) * CONCURRENT_THREADS)
+          std::this_thread::yield();
+      }
+      m.emplace(t * 1000, t);
+    });
+  }
+  for (int t = 0; t < CONCURRENT_THREADS; ++t)
+    workers[t].join();
+  EXPECT_EQ(static_cast<size_t>(CONCURRENT_THREADS), m.size());
+  EXPECT_TRUE(max_retired.load() <= static_cast<size_t>(4 * per_round * CONCURRENT_THREADS));
+  // 没有线程登记时，再删除几轮就会把积压的节点全部释放
+  for (int i = 0; i < 4 * CONCURRENT_MAP_RECLAIM_INTERVAL; ++i)
+  {
+    m.emplace(-1, i);
+    m.erase(-1);
+  }
+  EXPECT_TRUE(m.retired_size() <= static_cast<size_t>(3 * CONCURRENT_MAP_RECLAIM_INTERVAL));
+
+  // 持有 guard 期间，已删除元素的迭代器仍然有效，回收被推迟
+  {
+    mystl::concurrent_map<int, int>::guard g(m);
+    auto it = m.find(1000);
+    m.erase(1000);
+    for (int i = 0; i < 10 * CONCURRENT_MAP_RECLAIM_INTERVAL; ++i)
+    {
+      m.emplace(-1, i);
+      m.erase(-1);
+    }
+    EXPECT_EQ(1000, it->first);
+    EXPECT_EQ(1, it->second);
+    EXPECT_TRUE(m.retired_size() > static_cast<size_t>(3 * CONCURRENT_MAP_RECLAIM_INTERVAL));
+  }
+  for (int i = 0; i < 4 * CONCURRENT_MAP_RECLAIM_INTERVAL; ++i)
+  {
+    m.emplace(-1, i);
+    m.erase(-1);
+  }
+  EXPECT_TRUE(m.retired_size() <= static_cast<size_t>(3 * CONCURRENT_MAP_RECLAIM_INTERVAL));
+  EXPECT_FALSE(m.contains(1000));
+  EXPECT_TRUE(m.contains(0));
+  m.reclaim();
+  EXPECT_EQ(0u, m.retired_size());
+}
+
+void concurrent_map_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------- Run container test : concurrent_map -------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  mystl::vector<PAIR> v;
+  for (int i = 0; i < 5; ++i)
+    v.push_back(PAIR(i, i));
+  mystl::concurrent_map<int, int> m1;
+  mystl::concurrent_map<int, int, mystl::greater<int>> m2;
+  mystl::concurrent_map<int, int> m3(v.begin(), v.end());
+  mystl::concurrent_map<int, int> m4{ PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+
+  for (int i = 5; i > 0; --i)
+  {
+    MAP_FUN_AFTER(m1, m1.emplace(i, i));
+  }
+  MAP_FUN_AFTER(m1, m1.emplace(3, 0));
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+  MAP_FUN_AFTER(m1, m1.erase(0));
+  MAP_FUN_AFTER(m1, m1.erase(3));
+  MAP_FUN_AFTER(m1, m1.insert(PAIR(3, 3)));
+  MAP_FUN_AFTER(m1, m1.insert({ PAIR(9,9),PAIR(7,7),PAIR(3,0),PAIR(7,0),PAIR(-1,-1) }));
+  MAP_FUN_AFTER(m2, m2.insert(v.begin(), v.end()));
+  FUN_VALUE(m1.count(1));
+  FUN_VALUE(m1.count(2));
+  MAP_VALUE(*m1.find(3));
+  MAP_VALUE(*m1.lower_bound(6));
+  MAP_VALUE(*m1.upper_bound(3));
+  MAP_VALUE(*m2.lower_bound(2));
+  MAP_FUN_AFTER(m1, m1.reclaim());
+  MAP_FUN_AFTER(m1, m1.swap(m3));
+  MAP_FUN_AFTER(m1, m1.clear());
+  MAP_FUN_AFTER(m4, m4.find(2)->second = 4);
+  // 多个线程同时插入、删除，每个线程负责 [t * 1000, t * 1000 + 1000)，最后留下其中的偶数
+  {
+    mystl::concurrent_map<int, int> mc;
+    std::thread workers[CONCURRENT_THREADS];
+    for (int t = 0; t < CONCURRENT_THREADS; ++t)
+    {
+      workers[t] = std::thread([&mc, t]() {
+        for (int i = t * 1000; i < t * 1000 + 1000; ++i)
+          mc.emplace(i, t);
+        for (int i = t * 1000 + 1; i < t * 1000 + 1000; i += 2)
+          mc.erase(i);
+      });
+    }
+    for (int t = 0; t < CONCURRENT_THREADS; ++t)
+      workers[t].join();
+    FUN_VALUE(mc.size());
+    int expect = 0;
+    bool ordered = true;
+    for (auto& it : mc)
+    {
+      ordered = ordered && it.first == expect && it.second == expect / 1000;
+      expect += 2;
+    }
+    std::cout << std::boolalpha;
+    FUN_VALUE(ordered);
+    std::cout << std::noboolalpha;
+    MAP_VALUE(*mc.lower_bound(1999));
+  }
+  std::cout << std::boolalpha;
+  FUN_VALUE(m1.empty());
+  FUN_VALUE(m4.contains(3));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(m3.size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "| 4 threads ins + del |";
+#if LARGER_TEST_DATA_ON
+  CONCURRENT_MAP_TEST(locked_map, "|  map + std::mutex   |",
+                      skiplist_map, "|mystl::concurrent_map|", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+  CONCURRENT_MAP_TEST(locked_map, "|  map + std::mutex   |",
+                      skiplist_map, "|mystl::concurrent_map|", SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[------------- End container test : concurrent_map -------------]" << std::endl;
+}
+
+} // namespace concurrent_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_CONCURRENT_MAP_TEST_H_
+
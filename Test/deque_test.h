@@ -1,11 +1,13 @@
 #ifndef MYTINYSTL_DEQUE_TEST_H_
 #define MYTINYSTL_DEQUE_TEST_H_
 
-// deque test : 测试 deque 的接口和 push_front/push_back 的性能
+// deque test : 测试 deque 的接口和 push_front/push_back, operator[], sort 的性能
 
 #include <deque>
+#include <algorithm>
 
 #include "../MyTinySTL/deque.h"
+#include "../MyTinySTL/algorithm.h"
 #include "test.h"
 
 namespace mystl
@@ -15,6 +17,107 @@ namespace test
 namespace deque_test
 {
 
+// 检查 d 中的元素依次为 first, first + 1, ...
+inline bool deque_is_iota(const mystl::deque<int>& d, int first)
+{
+  for (auto it = d.begin(); it != d.end(); ++it, ++first)
+  {
+    if (*it != first)
+      return false;
+  }
+  return true;
+}
+
+TEST(deque_shrink_to_fit_test)
+{
+  const size_t buf = mystl::deque_buf_size<int>::value;
+  mystl::deque<int> d;
+  for (int i = 0; i < 200000; ++i)
+    d.push_back(i);
+  EXPECT_TRUE(d.capacity() >= d.size());
+  const size_t big_map = d.map_size();
+  EXPECT_TRUE(big_map > 64u);
+
+  // 头尾各弹出一段，只留下中间的 1000 个元素
+  for (int i = 0; i < 100000; ++i)
+    d.pop_front();
+  while (d.size() > 1000)
+    d.pop_back();
+  EXPECT_EQ(1000u, d.size());
+  EXPECT_TRUE(deque_is_iota(d, 100000));
+  // 弹出时会释放空出的缓冲区，已分配的缓冲区只覆盖剩下的元素
+  EXPECT_TRUE(d.capacity() <= (1000 / buf + 2) * buf);
+#if DEQUE_AUTO_TRIM
+  EXPECT_TRUE(d.map_size() < big_map);
+#else
+  EXPECT_EQ(big_map, d.map_size());
+#endif
+
+  d.shrink_to_fit();
+  EXPECT_EQ(1000u, d.size());
+  EXPECT_TRUE(deque_is_iota(d, 100000));
+  EXPECT_TRUE(d.capacity() >= d.size());
+  EXPECT_TRUE(d.capacity() <= (1000 / buf + 2) * buf);
+  EXPECT_TRUE(d.map_size() <= 1000 / buf + 4 || d.map_size() == DEQUE_MAP_INIT_SIZE);
+
+  // 收缩后仍能在两端继续增长
+  for (int i = 0; i < 5000; ++i)
+  {
+    d.push_front(99999 - i);
+    d.push_back(101000 + i);
+  }
+  EXPECT_EQ(11000u, d.size());
+  EXPECT_TRUE(deque_is_iota(d, 95000));
+  EXPECT_EQ(95000, d[0]);
+  EXPECT_EQ(105999, d[10999]);
+
+  d.clear();
+  EXPECT_TRUE(d.empty());
+  EXPECT_TRUE(d.capacity() <= buf);
+  EXPECT_EQ(static_cast<size_t>(DEQUE_MAP_INIT_SIZE), d.map_size());
+}
+
+TEST(deque_auto_trim_test)
+{
+  const size_t buf = mystl::deque_buf_size<int>::value;
+  for (int front = 0; front < 2; ++front)
+  {
+    mystl::deque<int> d;
+    for (int i = 0; i < 200000; ++i)
+      d.push_back(i);
+#if !DEQUE_AUTO_TRIM
+    const size_t big_map = d.map_size();
+#endif
+    int first = 0;
+    while (d.size() > 100)
+    {
+      if (front)
+      {
+        d.pop_front();
+        ++first;
+      }
+      else
+      {
+        d.pop_back();
+      }
+    }
+    EXPECT_EQ(100u, d.size());
+    EXPECT_TRUE(deque_is_iota(d, first));
+    EXPECT_TRUE(d.capacity() <= 2 * buf);
+#if DEQUE_AUTO_TRIM
+    // 剩下的元素最多跨两个缓冲区，map 会一直收缩到不再满足收缩条件
+    EXPECT_TRUE(d.map_size() <= static_cast<size_t>(DEQUE_MAP_INIT_SIZE << 1));
+#else
+    EXPECT_EQ(big_map, d.map_size());
+#endif
+    while (!d.empty())
+      d.pop_back();
+    for (int i = 0; i < 3000; ++i)
+      d.push_back(i);
+    EXPECT_TRUE(deque_is_iota(d, 0));
+  }
+}
+
 void deque_test()
 {
   std::cout << "[===============================================================]" << std::endl;
@@ -65,6 +168,8 @@ void deque_test()
   FUN_VALUE(d1.back());
   FUN_VALUE(d1.at(1));
   FUN_VALUE(d1[2]);
+  FUN_VALUE(*(d1.begin() + 3));
+  FUN_VALUE(d1.end() - d1.begin());
   std::cout << std::boolalpha;
   FUN_VALUE(d1.empty());
   std::cout << std::noboolalpha;
@@ -87,6 +192,22 @@ void deque_test()
   CON_TEST_P1(deque<int>, push_back, rand(), SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
 #else
   CON_TEST_P1(deque<int>, push_back, rand(), SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|     operator[]      |";
+#if LARGER_TEST_DATA_ON
+  DEQUE_INDEX_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+  DEQUE_INDEX_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|         sort        |";
+#if LARGER_TEST_DATA_ON
+  DEQUE_SORT_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+  DEQUE_SORT_TEST(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
 #endif
   std::cout << std::endl;
   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
@@ -0,0 +1,196 @@
+#ifndef MYTINYSTL_FLAT_HASH_MAP_TEST_H_
+#define MYTINYSTL_FLAT_HASH_MAP_TEST_H_
+
+// flat_hash_map test : 测试 flat_hash_map 的接口与它相对于 unordered_map 的 emplace, find 性能
+
+#include "../MyTinySTL/unordered_map.h"
+#include "../MyTinySTL/flat_hash_map.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace flat_hash_map_test
+{
+
+// pair 的宏定义
+#define PAIR    mystl::pair<int, int>
+
+// map 的遍历输出
+#define MAP_COUT(m) do { \
+    std::string m_name = #m; \
+    std::cout << " " << m_name << " :"; \
+    for (auto it : m)    std::cout << " <" << it.first << "," << it.second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// map 的函数操作
+#define MAP_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    MAP_COUT(con); \
+} while(0)
+
+// map 的函数值
+#define MAP_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
+} while(0)
+
+// 先 emplace len 个随机元素，再做 len 次 find，计时两者之和
+#define FLAT_HASH_MAP_DO_TEST(con, len) do {                 \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  start = clock();                                           \
+  con<int, int> c;                                           \
+  for (size_t i = 0; i < len; ++i)                           \
+    c.emplace(mystl::make_pair(rand(), rand()));             \
+  long long sum = 0;                                         \
+  for (size_t i = 0; i < len; ++i)                           \
+  {                                                          \
+    auto it = c.find(rand());                                \
+    if (it != c.end())                                       \
+      sum += it->second;                                     \
+  }                                                          \
+  end = clock();                                             \
+  volatile long long sink = sum; (void)sink;                 \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define FLAT_HASH_MAP_TEST(con, name, fcon, fname, len1, len2, len3) \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << name;                                         \
+  FLAT_HASH_MAP_DO_TEST(con, len1);                          \
+  FLAT_HASH_MAP_DO_TEST(con, len2);                          \
+  FLAT_HASH_MAP_DO_TEST(con, len3);                          \
+  std::cout << "\n" << fname;                                \
+  FLAT_HASH_MAP_DO_TEST(fcon, len1);                         \
+  FLAT_HASH_MAP_DO_TEST(fcon, len2);                         \
+  FLAT_HASH_MAP_DO_TEST(fcon, len3);
+
+TEST(flat_hash_map_rehash_test)
+{
+  // 空表与清空后的表也能 rehash / reserve
+  mystl::flat_hash_map<int, int> m;
+  m.rehash(100);
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.bucket_count() >= 100u);
+  const auto buckets = m.bucket_count();
+  for (int i = 0; i < 80; ++i)
+    m.emplace(i, i * 2);
+  EXPECT_EQ(buckets, m.bucket_count());
+
+  mystl::flat_hash_map<int, int> m2;
+  m2.reserve(200);
+  const auto reserved = m2.bucket_count();
+  EXPECT_TRUE(reserved >= 200u);
+  for (int i = 0; i < 200; ++i)
+    m2.emplace(i, i);
+  EXPECT_EQ(reserved, m2.bucket_count());
+
+  for (int i = 0; i < 1000; ++i)
+    m.emplace(i, i * 2);
+  m.clear();
+  m.rehash(10);
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.bucket_count() >= 10u);
+  m.rehash(0);
+  EXPECT_EQ(0u, m.bucket_count());
+  m.reserve(50);
+  EXPECT_TRUE(m.bucket_count() >= 50u);
+  m.rehash(1);
+  for (int i = 0; i < 50; ++i)
+    m.emplace(i, i * 3);
+  EXPECT_EQ(50u, m.size());
+  for (int i = 0; i < 50; ++i)
+    EXPECT_EQ(i * 3, m.at(i));
+}
+
+void flat_hash_map_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[-------------- Run container test : flat_hash_map -------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  mystl::vector<PAIR> v;
+  for (int i = 0; i < 5; ++i)
+    v.push_back(PAIR(5 - i, 5 - i));
+  mystl::flat_hash_map<int, int> m1;
+  mystl::flat_hash_map<int, int> m2(520);
+  mystl::flat_hash_map<int, int> m3(v.begin(), v.end());
+  mystl::flat_hash_map<int, int> m4(m3);
+  mystl::flat_hash_map<int, int> m5(std::move(m4));
+  mystl::flat_hash_map<int, int> m6;
+  m6 = m3;
+  mystl::flat_hash_map<int, int> m7{ PAIR(1,1),PAIR(2,3),PAIR(3,3) };
+  mystl::flat_hash_map<int, int> m8;
+  m8 = { PAIR(1,1),PAIR(2,3),PAIR(3,3) };
+  mystl::flat_hash_map<int, int> m9;
+
+  MAP_FUN_AFTER(m1, m1.emplace(1, 1));
+  MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 1, 2));
+  MAP_FUN_AFTER(m1, m1.try_emplace(1, 9));
+  MAP_FUN_AFTER(m1, m1.try_emplace(7, 7));
+  MAP_FUN_AFTER(m1, m1.insert_or_assign(7, 8));
+  MAP_FUN_AFTER(m1, m1.insert(PAIR(2, 2)));
+  MAP_FUN_AFTER(m1, m1.insert(m1.end(), PAIR(3, 3)));
+  MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+  MAP_FUN_AFTER(m1, m1.erase(m1.find(2)));
+  MAP_FUN_AFTER(m1, m1.erase(1));
+  FUN_VALUE(m1.count(3));
+  FUN_VALUE(m1.find(3)->second);
+  FUN_VALUE(m1.at(7));
+  FUN_VALUE(m1[4]);
+  MAP_FUN_AFTER(m1, m1[6] = 6);
+  MAP_FUN_AFTER(m1, m1.swap(m7));
+  MAP_FUN_AFTER(m1, m1.clear());
+  for (int i = 0; i < 1000; ++i)
+    m9.emplace(i, i);
+  for (int i = 0; i < 1000; i += 3)
+    m9.erase(i);
+  FUN_VALUE(m9.size());
+  FUN_VALUE(m9.count(300));
+  FUN_VALUE(m9.find(500)->second);
+  FUN_VALUE(m9.bucket_count());
+  FUN_VALUE(m9.max_load_factor());
+  std::cout << std::boolalpha;
+  FUN_VALUE(m1.empty());
+  FUN_VALUE((m3 == m5));
+  FUN_VALUE((m7 == m8));
+  FUN_VALUE((m2 != m6));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(m2.bucket_count());
+  FUN_VALUE(m6.size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|   emplace + find    |";
+#if LARGER_TEST_DATA_ON
+  FLAT_HASH_MAP_TEST(mystl::unordered_map, "| mystl::unordered_map|",
+                     mystl::flat_hash_map, "| mystl::flat_hash_map|", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+  FLAT_HASH_MAP_TEST(mystl::unordered_map, "| mystl::unordered_map|",
+                     mystl::flat_hash_map, "| mystl::flat_hash_map|", SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[-------------- End container test : flat_hash_map -------------]" << std::endl;
+}
+
+} // namespace flat_hash_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_HASH_MAP_TEST_H_
+
@@ -0,0 +1,124 @@
+#ifndef MYTINYSTL_FLAT_HASH_SET_TEST_H_
+#define MYTINYSTL_FLAT_HASH_SET_TEST_H_
+
+// flat_hash_set test : 测试 flat_hash_set 的接口与它相对于 unordered_set 的 emplace 性能
+
+#include "../MyTinySTL/unordered_set.h"
+#include "../MyTinySTL/flat_hash_set.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace flat_hash_set_test
+{
+
+#define FLAT_HASH_SET_TEST(con, name, fcon, fname, len1, len2, len3) \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << name;                                         \
+  FUN_TEST_FORMAT1(con, emplace, rand(), len1);              \
+  FUN_TEST_FORMAT1(con, emplace, rand(), len2);              \
+  FUN_TEST_FORMAT1(con, emplace, rand(), len3);              \
+  std::cout << "\n" << fname;                                \
+  FUN_TEST_FORMAT1(fcon, emplace, rand(), len1);             \
+  FUN_TEST_FORMAT1(fcon, emplace, rand(), len2);             \
+  FUN_TEST_FORMAT1(fcon, emplace, rand(), len3);
+
+TEST(flat_hash_set_rehash_test)
+{
+  // 空表与清空后的表也能 rehash / reserve
+  mystl::flat_hash_set<int> s;
+  s.rehash(1);
+  EXPECT_TRUE(s.empty());
+  EXPECT_TRUE(s.bucket_count() >= 1u);
+  s.reserve(300);
+  const auto reserved = s.bucket_count();
+  EXPECT_TRUE(reserved >= 300u);
+  for (int i = 0; i < 300; ++i)
+    s.insert(i);
+  EXPECT_EQ(reserved, s.bucket_count());
+
+  s.clear();
+  s.rehash(64);
+  EXPECT_TRUE(s.empty());
+  EXPECT_TRUE(s.bucket_count() >= 64u);
+  s.reserve(7);
+  for (int i = 0; i < 100; ++i)
+    s.insert(i * 7);
+  EXPECT_EQ(100u, s.size());
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(1u, s.count(i * 7));
+  EXPECT_EQ(0u, s.count(1));
+}
+
+void flat_hash_set_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[-------------- Run container test : flat_hash_set -------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int a[] = { 5,4,3,2,1 };
+  mystl::flat_hash_set<int> s1;
+  mystl::flat_hash_set<int> s2(520);
+  mystl::flat_hash_set<int> s3(a, a + 5);
+  mystl::flat_hash_set<int> s4(s3);
+  mystl::flat_hash_set<int> s5(std::move(s4));
+  mystl::flat_hash_set<int> s6;
+  s6 = s3;
+  mystl::flat_hash_set<int> s7{ 1,2,3,4,5 };
+  mystl::flat_hash_set<int> s8;
+  s8 = { 1,2,3,4,5 };
+
+  for (int i = 5; i > 0; --i)
+  {
+    FUN_AFTER(s1, s1.emplace(i));
+  }
+  FUN_AFTER(s1, s1.emplace_hint(s1.begin(), 0));
+  FUN_AFTER(s1, s1.erase(s1.find(0)));
+  FUN_AFTER(s1, s1.erase(1));
+  FUN_AFTER(s1, s1.erase(s1.begin(), s1.end()));
+  for (int i = 0; i < 5; ++i)
+  {
+    FUN_AFTER(s1, s1.insert(i));
+  }
+  FUN_AFTER(s1, s1.insert(a, a + 5));
+  FUN_AFTER(s1, s1.insert(s1.end(), 5));
+  FUN_VALUE(s1.count(5));
+  FUN_VALUE(*s1.find(3));
+  FUN_AFTER(s1, s1.swap(s2));
+  FUN_AFTER(s1, s1.reserve(1000));
+  FUN_VALUE(s1.bucket_count());
+  FUN_AFTER(s1, s1.rehash(0));
+  FUN_VALUE(s1.bucket_count());
+  std::cout << std::boolalpha;
+  FUN_VALUE(s1.empty());
+  FUN_VALUE((s3 == s7));
+  FUN_VALUE((s5 == s8));
+  FUN_VALUE((s2 != s6));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(s2.size());
+  FUN_VALUE(s2.load_factor());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|       emplace       |";
+#if LARGER_TEST_DATA_ON
+  FLAT_HASH_SET_TEST(mystl::unordered_set<int>, "| mystl::unordered_set|",
+                     mystl::flat_hash_set<int>, "| mystl::flat_hash_set|", SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+  FLAT_HASH_SET_TEST(mystl::unordered_set<int>, "| mystl::unordered_set|",
+                     mystl::flat_hash_set<int>, "| mystl::flat_hash_set|", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[-------------- End container test : flat_hash_set -------------]" << std::endl;
+}
+
+} // namespace flat_hash_set_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_HASH_SET_TEST_H_
+
@@ -0,0 +1,211 @@
+#ifndef MYTINYSTL_FLAT_MAP_TEST_H_
+#define MYTINYSTL_FLAT_MAP_TEST_H_
+
+// flat_map test : 测试 flat_map 的接口与它相对于 map 的批量构建、查找性能
+
+#include "../MyTinySTL/map.h"
+#include "../MyTinySTL/flat_map.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace flat_map_test
+{
+
+// pair 的宏定义
+#define PAIR    mystl::pair<int, int>
+
+// map 的遍历输出
+#define MAP_COUT(m) do { \
+    std::string m_name = #m; \
+    std::cout << " " << m_name << " :"; \
+    for (auto it : m)    std::cout << " <" << it.first << "," << it.second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// map 的函数操作
+#define MAP_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    MAP_COUT(con); \
+} while(0)
+
+// map 的函数值
+#define MAP_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
+} while(0)
+
+// 用 count 个随机元素一次性构建容器，再做 count 次 find，计时两者之和
+#define FLAT_MAP_DO_TEST(con, count) do {                    \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  mystl::vector<PAIR> v;                                     \
+  v.reserve(count);                                          \
+  for (size_t i = 0; i < count; ++i)                         \
+    v.emplace_back(rand(), rand());                          \
+  start = clock();                                           \
+  con<int, int> c(v.begin(), v.end());                       \
+  long long sum = 0;                                         \
+  for (size_t i = 0; i < count; ++i)                         \
+  {                                                          \
+    auto it = c.find(rand());                                \
+    if (it != c.end())                                       \
+      sum += it->second;                                     \
+  }                                                          \
+  end = clock();                                             \
+  volatile long long sink = sum; (void)sink;                 \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define FLAT_MAP_TEST(con, name, fcon, fname, len1, len2, len3) \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << name;                                         \
+  FLAT_MAP_DO_TEST(con, len1);                               \
+  FLAT_MAP_DO_TEST(con, len2);                               \
+  FLAT_MAP_DO_TEST(con, len3);                               \
+  std::cout << "\n" << fname;                                \
+  FLAT_MAP_DO_TEST(fcon, len1);                              \
+  FLAT_MAP_DO_TEST(fcon, len2);                              \
+  FLAT_MAP_DO_TEST(fcon, len3);
+
+// 超过 kSmallSectionSize 个元素的批量插入与区间构造，排序会走到 intro_sort 之后的插入排序
+// 键值重复时保留哪一个元素没有规定，所以有重复时只比较键值
+TEST(flat_map_bulk_insert_test)
+{
+  mystl::vector<PAIR> v;
+  for (int i = 0; i < 200; ++i)
+    v.push_back(PAIR((i * 7919) % 1000, i));  // 200 个互不相同的无序键值
+  mystl::map<int, int> expect(v.begin(), v.end());
+  mystl::flat_map<int, int> m1(v.begin(), v.end());
+  mystl::vector<int> ek, ev, ak, av;
+  for (auto& p : expect) { ek.push_back(p.first); ev.push_back(p.second); }
+  for (auto& p : m1)     { ak.push_back(p.first); av.push_back(p.second); }
+  EXPECT_EQ(expect.size(), m1.size());
+  EXPECT_CON_EQ(ek, ak);
+  EXPECT_CON_EQ(ev, av);
+
+  mystl::vector<PAIR> w;
+  for (int i = 0; i < 600; ++i)
+    w.push_back(PAIR((i * 37) % 257, i));     // 含大量重复键值
+  mystl::flat_map<int, int> m2{ PAIR(-3, 0), PAIR(5, 0), PAIR(1000, 0) };
+  m2.insert(w.begin(), w.end());
+  mystl::map<int, int> expect2{ PAIR(-3, 0), PAIR(5, 0), PAIR(1000, 0) };
+  expect2.insert(w.begin(), w.end());
+  ek.clear(); ak.clear();
+  for (auto& p : expect2) ek.push_back(p.first);
+  for (auto& p : m2)      ak.push_back(p.first);
+  EXPECT_EQ(expect2.size(), m2.size());
+  EXPECT_CON_EQ(ek, ak);
+
+  mystl::flat_map<int, int> m3(w.begin(), w.end());
+  mystl::map<int, int> expect3(w.begin(), w.end());
+  ek.clear(); ak.clear();
+  for (auto& p : expect3) ek.push_back(p.first);
+  for (auto& p : m3)      ak.push_back(p.first);
+  EXPECT_EQ(expect3.size(), m3.size());
+  EXPECT_CON_EQ(ek, ak);
+}
+
+void flat_map_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[---------------- Run container test : flat_map ----------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  mystl::vector<PAIR> v;
+  for (int i = 0; i < 5; ++i)
+    v.push_back(PAIR(i, i));
+  mystl::flat_map<int, int> m1;
+  mystl::flat_map<int, int, mystl::greater<int>> m2;
+  mystl::flat_map<int, int> m3(v.begin(), v.end());
+  mystl::flat_map<int, int> m4(v.begin(), v.end());
+  mystl::flat_map<int, int> m5(m3);
+  mystl::flat_map<int, int> m6(std::move(m3));
+  mystl::flat_map<int, int> m7;
+  m7 = m4;
+  mystl::flat_map<int, int> m8;
+  m8 = std::move(m4);
+  mystl::flat_map<int, int> m9{ PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+  mystl::flat_map<int, int> m10;
+  m10 = { PAIR(1,1),PAIR(3,2),PAIR(2,3) };
+  mystl::flat_map<int, int> m11(mystl::sorted_unique, v.begin(), v.end());
+
+  for (int i = 5; i > 0; --i)
+  {
+    MAP_FUN_AFTER(m1, m1.emplace(i, i));
+  }
+  MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 0, 0));
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+  MAP_FUN_AFTER(m1, m1.erase(0));
+  MAP_FUN_AFTER(m1, m1.erase(1));
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.end()));
+  for (int i = 0; i < 5; ++i)
+  {
+    MAP_FUN_AFTER(m1, m1.insert(PAIR(i, i)));
+  }
+  MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+  MAP_FUN_AFTER(m1, m1.insert(m1.end(), PAIR(5, 5)));
+  MAP_FUN_AFTER(m1, m1.insert({ PAIR(9,9),PAIR(7,7),PAIR(3,0),PAIR(7,0),PAIR(-1,-1) }));
+  MAP_FUN_AFTER(m11, m11.insert(mystl::sorted_unique, m9.begin(), m9.end()));
+  MAP_FUN_AFTER(m11, m11.insert(mystl::sorted_unique, m1.find(7), m1.end()));
+  FUN_VALUE(m1.count(1));
+  MAP_VALUE(*m1.find(3));
+  MAP_VALUE(*m1.lower_bound(3));
+  MAP_VALUE(*m1.upper_bound(2));
+  auto first = *m1.equal_range(2).first;
+  auto second = *m1.equal_range(2).second;
+  std::cout << " m1.equal_range(2) : from <" << first.first << ", " << first.second
+    << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+  MAP_FUN_AFTER(m1, m1.erase(1));
+  MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(3)));
+  MAP_FUN_AFTER(m1, m1.clear());
+  MAP_FUN_AFTER(m1, m1.swap(m9));
+  MAP_VALUE(*m1.begin());
+  MAP_VALUE(*m1.rbegin());
+  FUN_VALUE(m1[1]);
+  MAP_FUN_AFTER(m1, m1[1] = 3);
+  FUN_VALUE(m1.at(1));
+  std::cout << std::boolalpha;
+  FUN_VALUE(m1.empty());
+  FUN_VALUE(m1.contains(3));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(m1.size());
+  FUN_VALUE(m1.max_size());
+  MAP_FUN_AFTER(m1, m1.shrink_to_fit());
+  FUN_VALUE(m1.capacity());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|    build + find     |";
+#if LARGER_TEST_DATA_ON
+  FLAT_MAP_TEST(mystl::map, "|     mystl::map      |",
+                mystl::flat_map, "|   mystl::flat_map   |", SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+  FLAT_MAP_TEST(mystl::map, "|     mystl::map      |",
+                mystl::flat_map, "|   mystl::flat_map   |", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[---------------- End container test : flat_map ----------------]" << std::endl;
+}
+
+} // namespace flat_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_MAP_TEST_H_
+
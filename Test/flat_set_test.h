@@ -0,0 +1,164 @@
+#ifndef MYTINYSTL_FLAT_SET_TEST_H_
+#define MYTINYSTL_FLAT_SET_TEST_H_
+
+// flat_set test : 测试 flat_set 的接口与它相对于 set 的批量构建、查找性能
+
+#include "../MyTinySTL/set.h"
+#include "../MyTinySTL/flat_set.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace flat_set_test
+{
+
+// 用 len 个随机元素一次性构建容器，再做 len 次 count，计时两者之和
+#define FLAT_SET_DO_TEST(con, len) do {                      \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  mystl::vector<int> v;                                      \
+  v.reserve(len);                                            \
+  for (size_t i = 0; i < len; ++i)                           \
+    v.push_back(rand());                                     \
+  start = clock();                                           \
+  con c(v.begin(), v.end());                                 \
+  long long sum = 0;                                         \
+  for (size_t i = 0; i < len; ++i)                           \
+    sum += c.count(rand());                                  \
+  end = clock();                                             \
+  volatile long long sink = sum; (void)sink;                 \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define FLAT_SET_TEST(con, name, fcon, fname, len1, len2, len3) \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << name;                                         \
+  FLAT_SET_DO_TEST(con, len1);                               \
+  FLAT_SET_DO_TEST(con, len2);                               \
+  FLAT_SET_DO_TEST(con, len3);                               \
+  std::cout << "\n" << fname;                                \
+  FLAT_SET_DO_TEST(fcon, len1);                              \
+  FLAT_SET_DO_TEST(fcon, len2);                              \
+  FLAT_SET_DO_TEST(fcon, len3);
+
+// 超过 kSmallSectionSize 个元素的批量插入与区间构造，排序会走到 intro_sort 之后的插入排序
+TEST(flat_set_bulk_insert_test)
+{
+  mystl::vector<int> v;
+  for (int i = 0; i < 200; ++i)
+    v.push_back((i * 7919) % 1000);  // 200 个互不相同的无序元素
+  mystl::set<int> expect(v.begin(), v.end());
+  mystl::flat_set<int> s1(v.begin(), v.end());
+  EXPECT_EQ(expect.size(), s1.size());
+  EXPECT_CON_EQ(expect, s1);
+
+  mystl::vector<int> w;
+  for (int i = 0; i < 600; ++i)
+    w.push_back((i * 37) % 257);     // 含大量重复元素
+  mystl::flat_set<int> s2{ -3, 5, 1000 };
+  s2.insert(w.begin(), w.end());
+  mystl::set<int> expect2{ -3, 5, 1000 };
+  expect2.insert(w.begin(), w.end());
+  EXPECT_EQ(expect2.size(), s2.size());
+  EXPECT_CON_EQ(expect2, s2);
+
+  mystl::flat_set<int> s3(w.begin(), w.end());
+  mystl::set<int> expect3(w.begin(), w.end());
+  EXPECT_EQ(expect3.size(), s3.size());
+  EXPECT_CON_EQ(expect3, s3);
+}
+
+void flat_set_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[---------------- Run container test : flat_set ----------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int a[] = { 5,4,3,2,1 };
+  int b[] = { 1,3,5,7,9 };
+  mystl::flat_set<int> s1;
+  mystl::flat_set<int, mystl::greater<int>> s2;
+  mystl::flat_set<int> s3(a, a + 5);
+  mystl::flat_set<int> s4(a, a + 5);
+  mystl::flat_set<int> s5(s3);
+  mystl::flat_set<int> s6(std::move(s3));
+  mystl::flat_set<int> s7;
+  s7 = s4;
+  mystl::flat_set<int> s8;
+  s8 = std::move(s4);
+  mystl::flat_set<int> s9{ 1,2,3,4,5 };
+  mystl::flat_set<int> s10;
+  s10 = { 1,2,3,4,5 };
+  mystl::flat_set<int> s11(mystl::sorted_unique, b, b + 5);
+
+  for (int i = 5; i > 0; --i)
+  {
+    FUN_AFTER(s1, s1.emplace(i));
+  }
+  FUN_AFTER(s1, s1.emplace_hint(s1.begin(), 0));
+  FUN_AFTER(s1, s1.erase(s1.begin()));
+  FUN_AFTER(s1, s1.erase(0));
+  FUN_AFTER(s1, s1.erase(1));
+  FUN_AFTER(s1, s1.erase(s1.begin(), s1.end()));
+  for (int i = 0; i < 5; ++i)
+  {
+    FUN_AFTER(s1, s1.insert(i));
+  }
+  FUN_AFTER(s1, s1.insert(a, a + 5));
+  FUN_AFTER(s1, s1.insert(5));
+  FUN_AFTER(s1, s1.insert(s1.end(), 5));
+  FUN_AFTER(s1, s1.insert({ 8,6,3,8,-1 }));
+  FUN_AFTER(s11, s11.insert(mystl::sorted_unique, a + 3, a + 5));
+  FUN_AFTER(s11, s11.insert(mystl::sorted_unique, s1.find(6), s1.end()));
+  FUN_VALUE(s1.count(5));
+  FUN_VALUE(*s1.find(3));
+  FUN_VALUE(*s1.lower_bound(3));
+  FUN_VALUE(*s1.upper_bound(3));
+  auto first = *s1.equal_range(3).first;
+  auto second = *s1.equal_range(3).second;
+  std::cout << " s1.equal_range(3) : from " << first << " to " << second << std::endl;
+  FUN_AFTER(s1, s1.erase(s1.begin()));
+  FUN_AFTER(s1, s1.erase(1));
+  FUN_AFTER(s1, s1.erase(s1.begin(), s1.find(3)));
+  FUN_AFTER(s1, s1.clear());
+  FUN_AFTER(s1, s1.swap(s5));
+  FUN_VALUE(*s1.begin());
+  FUN_VALUE(*s1.rbegin());
+  std::cout << std::boolalpha;
+  FUN_VALUE(s1.empty());
+  FUN_VALUE(s1.contains(3));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(s1.size());
+  FUN_VALUE(s1.max_size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|    build + count    |";
+#if LARGER_TEST_DATA_ON
+  FLAT_SET_TEST(mystl::set<int>, "|     mystl::set      |",
+                mystl::flat_set<int>, "|   mystl::flat_set   |", SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+  FLAT_SET_TEST(mystl::set<int>, "|     mystl::set      |",
+                mystl::flat_set<int>, "|   mystl::flat_set   |", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[---------------- End container test : flat_set ----------------]" << std::endl;
+}
+
+} // namespace flat_set_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_SET_TEST_H_
+
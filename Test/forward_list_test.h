@@ -0,0 +1,201 @@
+#ifndef MYTINYSTL_FORWARD_LIST_TEST_H_
+#define MYTINYSTL_FORWARD_LIST_TEST_H_
+
+// forward_list test : 测试 forward_list 的接口与 push_front, sort 的性能
+
+#include <forward_list>
+
+#include "../MyTinySTL/forward_list.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace forward_list_test
+{
+
+// 一个辅助测试函数
+bool is_odd(int x) { return x & 1; }
+
+TEST(forward_list_sort_exception_test)
+{
+  // comp 在 sort、merge 中途抛出异常后，所有元素都要还在链表中
+  for (int limit : { 1, 10, 100, 1000, 5000 })
+  {
+    mystl::forward_list<int> l;
+    long long sum = 0;
+    for (int i = 0; i < 2000; ++i)
+    {
+      l.push_front((i * 7919) % 2000);
+      sum += (i * 7919) % 2000;
+    }
+    int calls = 0;
+    int stop = limit;
+    auto comp = [&calls, &stop](int a, int b) {
+      if (++calls == stop)
+        throw 1;
+      return a < b;
+    };
+    bool thrown = false;
+    try
+    {
+      l.sort(comp);
+    }
+    catch (int)
+    {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(2000, mystl::distance(l.begin(), l.end()));
+    long long got = 0;
+    for (auto v : l)
+      got += v;
+    EXPECT_EQ(sum, got);
+
+    // merge 两个有序链表时抛出异常，x 的元素都移入 l
+    l.sort();
+    mystl::forward_list<int> x;
+    for (int i = 499; i >= 0; --i)
+    {
+      x.push_front(3 * i);
+      sum += 3 * i;
+    }
+    calls = 0;
+    stop = limit % 700 + 1;
+    thrown = false;
+    try
+    {
+      l.merge(x, comp);
+    }
+    catch (int)
+    {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_TRUE(x.empty());
+    EXPECT_EQ(2500, mystl::distance(l.begin(), l.end()));
+    got = 0;
+    for (auto v : l)
+      got += v;
+    EXPECT_EQ(sum, got);
+  }
+}
+
+#define FORWARD_LIST_SORT_DO_TEST(mode, count) do {          \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  mode::forward_list<int> l;                                 \
+  char buf[10];                                              \
+  for (size_t i = 0; i < count; ++i)                         \
+    l.push_front(rand());                                    \
+  start = clock();                                           \
+  l.sort();                                                  \
+  end = clock();                                             \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define FORWARD_LIST_SORT_TEST(len1, len2, len3)             \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  FORWARD_LIST_SORT_DO_TEST(std, len1);                      \
+  FORWARD_LIST_SORT_DO_TEST(std, len2);                      \
+  FORWARD_LIST_SORT_DO_TEST(std, len3);                      \
+  std::cout << "\n|        mystl        |";                  \
+  FORWARD_LIST_SORT_DO_TEST(mystl, len1);                    \
+  FORWARD_LIST_SORT_DO_TEST(mystl, len2);                    \
+  FORWARD_LIST_SORT_DO_TEST(mystl, len3);
+
+void forward_list_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[-------------- Run container test : forward_list --------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int a[] = { 1,2,3,4,5 };
+  mystl::forward_list<int> l1;
+  mystl::forward_list<int> l2(5);
+  mystl::forward_list<int> l3(5, 1);
+  mystl::forward_list<int> l4(a, a + 5);
+  mystl::forward_list<int> l5(l2);
+  mystl::forward_list<int> l6(std::move(l2));
+  mystl::forward_list<int> l7{ 1,2,3,4,5,6,7,8,9 };
+  mystl::forward_list<int> l8;
+  l8 = l3;
+  mystl::forward_list<int> l9;
+  l9 = std::move(l3);
+  mystl::forward_list<int> l10;
+  l10 = { 1, 2, 2, 3, 5, 6, 7, 8, 9 };
+
+  FUN_AFTER(l1, l1.assign(8, 8));
+  FUN_AFTER(l1, l1.assign(a, a + 5));
+  FUN_AFTER(l1, l1.assign({ 1,2,3,4,5,6 }));
+  FUN_AFTER(l1, l1.insert_after(l1.before_begin(), 6));
+  FUN_AFTER(l1, l1.insert_after(l1.begin(), 2, 7));
+  FUN_AFTER(l1, l1.insert_after(l1.before_begin(), a, a + 5));
+  FUN_AFTER(l1, l1.insert_after(l1.begin(), { 9, 9 }));
+  FUN_AFTER(l1, l1.push_front(1));
+  FUN_AFTER(l1, l1.emplace_front(0));
+  FUN_AFTER(l1, l1.emplace_after(l1.begin(), 10));
+  FUN_AFTER(l1, l1.pop_front());
+  FUN_AFTER(l1, l1.erase_after(l1.begin()));
+  FUN_AFTER(l1, l1.erase_after(l1.before_begin(), l1.end()));
+  FUN_AFTER(l1, l1.resize(10));
+  FUN_AFTER(l1, l1.resize(5, 1));
+  FUN_AFTER(l1, l1.resize(8, 2));
+  FUN_AFTER(l1, l1.reserve(16));
+  FUN_AFTER(l1, l1.splice_after(l1.before_begin(), l4));
+  FUN_AFTER(l1, l1.splice_after(l1.begin(), l5, l5.before_begin()));
+  FUN_AFTER(l1, l1.splice_after(l1.before_begin(), l6, l6.before_begin(), l6.end()));
+  FUN_AFTER(l1, l1.remove(0));
+  FUN_AFTER(l1, l1.remove_if(is_odd));
+  FUN_AFTER(l1, l1.assign({ 9,5,3,3,7,1,3,2,2,0,10 }));
+  FUN_AFTER(l1, l1.sort());
+  FUN_AFTER(l1, l1.unique());
+  FUN_AFTER(l1, l1.unique([&](int a, int b) {return b == a + 1; }));
+  FUN_AFTER(l1, l1.merge(l7));
+  FUN_AFTER(l1, l1.sort(mystl::greater<int>()));
+  FUN_AFTER(l1, l1.merge(l8, mystl::greater<int>()));
+  FUN_AFTER(l1, l1.reverse());
+  FUN_AFTER(l1, l1.clear());
+  FUN_AFTER(l1, l1.swap(l9));
+  FUN_VALUE(*l1.begin());
+  FUN_VALUE(l1.front());
+  std::cout << std::boolalpha;
+  FUN_VALUE(l1.empty());
+  std::cout << std::noboolalpha;
+  FUN_VALUE(l1.max_size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|     push_front      |";
+#if LARGER_TEST_DATA_ON
+  CON_TEST_P1(forward_list<int>, push_front, rand(), SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+  CON_TEST_P1(forward_list<int>, push_front, rand(), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|         sort        |";
+#if LARGER_TEST_DATA_ON
+  FORWARD_LIST_SORT_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+  FORWARD_LIST_SORT_TEST(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[-------------- End container test : forward_list --------------]" << std::endl;
+}
+
+} // namespace forward_list_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_FORWARD_LIST_TEST_H_
+
@@ -0,0 +1,208 @@
+#ifndef MYTINYSTL_INTERVAL_MAP_TEST_H_
+#define MYTINYSTL_INTERVAL_MAP_TEST_H_
+
+// interval_map test : 测试 interval_map 的接口与它相对于在 multimap 中顺序扫描的点查询性能
+
+#include "../MyTinySTL/map.h"
+#include "../MyTinySTL/interval_map.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace interval_map_test
+{
+
+// pair 的宏定义，键值类型与其它 map 的测试不同，因此使用不同的宏名
+#define IPAIR    mystl::pair<mystl::interval<int>, int>
+#define IV(l, h) mystl::interval<int>(l, h)
+
+// map 的遍历输出
+#define IMAP_COUT(m) do { \
+    std::string m_name = #m; \
+    std::cout << " " << m_name << " :"; \
+    for (auto& it : m)    std::cout << " <[" << it.first.low << "," << it.first.high << "]," << it.second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// map 的函数操作
+#define IMAP_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    IMAP_COUT(con); \
+} while(0)
+
+// map 的函数值
+#define IMAP_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : <[" << it.first.low << "," << it.first.high << "]," << it.second << ">\n"; \
+} while(0)
+
+// 区间查询的输出
+#define QUERY_COUT(m, fun, arg) do { \
+    std::string str = #m "." #fun "(" #arg ")"; \
+    mystl::interval_map<int, int>::const_iterator out[16]; \
+    auto last = m.fun(arg, out); \
+    std::cout << " " << str << " :"; \
+    for (auto p = out; p != last; ++p) \
+      std::cout << " <[" << (*p)->first.low << "," << (*p)->first.high << "]," << (*p)->second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// 每轮性能测试的查询次数
+#define STAB_QUERY_COUNT 1000
+
+// 以左端点为键存入 multimap，查询时顺序扫描所有左端点不大于查询点的区间
+class scanned_intervals
+{
+public:
+  void   insert(int low, int high) { map_.emplace(low, high); }
+  size_t stab(int point) const
+  {
+    size_t n = 0;
+    for (auto it = map_.begin(), last = map_.upper_bound(point); it != last; ++it)
+      n += it->second >= point;
+    return n;
+  }
+
+private:
+  mystl::multimap<int, int> map_;
+};
+
+// 供性能测试使用，接口与 scanned_intervals 一致
+class tree_intervals
+{
+public:
+  void   insert(int low, int high) { map_.emplace(mystl::interval<int>(low, high), 0); }
+  size_t stab(int point) const
+  {
+    counter c;
+    return map_.stab(point, c).n;
+  }
+
+private:
+  struct counter
+  {
+    size_t n = 0;
+    counter& operator*()  { return *this; }
+    counter& operator++() { return *this; }
+    template <class Iter>
+    counter& operator=(const Iter&) { ++n; return *this; }
+  };
+
+  mystl::interval_map<int, int> map_;
+};
+
+// 插入 len 个长度不超过 1000 的随机区间，再做 STAB_QUERY_COUNT 次点查询，只统计查询的时间
+#define INTERVAL_MAP_DO_TEST(con, len) do {                  \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  con c;                                                     \
+  for (size_t i = 0; i < len; ++i)                           \
+  {                                                          \
+    int low = rand();                                        \
+    c.insert(low, low + rand() % 1000);                      \
+  }                                                          \
+  size_t found = 0;                                          \
+  start = clock();                                           \
+  for (size_t i = 0; i < STAB_QUERY_COUNT; ++i)              \
+    found += c.stab(rand());                                 \
+  end = clock();                                             \
+  volatile size_t sink = found; (void)sink;                  \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define INTERVAL_MAP_TEST(con, name, icon, iname, len1, len2, len3) \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << name;                                         \
+  INTERVAL_MAP_DO_TEST(con, len1);                           \
+  INTERVAL_MAP_DO_TEST(con, len2);                           \
+  INTERVAL_MAP_DO_TEST(con, len3);                           \
+  std::cout << "\n" << iname;                                \
+  INTERVAL_MAP_DO_TEST(icon, len1);                          \
+  INTERVAL_MAP_DO_TEST(icon, len2);                          \
+  INTERVAL_MAP_DO_TEST(icon, len3);
+
+void interval_map_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[-------------- Run container test : interval_map --------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  mystl::vector<IPAIR> v;
+  for (int i = 0; i < 5; ++i)
+    v.push_back(IPAIR(IV(i, i * 2), i));
+  mystl::interval_map<int, int> m1;
+  mystl::interval_map<int, int> m2(v.begin(), v.end());
+  mystl::interval_map<int, int> m3{ IPAIR(IV(1,4),1),IPAIR(IV(6,9),2),IPAIR(IV(2,3),3) };
+  mystl::interval_map<int, int> m4(m3);
+  mystl::interval_map<int, int> m5(mystl::move(m4));
+  mystl::interval_map<int, int> m6;
+  m6 = m3;
+
+  IMAP_FUN_AFTER(m1, m1.emplace(IV(5, 8), 1));
+  IMAP_FUN_AFTER(m1, m1.emplace(IV(1, 3), 2));
+  IMAP_FUN_AFTER(m1, m1.insert(IPAIR(IV(10, 12), 3)));
+  IMAP_FUN_AFTER(m1, m1.insert(IPAIR(IV(1, 3), 4)));
+  IMAP_FUN_AFTER(m1, m1.insert({ IPAIR(IV(0,20),5),IPAIR(IV(7,7),6),IPAIR(IV(13,15),7) }));
+  IMAP_COUT(m2);
+  IMAP_COUT(m5);
+  IMAP_COUT(m6);
+  QUERY_COUT(m1, stab, 7);
+  QUERY_COUT(m1, stab, 9);
+  QUERY_COUT(m1, stab, 21);
+  QUERY_COUT(m1, overlap, IV(3, 5));
+  QUERY_COUT(m1, overlap, IV(11, 13));
+  QUERY_COUT(m2, overlap, IV(5, 6));
+  IMAP_VALUE(*m1.find_overlap(IV(9, 9)));
+  IMAP_VALUE(*m1.find(IV(10, 12)));
+  IMAP_VALUE(*m1.lower_bound(IV(1, 4)));
+  IMAP_VALUE(*m1.upper_bound(IV(1, 3)));
+  FUN_VALUE(m1.count(IV(1, 3)));
+  IMAP_FUN_AFTER(m1, m1.erase(IV(1, 3)));
+  IMAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+  QUERY_COUT(m1, stab, 9);
+  IMAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(IV(13, 15))));
+  IMAP_FUN_AFTER(m1, m1.swap(m3));
+  IMAP_FUN_AFTER(m3, m3.find(IV(13, 15))->second = 0);
+  IMAP_FUN_AFTER(m1, m1.clear());
+  std::cout << std::boolalpha;
+  FUN_VALUE(m1.empty());
+  FUN_VALUE((m1.find_overlap(IV(0, 100)) == m1.end()));
+  FUN_VALUE((m5 == m6));
+  FUN_VALUE((m2 != m6));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(m2.size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|   1000 stab query   |";
+#if LARGER_TEST_DATA_ON
+  INTERVAL_MAP_TEST(scanned_intervals, "|   mystl::multimap   |",
+                    tree_intervals, "| mystl::interval_map |", SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#else
+  INTERVAL_MAP_TEST(scanned_intervals, "|   mystl::multimap   |",
+                    tree_intervals, "| mystl::interval_map |", SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[-------------- End container test : interval_map --------------]" << std::endl;
+}
+
+} // namespace interval_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_INTERVAL_MAP_TEST_H_
+
@@ -0,0 +1,177 @@
+#ifndef MYTINYSTL_INTRUSIVE_LIST_TEST_H_
+#define MYTINYSTL_INTRUSIVE_LIST_TEST_H_
+
+// intrusive_list test : 测试 intrusive_list 的接口
+
+#include "../MyTinySTL/intrusive_list.h"
+#include "../MyTinySTL/algo.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace intrusive_list_test
+{
+
+// 一个带有 hook 的测试元素
+struct item
+{
+  int                        value;
+  mystl::intrusive_list_hook hook;
+
+  item(int v = 0) :value(v) {}
+
+  bool operator==(const item& rhs) const { return value == rhs.value; }
+  bool operator< (const item& rhs) const { return value < rhs.value; }
+  bool operator> (const item& rhs) const { return value > rhs.value; }
+};
+
+std::ostream& operator<<(std::ostream& os, const item& x)
+{
+  return os << x.value;
+}
+
+typedef mystl::intrusive_list<item, &item::hook> item_list;
+
+bool is_odd(const item& x) { return x.value & 1; }
+
+// 检查链表的大小与双向链接，并返回元素之和
+long long intrusive_list_check(const item_list& l, bool& ok)
+{
+  long long sum = 0;
+  size_t n = 0;
+  for (auto it = l.begin(); it != l.end(); ++it, ++n)
+    sum += it->value;
+  size_t back_n = 0;
+  for (auto it = l.end(); it != l.begin(); ++back_n)
+    --it;
+  ok = n == l.size() && back_n == l.size();
+  return sum;
+}
+
+TEST(intrusive_list_sort_exception_test)
+{
+  // comp 在排序中途抛出异常后，所有元素仍在链表中，大小与双向链接正确
+  static item a[2000];
+  long long sum = 0;
+  for (int i = 0; i < 2000; ++i)
+  {
+    a[i].value = (i * 7919) % 2000;
+    sum += a[i].value;
+  }
+  for (int limit : { 1, 10, 100, 1000, 5000 })
+  {
+    item_list l;
+    l.insert(l.end(), a, a + 2000);
+    int calls = 0;
+    bool thrown = false;
+    try
+    {
+      l.sort([&calls, limit](const item& x, const item& y) {
+        if (++calls == limit)
+          throw 1;
+        return x.value < y.value;
+      });
+    }
+    catch (int)
+    {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    bool ok = false;
+    EXPECT_EQ(sum, intrusive_list_check(l, ok));
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(2000u, l.size());
+    for (int i = 0; i < 2000; ++i)
+      EXPECT_TRUE(a[i].hook.is_linked());
+    l.sort();
+    EXPECT_TRUE(mystl::is_sorted(l.begin(), l.end()));
+    EXPECT_EQ(&a[0], &*l.iterator_to(a[0]));
+  }
+
+  // merge 中途抛出异常后，两个链表的大小都要与实际元素个数一致
+  item_list l1, l2;
+  for (int i = 0; i < 1000; ++i)
+    (i & 1 ? l1 : l2).push_back(a[i]);
+  l1.sort();
+  l2.sort();
+  int calls = 0;
+  bool thrown = false;
+  try
+  {
+    l1.merge(l2, [&calls](const item& x, const item& y) {
+      if (++calls == 300)
+        throw 1;
+      return x.value < y.value;
+    });
+  }
+  catch (int)
+  {
+    thrown = true;
+  }
+  EXPECT_TRUE(thrown);
+  bool ok1 = false, ok2 = false;
+  const long long s1 = intrusive_list_check(l1, ok1);
+  const long long s2 = intrusive_list_check(l2, ok2);
+  EXPECT_TRUE(ok1);
+  EXPECT_TRUE(ok2);
+  EXPECT_EQ(1000u, l1.size() + l2.size());
+  long long expect = 0;
+  for (int i = 0; i < 1000; ++i)
+    expect += a[i].value;
+  EXPECT_EQ(expect, s1 + s2);
+}
+
+void intrusive_list_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------- Run container test : intrusive_list -------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  item a[] = { 9,5,3,3,7,1,3,2,2,0,10 };
+  item b[] = { 1,2,3,4,5 };
+  item_list l1;
+  item_list l2;
+  item_list l3;
+
+  FUN_AFTER(l1, l1.insert(l1.end(), a, a + 11));
+  FUN_AFTER(l2, l2.insert(l2.end(), b, b + 5));
+  FUN_VALUE(l1.size());
+  FUN_AFTER(l1, l1.pop_front());
+  FUN_AFTER(l1, l1.pop_back());
+  FUN_AFTER(l1, l1.push_front(a[0]));
+  FUN_AFTER(l1, l1.push_back(a[10]));
+  FUN_AFTER(l1, l1.erase(a[4]));
+  FUN_AFTER(l1, l1.insert(l1.iterator_to(a[5]), a[4]));
+  FUN_AFTER(l1, l1.splice(l1.begin(), l1, l1.iterator_to(a[10])));
+  FUN_AFTER(l1, l1.sort());
+  FUN_AFTER(l1, l1.unique());
+  FUN_AFTER(l1, l1.remove_if(is_odd));
+  FUN_AFTER(l2, l2.sort(mystl::greater<item>()));
+  FUN_AFTER(l1, l1.sort(mystl::greater<item>()));
+  FUN_AFTER(l1, l1.merge(l2, mystl::greater<item>()));
+  FUN_VALUE(l2.size());
+  FUN_AFTER(l1, l1.reverse());
+  FUN_AFTER(l3, l3.splice(l3.end(), l1, l1.begin(), l1.iterator_to(b[2])));
+  FUN_AFTER(l3, l3.swap(l1));
+  FUN_AFTER(l1, l1.erase(l1.begin(), l1.end()));
+  FUN_AFTER(l1, l1.splice(l1.end(), l3));
+  FUN_VALUE(l1.front());
+  FUN_VALUE(l1.back());
+  FUN_VALUE(*l1.rbegin());
+  std::cout << std::boolalpha;
+  FUN_VALUE(a[0].hook.is_linked());
+  FUN_VALUE(l3.empty());
+  std::cout << std::noboolalpha;
+  FUN_VALUE(l1.size());
+  FUN_AFTER(l1, l1.clear());
+  FUN_AFTER(l2, l2 = mystl::move(l3));
+  PASSED;
+  std::cout << "[------------- End container test : intrusive_list -------------]" << std::endl;
+}
+
+} // namespace intrusive_list_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_INTRUSIVE_LIST_TEST_H_
+
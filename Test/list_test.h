@@ -4,6 +4,7 @@
 // list test : 测试 list 的接口与 insert, sort 的性能
 
 #include <list>
+#include <thread>
 
 #include "../MyTinySTL/list.h"
 #include "test.h"
@@ -18,6 +19,167 @@ namespace list_test
 // 一个辅助测试函数
 bool is_odd(int x) { return x & 1; }
 
+TEST(list_node_pool_test)
+{
+  // 多轮分配、释放后复用节点，内容与大小都要正确
+  std::list<int> expect;
+  mystl::list<int> l;
+  for (int round = 0; round < 20; ++round)
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      l.push_back(i * round);
+      expect.push_back(i * round);
+    }
+    for (int i = 0; i < 700; ++i)
+    {
+      l.pop_front();
+      expect.pop_front();
+    }
+    l.reserve(500);
+  }
+  EXPECT_EQ(expect.size(), l.size());
+  EXPECT_CON_EQ(expect, l);
+  l.clear();
+#if LIST_USE_NODE_POOL
+  typedef mystl::node_pool<mystl::list_node<int>> pool;
+  const auto chunks = pool::chunk_count();
+#endif
+  for (int round = 0; round < 20; ++round)
+  {
+    // 节点在本线程分配，在其他线程释放
+    mystl::list<int> produced;
+    for (int i = 0; i < 2000; ++i)
+      produced.push_back(i + round);
+    long long sum = 0;
+    std::thread consumer([&sum](mystl::list<int> lst) {
+      for (auto x : lst)
+        sum += x;
+    }, mystl::move(produced));
+    consumer.join();
+    EXPECT_EQ(1999000LL + 2000LL * round, sum);
+  }
+#if LIST_USE_NODE_POOL
+  // 其他线程释放的节点会回到本线程的池中，不会一直申请新的内存块
+  EXPECT_TRUE(pool::chunk_count() <= chunks + 20);
+  const auto steady = pool::chunk_count();
+  for (int round = 0; round < 20; ++round)
+  {
+    mystl::list<int> produced(2000, round);
+    std::thread consumer([](mystl::list<int> lst) { lst.clear(); }, mystl::move(produced));
+    consumer.join();
+  }
+  EXPECT_EQ(steady, pool::chunk_count());
+#endif
+  // 节点在其他线程分配，那个线程结束后才在本线程释放
+  mystl::list<int> adopted;
+  std::thread producer([&adopted] {
+    mystl::list<int> lst;
+    for (int i = 0; i < 3000; ++i)
+      lst.push_back(i);
+    adopted.swap(lst);
+  });
+  producer.join();
+  EXPECT_EQ(3000u, adopted.size());
+  EXPECT_EQ(0, adopted.front());
+  EXPECT_EQ(2999, adopted.back());
+}
+
+TEST(list_sort_exception_test)
+{
+  // comp 在排序中途抛出异常后，list 的大小、双向链接与元素都要保持正确
+  for (int limit : { 1, 10, 100, 1000, 5000 })
+  {
+    mystl::list<int> l;
+    long long sum = 0;
+    for (int i = 0; i < 2000; ++i)
+    {
+      l.push_back((i * 7919) % 2000);
+      sum += (i * 7919) % 2000;
+    }
+    int calls = 0;
+    bool thrown = false;
+    try
+    {
+      l.sort([&calls, limit](int a, int b) {
+        if (++calls == limit)
+          throw 1;
+        return a < b;
+      });
+    }
+    catch (int)
+    {
+      thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(2000u, l.size());
+    EXPECT_EQ(2000, mystl::distance(l.begin(), l.end()));
+    size_t back_count = 0;
+    long long back_sum = 0;
+    for (auto it = l.rbegin(); it != l.rend(); ++it)
+    {
+      ++back_count;
+      back_sum += *it;
+    }
+    EXPECT_EQ(2000u, back_count);
+    EXPECT_EQ(sum, back_sum);
+    l.sort();
+    EXPECT_TRUE(mystl::is_sorted(l.begin(), l.end()));
+  }
+}
+
+// pointer_sort 的结果要有序、稳定，并保持大小与双向链接正确
+template <class Compared>
+void list_pointer_sort_check(size_t n, Compared comp)
+{
+  // first 为键值，有大量重复，second 记录原来的顺序
+  mystl::list<mystl::pair<int, int>> l;
+  for (size_t i = 0; i < n; ++i)
+    l.push_back(mystl::make_pair(static_cast<int>((i * 7919) % 97), static_cast<int>(i)));
+  l.pointer_sort([comp](const mystl::pair<int, int>& a, const mystl::pair<int, int>& b) {
+    return comp(a.first, b.first);
+  });
+  EXPECT_EQ(n, l.size());
+  size_t count = 0;
+  bool sorted = true;
+  bool stable = true;
+  auto prev = l.begin();
+  for (auto it = l.begin(); it != l.end(); prev = it, ++it, ++count)
+  {
+    if (it == l.begin())
+      continue;
+    if (comp(it->first, prev->first))
+      sorted = false;
+    else if (!comp(prev->first, it->first) && prev->second > it->second)
+      stable = false;
+  }
+  EXPECT_EQ(n, count);
+  EXPECT_TRUE(sorted);
+  EXPECT_TRUE(stable);
+  size_t back_count = 0;
+  bool linked = true;
+  for (auto it = l.end(); it != l.begin(); ++back_count)
+  {
+    auto next = it;
+    --it;
+    auto fwd = it;
+    if (++fwd != next)
+      linked = false;
+  }
+  EXPECT_EQ(n, back_count);
+  EXPECT_TRUE(linked);
+}
+
+TEST(list_pointer_sort_test)
+{
+  // 超过 32 个元素才会用到分段合并
+  for (size_t n : { 2, 31, 32, 33, 64, 100, 2000 })
+  {
+    list_pointer_sort_check(n, mystl::less<int>());
+    list_pointer_sort_check(n, mystl::greater<int>());
+  }
+}
+
 void list_test()
 {
   std::cout << "[===============================================================]" << std::endl;
@@ -58,6 +220,7 @@ void list_test()
   FUN_AFTER(l1, l1.resize(10));
   FUN_AFTER(l1, l1.resize(5, 1));
   FUN_AFTER(l1, l1.resize(8, 2));
+  FUN_AFTER(l1, l1.reserve(16));
   FUN_VALUE(l1.size());
   FUN_AFTER(l1, l1.splice(l1.end(), l4));
   FUN_AFTER(l1, l1.splice(l1.begin(), l5, l5.begin()));
@@ -74,6 +237,8 @@ void list_test()
   FUN_AFTER(l1, l1.merge(l7));
   FUN_AFTER(l1, l1.sort(mystl::greater<int>()));
   FUN_AFTER(l1, l1.merge(l8, mystl::greater<int>()));
+  FUN_AFTER(l1, l1.pointer_sort());
+  FUN_AFTER(l1, l1.pointer_sort(mystl::greater<int>()));
   FUN_AFTER(l1, l1.reverse());
   FUN_AFTER(l1, l1.clear());
   FUN_AFTER(l1, l1.swap(l9));
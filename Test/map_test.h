@@ -5,6 +5,7 @@
 
 #include <map>
 
+#include "../MyTinySTL/astring.h"
 #include "../MyTinySTL/map.h"
 #include "../MyTinySTL/vector.h"
 #include "test.h"
@@ -42,6 +43,46 @@ namespace map_test
     std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
 } while(0)
 
+// 由区间构造的结果需要与逐个插入的结果一致，包括键值相等的元素的先后顺序
+template <class Map>
+bool map_range_build_check(const mystl::vector<PAIR>& v)
+{
+  Map a(v.begin(), v.end());
+  Map b;
+  for (auto& x : v)
+    b.insert(x);
+  if (a.size() != b.size() || !(a == b))
+    return false;
+  for (int i = -5; i < 5; ++i)
+  {
+    a.insert(PAIR(i * 37, i));
+    b.insert(PAIR(i * 37, i));
+  }
+  a.erase(a.begin());
+  b.erase(b.begin());
+  return a.size() == b.size() && a == b;
+}
+
+TEST(map_range_build_test)
+{
+  for (int n : { 0, 1, 2, 3, 7, 8, 100, 1000, 1025 })
+  {
+    mystl::vector<PAIR> sorted, dup, unsorted;
+    for (int i = 0; i < n; ++i)
+    {
+      sorted.push_back(PAIR(i * 2, i));
+      dup.push_back(PAIR(i / 3, i));
+      unsorted.push_back(PAIR((i * 7919) % (n + 1), i));
+    }
+    EXPECT_TRUE((map_range_build_check<mystl::map<int, int>>(sorted)));
+    EXPECT_TRUE((map_range_build_check<mystl::map<int, int>>(dup)));
+    EXPECT_TRUE((map_range_build_check<mystl::map<int, int>>(unsorted)));
+    EXPECT_TRUE((map_range_build_check<mystl::multimap<int, int>>(sorted)));
+    EXPECT_TRUE((map_range_build_check<mystl::multimap<int, int>>(dup)));
+    EXPECT_TRUE((map_range_build_check<mystl::multimap<int, int>>(unsorted)));
+  }
+}
+
 void map_test()
 {
   std::cout << "[===============================================================]" << std::endl;
@@ -62,6 +103,10 @@ void map_test()
   m8 = std::move(m4);
   mystl::map<int, int> m9{ PAIR(1,1),PAIR(3,2),PAIR(2,3) };
   mystl::map<int, int> m10;
+  mystl::map<int, int> m11{ PAIR(2,0),PAIR(4,4) };
+  mystl::map<int, int> m12{ PAIR(1,0),PAIR(2,0),PAIR(4,0) };
+  mystl::map<int, int> m13{ PAIR(4,0) };
+  mystl::map<mystl::string, int, mystl::less<>> m14;
   m10 = { PAIR(1,1),PAIR(3,2),PAIR(2,3) };
 
   for (int i = 5; i > 0; --i)
@@ -69,6 +114,9 @@ void map_test()
     MAP_FUN_AFTER(m1, m1.emplace(i, i));
   }
   MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 0, 0));
+  MAP_FUN_AFTER(m1, m1.try_emplace(1, 9));
+  MAP_FUN_AFTER(m1, m1.try_emplace(7, 7));
+  MAP_FUN_AFTER(m1, m1.insert_or_assign(7, 8));
   MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
   MAP_FUN_AFTER(m1, m1.erase(0));
   MAP_FUN_AFTER(m1, m1.erase(1));
@@ -83,6 +131,13 @@ void map_test()
   MAP_VALUE(*m1.find(3));
   MAP_VALUE(*m1.lower_bound(3));
   MAP_VALUE(*m1.upper_bound(2));
+  MAP_VALUE(*m1.nth(2));
+  FUN_VALUE(m1.rank(3));
+  MAP_FUN_AFTER(m14, m14.emplace("/api", 1));
+  MAP_FUN_AFTER(m14, m14.emplace("/health", 2));
+  MAP_VALUE(*m14.find("/health"));
+  MAP_VALUE(*m14.lower_bound("/b"));
+  FUN_VALUE(m14.count("/none"));
   auto first = *m1.equal_range(2).first;
   auto second = *m1.equal_range(2).second;
   std::cout << " m1.equal_range(2) : from <" << first.first << ", " << first.second
@@ -92,6 +147,13 @@ void map_test()
   MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(3)));
   MAP_FUN_AFTER(m1, m1.clear());
   MAP_FUN_AFTER(m1, m1.swap(m9));
+  MAP_FUN_AFTER(m1, m1.split(2, m7));
+  MAP_FUN_AFTER(m1, m1.join(m7));
+  MAP_FUN_AFTER(m1, m1.union_with(m11));
+  MAP_FUN_AFTER(m1, m1.intersection_with(m12));
+  MAP_FUN_AFTER(m1, m1.difference_with(m13));
+  MAP_FUN_AFTER(m1, m1.merge(m10));
+  MAP_FUN_AFTER(m12, m12.insert(m1.extract(3)));
   MAP_VALUE(*m1.begin());
   MAP_VALUE(*m1.rbegin());
   FUN_VALUE(m1[1]);
@@ -161,6 +223,8 @@ void multimap_test()
   MAP_VALUE(*m1.find(3));
   MAP_VALUE(*m1.lower_bound(3));
   MAP_VALUE(*m1.upper_bound(2));
+  MAP_VALUE(*m1.nth(2));
+  FUN_VALUE(m1.rank(3));
   auto first = *m1.equal_range(2).first;
   auto second = *m1.equal_range(2).second;
   std::cout << " m1.equal_range(2) : from <" << first.first << ", " << first.second
@@ -170,6 +234,10 @@ void multimap_test()
   MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(3)));
   MAP_FUN_AFTER(m1, m1.clear());
   MAP_FUN_AFTER(m1, m1.swap(m9));
+  MAP_FUN_AFTER(m1, m1.split(2, m7));
+  MAP_FUN_AFTER(m1, m1.join(m7));
+  MAP_FUN_AFTER(m1, m1.merge(m10));
+  MAP_FUN_AFTER(m10, m10.insert(m1.extract(3)));
   MAP_FUN_AFTER(m1, m1.insert(PAIR(3, 3)));
   MAP_VALUE(*m1.begin());
   MAP_VALUE(*m1.rbegin());
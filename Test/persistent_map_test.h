@@ -0,0 +1,181 @@
+#ifndef MYTINYSTL_PERSISTENT_MAP_TEST_H_
+#define MYTINYSTL_PERSISTENT_MAP_TEST_H_
+
+// persistent_map test : 测试 persistent_map 的接口与它相对于复制整个 map 取快照的性能
+
+#include "../MyTinySTL/map.h"
+#include "../MyTinySTL/persistent_map.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace persistent_map_test
+{
+
+// pair 的宏定义
+#define PAIR    mystl::pair<int, int>
+
+// map 的遍历输出
+#define MAP_COUT(m) do { \
+    std::string m_name = #m; \
+    std::cout << " " << m_name << " :"; \
+    for (auto it : m)    std::cout << " <" << it.first << "," << it.second << ">"; \
+    std::cout << std::endl; \
+} while(0)
+
+// map 的函数操作
+#define MAP_FUN_AFTER(con, fun) do { \
+    std::string str = #fun; \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun; \
+    MAP_COUT(con); \
+} while(0)
+
+// map 的函数值
+#define MAP_VALUE(fun) do { \
+    std::string str = #fun; \
+    auto it = fun; \
+    std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
+} while(0)
+
+// 快照的次数
+#define SNAPSHOT_COUNT 100
+
+// 就地修改 map，取快照时复制整个 map
+class copied_map
+{
+public:
+  void update(int key)              { map_.insert_or_assign(key, key); }
+  mystl::map<int, int> snapshot()   const { return map_; }
+
+private:
+  mystl::map<int, int> map_;
+};
+
+// 每次修改生成新版本，取快照时只复制根节点
+class versioned_map
+{
+public:
+  void update(int key)                        { map_ = map_.insert_or_assign(key, key); }
+  mystl::persistent_map<int, int> snapshot()  const { return map_; }
+
+private:
+  mystl::persistent_map<int, int> map_;
+};
+
+// 做 len 次随机更新，期间均匀地取 SNAPSHOT_COUNT 次快照
+#define PERSISTENT_MAP_DO_TEST(con, len) do {                \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  con c;                                                     \
+  const size_t step = len / SNAPSHOT_COUNT;                  \
+  start = clock();                                           \
+  for (size_t i = 0; i < len; ++i)                           \
+  {                                                          \
+    c.update(rand());                                        \
+    if ((i + 1) % step == 0)                                 \
+    {                                                        \
+      auto snap = c.snapshot();                              \
+      volatile size_t sink = snap.size(); (void)sink;        \
+    }                                                        \
+  }                                                          \
+  end = clock();                                             \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define PERSISTENT_MAP_TEST(con, name, pcon, pname, len1, len2, len3) \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << name;                                         \
+  PERSISTENT_MAP_DO_TEST(con, len1);                         \
+  PERSISTENT_MAP_DO_TEST(con, len2);                         \
+  PERSISTENT_MAP_DO_TEST(con, len3);                         \
+  std::cout << "\n" << pname;                                \
+  PERSISTENT_MAP_DO_TEST(pcon, len1);                        \
+  PERSISTENT_MAP_DO_TEST(pcon, len2);                        \
+  PERSISTENT_MAP_DO_TEST(pcon, len3);
+
+void persistent_map_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------- Run container test : persistent_map -------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  mystl::vector<PAIR> v;
+  for (int i = 0; i < 5; ++i)
+    v.push_back(PAIR(i, i));
+  mystl::persistent_map<int, int> m1;
+  mystl::persistent_map<int, int, mystl::greater<int>> m2(v.begin(), v.end());
+  mystl::persistent_map<int, int> m3(v.begin(), v.end());
+  mystl::persistent_map<int, int> m4(m3);
+  mystl::persistent_map<int, int> m5(std::move(m4));
+  mystl::persistent_map<int, int> m6{ PAIR(1,1),PAIR(3,2),PAIR(2,3),PAIR(3,3) };
+  mystl::persistent_map<int, int> m7;
+  m7 = m3;
+
+  for (int i = 5; i > 0; --i)
+  {
+    MAP_FUN_AFTER(m1, m1 = m1.insert(PAIR(i, i)));
+  }
+  // 旧版本不受修改的影响
+  mystl::persistent_map<int, int> old = m1;
+  MAP_FUN_AFTER(m1, m1 = m1.insert(PAIR(3, 0)));
+  MAP_FUN_AFTER(m1, m1 = m1.insert_or_assign(3, 0));
+  MAP_FUN_AFTER(m1, m1 = m1.insert_or_assign(9, 9));
+  MAP_FUN_AFTER(m1, m1 = m1.erase(1));
+  MAP_FUN_AFTER(m1, m1 = m1.erase(7));
+  MAP_COUT(old);
+  MAP_COUT(m2);
+  FUN_VALUE(m1.count(1));
+  FUN_VALUE(m1.at(3));
+  MAP_VALUE(*m1.find(4));
+  MAP_VALUE(*m1.lower_bound(6));
+  MAP_VALUE(*m1.upper_bound(4));
+  auto first = *m1.equal_range(4).first;
+  auto second = *m1.equal_range(4).second;
+  std::cout << " m1.equal_range(4) : from <" << first.first << ", " << first.second
+    << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+  MAP_VALUE(*m1.begin());
+  MAP_VALUE(*m1.rbegin());
+  MAP_VALUE(*--m1.end());
+  MAP_FUN_AFTER(m1, m1.swap(m6));
+  std::cout << std::boolalpha;
+  FUN_VALUE((m5 == m7));
+  FUN_VALUE(m5.shares_root_with(m7));
+  FUN_VALUE((m5.erase(0) < m5));
+  FUN_VALUE(m1.empty());
+  FUN_VALUE(m1.contains(3));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(m1.size());
+  FUN_VALUE(old.size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|update + 100 snapshot|";
+#if LARGER_TEST_DATA_ON
+  PERSISTENT_MAP_TEST(copied_map, "|   copy mystl::map   |",
+                      versioned_map, "|mystl::persistent_map|", SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#else
+  PERSISTENT_MAP_TEST(copied_map, "|   copy mystl::map   |",
+                      versioned_map, "|mystl::persistent_map|", SCALE_SS(LEN1), SCALE_SS(LEN2), SCALE_SS(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[------------- End container test : persistent_map -------------]" << std::endl;
+}
+
+} // namespace persistent_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_PERSISTENT_MAP_TEST_H_
+
@@ -6,6 +6,7 @@
 #include <set>
 
 #include "../MyTinySTL/set.h"
+#include "../MyTinySTL/vector.h"
 #include "test.h"
 
 namespace mystl
@@ -15,6 +16,115 @@ namespace test
 namespace set_test
 {
 
+// 用遍历的结果逐个检查 nth 与 rank
+template <class Set>
+bool set_order_statistic_check(const Set& s, int max_key)
+{
+  size_t k = 0;
+  for (auto it = s.begin(); it != s.end(); ++it, ++k)
+  {
+    if (s.nth(k) != it)
+      return false;
+  }
+  if (s.nth(s.size()) != s.end() || s.nth(s.size() + 10) != s.end())
+    return false;
+  for (int key = -1; key <= max_key + 1; ++key)
+  {
+    size_t r = 0;
+    for (auto it = s.begin(); it != s.end() && *it < key; ++it)
+      ++r;
+    if (s.rank(key) != r)
+      return false;
+  }
+  return true;
+}
+
+TEST(set_order_statistic_test)
+{
+  mystl::set<int> s;
+  mystl::multiset<int> ms;
+  EXPECT_TRUE(set_order_statistic_check(s, 0));
+  for (int i = 0; i < 1000; ++i)
+  {
+    s.insert((i * 7919) % 1000);
+    ms.insert((i * 7919) % 300);
+  }
+  EXPECT_TRUE(set_order_statistic_check(s, 1000));
+  EXPECT_TRUE(set_order_statistic_check(ms, 300));
+
+  // 删除单个元素与区间后，子树大小也要正确
+  for (int i = 0; i < 1000; i += 3)
+    s.erase(i);
+  ms.erase(7);
+  ms.erase(ms.lower_bound(100), ms.upper_bound(150));
+  ms.erase(ms.begin());
+  EXPECT_TRUE(set_order_statistic_check(s, 1000));
+  EXPECT_TRUE(set_order_statistic_check(ms, 300));
+  EXPECT_EQ(500u, *s.nth(333));
+  EXPECT_EQ(333u, s.rank(500));
+
+  auto s2 = s;
+  s2.erase(s2.nth(10), s2.nth(600));
+  EXPECT_TRUE(set_order_statistic_check(s2, 1000));
+  s.swap(s2);
+  EXPECT_TRUE(set_order_statistic_check(s, 1000));
+  EXPECT_TRUE(set_order_statistic_check(s2, 1000));
+}
+
+// 由区间构造的结果需要与逐个插入的结果一致，并且之后仍能正常插入、删除
+template <class Set, class Iter>
+bool set_range_build_check(Iter first, Iter last)
+{
+  Set a(first, last);
+  Set b;
+  for (auto it = first; it != last; ++it)
+    b.insert(*it);
+  if (a.size() != b.size() || !(a == b))
+    return false;
+  if (!mystl::equal(a.rbegin(), a.rend(), b.rbegin()))
+    return false;
+  for (int i = -5; i < 5; ++i)
+  {
+    a.insert(i * 37);
+    b.insert(i * 37);
+  }
+  a.erase(a.begin());
+  b.erase(b.begin());
+  return a.size() == b.size() && a == b && mystl::equal(a.rbegin(), a.rend(), b.rbegin());
+}
+
+TEST(set_range_build_test)
+{
+  for (int n : { 0, 1, 2, 3, 7, 8, 100, 1000, 1025 })
+  {
+    mystl::vector<int> sorted, dup, desc, unsorted;
+    for (int i = 0; i < n; ++i)
+    {
+      sorted.push_back(i * 2);
+      dup.push_back(i / 3);
+      desc.push_back((n - i) / 3);
+      unsorted.push_back((i * 7919) % (n + 1));
+    }
+    EXPECT_TRUE(set_range_build_check<mystl::set<int>>(sorted.begin(), sorted.end()));
+    EXPECT_TRUE(set_range_build_check<mystl::set<int>>(dup.begin(), dup.end()));
+    EXPECT_TRUE(set_range_build_check<mystl::set<int>>(unsorted.begin(), unsorted.end()));
+    EXPECT_TRUE(set_range_build_check<mystl::multiset<int>>(sorted.begin(), sorted.end()));
+    EXPECT_TRUE(set_range_build_check<mystl::multiset<int>>(dup.begin(), dup.end()));
+    EXPECT_TRUE(set_range_build_check<mystl::multiset<int>>(unsorted.begin(), unsorted.end()));
+    // 按降序比较时，升序的输入不再有序
+    EXPECT_TRUE((set_range_build_check<mystl::set<int, mystl::greater<int>>>(
+      sorted.begin(), sorted.end())));
+    EXPECT_TRUE((set_range_build_check<mystl::multiset<int, mystl::greater<int>>>(
+      desc.begin(), desc.end())));
+  }
+  int a[] = { 1,1,2,3,3,3,4 };
+  mystl::set<int> s(a, a + 7);
+  mystl::multiset<int> ms(a, a + 7);
+  EXPECT_EQ(4u, s.size());
+  EXPECT_EQ(7u, ms.size());
+  EXPECT_EQ(3u, ms.count(3));
+}
+
 void set_test()
 {
   std::cout << "[===============================================================]" << std::endl;
@@ -33,6 +143,9 @@ void set_test()
   s8 = std::move(s4);
   mystl::set<int> s9{ 1,2,3,4,5 };
   mystl::set<int> s10;
+  mystl::set<int> s11{ 3,6,9 };
+  mystl::set<int> s12{ 2,3,6 };
+  mystl::set<int> s13{ 1,6 };
   s10 = { 1,2,3,4,5 };
 
   for (int i = 5; i > 0; --i)
@@ -55,6 +168,8 @@ void set_test()
   FUN_VALUE(*s1.find(3));
   FUN_VALUE(*s1.lower_bound(3));
   FUN_VALUE(*s1.upper_bound(3));
+  FUN_VALUE(*s1.nth(2));
+  FUN_VALUE(s1.rank(3));
   auto first = *s1.equal_range(3).first;
   auto second = *s1.equal_range(3).second;
   std::cout << " s1.equal_range(3) : from " << first << " to " << second << std::endl;
@@ -63,6 +178,13 @@ void set_test()
   FUN_AFTER(s1, s1.erase(s1.begin(), s1.find(3)));
   FUN_AFTER(s1, s1.clear());
   FUN_AFTER(s1, s1.swap(s5));
+  FUN_AFTER(s1, s1.split(3, s7));
+  FUN_AFTER(s1, s1.join(s7));
+  FUN_AFTER(s1, s1.union_with(s11));
+  FUN_AFTER(s1, s1.intersection_with(s12));
+  FUN_AFTER(s1, s1.difference_with(s13));
+  FUN_AFTER(s1, s1.merge(s10));
+  FUN_AFTER(s13, s13.insert(s1.extract(4)));
   FUN_VALUE(*s1.begin());
   FUN_VALUE(*s1.rbegin());
   std::cout << std::boolalpha;
@@ -127,6 +249,8 @@ void multiset_test()
   FUN_VALUE(*s1.find(3));
   FUN_VALUE(*s1.lower_bound(3));
   FUN_VALUE(*s1.upper_bound(3));
+  FUN_VALUE(*s1.nth(2));
+  FUN_VALUE(s1.rank(3));
   auto first = *s1.equal_range(3).first;
   auto second = *s1.equal_range(3).second;
   std::cout << " s1.equal_range(3) : from " << first << " to " << second << std::endl;
@@ -135,6 +259,17 @@ void multiset_test()
   FUN_AFTER(s1, s1.erase(s1.begin(), s1.find(3)));
   FUN_AFTER(s1, s1.clear());
   FUN_AFTER(s1, s1.swap(s5));
+  FUN_AFTER(s1, s1.split(3, s7));
+  FUN_AFTER(s1, s1.join(s7));
+  FUN_AFTER(s1, s1.merge(s10));
+  FUN_AFTER(s10, s10.insert(s1.extract(5)));
+  int b[40];
+  for (int i = 0; i < 40; ++i)
+    b[i] = i % 8;
+  FUN_AFTER(s1, s1.insert(b, b + 40));
+  FUN_VALUE(s1.count(3));
+  FUN_AFTER(s1, s1.erase(s1.lower_bound(2), s1.upper_bound(5)));
+  FUN_VALUE(s1.erase(6));
   FUN_VALUE(*s1.begin());
   FUN_VALUE(*s1.rbegin());
   std::cout << std::boolalpha;
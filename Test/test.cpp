@@ -12,11 +12,23 @@
 #include "algorithm_test.h"
 #include "vector_test.h"
 #include "list_test.h"
+#include "intrusive_list_test.h"
+#include "forward_list_test.h"
+#include "unrolled_list_test.h"
 #include "deque_test.h"
 #include "queue_test.h"
 #include "stack_test.h"
 #include "map_test.h"
 #include "set_test.h"
+#include "btree_map_test.h"
+#include "btree_set_test.h"
+#include "flat_map_test.h"
+#include "flat_set_test.h"
+#include "concurrent_map_test.h"
+#include "persistent_map_test.h"
+#include "interval_map_test.h"
+#include "flat_hash_map_test.h"
+#include "flat_hash_set_test.h"
 #include "unordered_map_test.h"
 #include "unordered_set_test.h"
 #include "string_test.h"
@@ -31,6 +43,9 @@ int main()
   algorithm_performance_test::algorithm_performance_test();
   vector_test::vector_test();
   list_test::list_test();
+  intrusive_list_test::intrusive_list_test();
+  forward_list_test::forward_list_test();
+  unrolled_list_test::unrolled_list_test();
   deque_test::deque_test();
   queue_test::queue_test();
   queue_test::priority_test();
@@ -39,6 +54,17 @@ int main()
   map_test::multimap_test();
   set_test::set_test();
   set_test::multiset_test();
+  btree_map_test::btree_map_test();
+  btree_map_test::btree_multimap_test();
+  btree_set_test::btree_set_test();
+  btree_set_test::btree_multiset_test();
+  flat_map_test::flat_map_test();
+  flat_set_test::flat_set_test();
+  concurrent_map_test::concurrent_map_test();
+  persistent_map_test::persistent_map_test();
+  interval_map_test::interval_map_test();
+  flat_hash_map_test::flat_hash_map_test();
+  flat_hash_set_test::flat_hash_set_test();
   unordered_map_test::unordered_map_test();
   unordered_map_test::unordered_multimap_test();
   unordered_set_test::unordered_set_test();
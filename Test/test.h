@@ -631,6 +631,44 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
   std::cout << std::setw(WIDE) << t;                         \
 } while(0)
 
+#define DEQUE_SORT_DO_TEST(mode, count) do {                 \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  mode::deque<int> d;                                        \
+  char buf[10];                                              \
+  for (size_t i = 0; i < count; ++i)                         \
+    d.push_back(rand());                                     \
+  start = clock();                                           \
+  mode::sort(d.begin(), d.end());                            \
+  end = clock();                                             \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define DEQUE_INDEX_DO_TEST(mode, count) do {                \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  mode::deque<int> d;                                        \
+  char buf[10];                                              \
+  for (size_t i = 0; i < count; ++i)                         \
+    d.push_back(rand());                                     \
+  volatile unsigned sum = 0;                                 \
+  start = clock();                                           \
+  for (size_t i = 0; i < count; ++i)                         \
+    sum = sum + static_cast<unsigned>(d[rand() % count]);    \
+  end = clock();                                             \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
 #define MAP_EMPLACE_DO_TEST(mode, con, count) do {           \
   srand((int)time(0));                                       \
   clock_t start, end;                                        \
@@ -693,6 +731,28 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
   LIST_SORT_DO_TEST(mystl, len2);                            \
   LIST_SORT_DO_TEST(mystl, len3);
 
+#define DEQUE_SORT_TEST(len1, len2, len3)                    \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  DEQUE_SORT_DO_TEST(std, len1);                             \
+  DEQUE_SORT_DO_TEST(std, len2);                             \
+  DEQUE_SORT_DO_TEST(std, len3);                             \
+  std::cout << "\n|        mystl        |";                  \
+  DEQUE_SORT_DO_TEST(mystl, len1);                           \
+  DEQUE_SORT_DO_TEST(mystl, len2);                           \
+  DEQUE_SORT_DO_TEST(mystl, len3);
+
+#define DEQUE_INDEX_TEST(len1, len2, len3)                   \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|         std         |";                    \
+  DEQUE_INDEX_DO_TEST(std, len1);                            \
+  DEQUE_INDEX_DO_TEST(std, len2);                            \
+  DEQUE_INDEX_DO_TEST(std, len3);                            \
+  std::cout << "\n|        mystl        |";                  \
+  DEQUE_INDEX_DO_TEST(mystl, len1);                          \
+  DEQUE_INDEX_DO_TEST(mystl, len2);                          \
+  DEQUE_INDEX_DO_TEST(mystl, len3);
+
 // 简单测试的宏定义
 #define TEST(testcase_name) \
   MYTINYSTL_TEST_(testcase_name)
@@ -5,6 +5,7 @@
 
 #include <unordered_map>
 
+#include "../MyTinySTL/astring.h"
 #include "../MyTinySTL/unordered_map.h"
 #include "map_test.h"
 #include "test.h"
@@ -41,9 +42,13 @@ void unordered_map_test()
   mystl::unordered_map<int, int> um13{ PAIR(1,1),PAIR(2,3),PAIR(3,3) };
   mystl::unordered_map<int, int> um14;
   um14 = { PAIR(1,1),PAIR(2,3),PAIR(3,3) };
+  mystl::unordered_map<mystl::string, int, mystl::hash<mystl::string>, mystl::equal_to<>> um15;
 
   MAP_FUN_AFTER(um1, um1.emplace(1, 1));
   MAP_FUN_AFTER(um1, um1.emplace_hint(um1.begin(), 1, 2));
+  MAP_FUN_AFTER(um1, um1.try_emplace(1, 9));
+  MAP_FUN_AFTER(um1, um1.try_emplace(7, 7));
+  MAP_FUN_AFTER(um1, um1.insert_or_assign(7, 8));
   MAP_FUN_AFTER(um1, um1.insert(PAIR(2, 2)));
   MAP_FUN_AFTER(um1, um1.insert(um1.end(), PAIR(3, 3)));
   MAP_FUN_AFTER(um1, um1.insert(v.begin(), v.end()));
@@ -60,6 +65,8 @@ void unordered_map_test()
   FUN_VALUE(um1.bucket_size(um1.bucket(5)));
   MAP_FUN_AFTER(um1, um1.clear());
   MAP_FUN_AFTER(um1, um1.swap(um7));
+  MAP_FUN_AFTER(um14, um14.insert(um1.extract(5)));
+  MAP_FUN_AFTER(um1, um1.merge(um14));
   MAP_VALUE(*um1.begin());
   FUN_VALUE(um1.at(1));
   FUN_VALUE(um1[1]);
@@ -82,14 +89,20 @@ void unordered_map_test()
   FUN_VALUE(um1.bucket_count());
   FUN_VALUE(um1.count(1));
   MAP_VALUE(*um1.find(3));
-  auto first = *um1.equal_range(3).first;
-  auto second = *um1.equal_range(3).second;
-  std::cout << " um1.equal_range(3) : from <" << first.first << ", " << first.second
-    << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+  auto range = um1.equal_range(3);
+  std::cout << " um1.equal_range(3) : from <" << range.first->first << ", " << range.first->second << "> to ";
+  // second 的位置取决于 bucket 的排列，可能是 end()
+  if (range.second != um1.end())
+    std::cout << "<" << range.second->first << ", " << range.second->second << ">" << std::endl;
+  else
+    std::cout << "end()" << std::endl;
   FUN_VALUE(um1.load_factor());
   FUN_VALUE(um1.max_load_factor());
   MAP_FUN_AFTER(um1, um1.max_load_factor(1.5f));
   FUN_VALUE(um1.max_load_factor());
+  MAP_FUN_AFTER(um15, um15.emplace("/api", 1));
+  MAP_VALUE(*um15.find("/api"));
+  FUN_VALUE(um15.count("/none"));
   PASSED;
 #if PERFORMANCE_TEST_ON
   std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -151,6 +164,8 @@ void unordered_multimap_test()
   FUN_VALUE(um1.bucket_size(um1.bucket(5)));
   MAP_FUN_AFTER(um1, um1.clear());
   MAP_FUN_AFTER(um1, um1.swap(um7));
+  MAP_FUN_AFTER(um14, um14.insert(um1.extract(5)));
+  MAP_FUN_AFTER(um1, um1.merge(um14));
   MAP_VALUE(*um1.begin());
   std::cout << std::boolalpha;
   FUN_VALUE(um1.empty());
@@ -171,10 +186,13 @@ void unordered_multimap_test()
   FUN_VALUE(um1.bucket_count());
   FUN_VALUE(um1.count(1));
   MAP_VALUE(*um1.find(3));
-  auto first = *um1.equal_range(3).first;
-  auto second = *um1.equal_range(3).second;
-  std::cout << " um1.equal_range(3) : from <" << first.first << ", " << first.second
-    << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+  auto range = um1.equal_range(3);
+  std::cout << " um1.equal_range(3) : from <" << range.first->first << ", " << range.first->second << "> to ";
+  // second 的位置取决于 bucket 的排列，可能是 end()
+  if (range.second != um1.end())
+    std::cout << "<" << range.second->first << ", " << range.second->second << ">" << std::endl;
+  else
+    std::cout << "end()" << std::endl;
   FUN_VALUE(um1.load_factor());
   FUN_VALUE(um1.max_load_factor());
   MAP_FUN_AFTER(um1, um1.max_load_factor(1.5f));
@@ -16,6 +16,38 @@ namespace test
 namespace unordered_set_test
 {
 
+TEST(unordered_set_load_factor_test)
+{
+  // max_load_factor() < 1 时逐个插入，负载因子不应超过上限，bucket 数只增不减
+  mystl::unordered_set<int> us;
+  us.max_load_factor(0.5f);
+  size_t buckets = us.bucket_count();
+  size_t grow_times = 0;
+  bool load_ok = true;
+  bool grow_ok = true;
+  for (int i = 0; i < 20000; ++i)
+  {
+    us.insert(i * 3);
+    if (us.load_factor() > us.max_load_factor())
+      load_ok = false;
+    if (us.bucket_count() != buckets)
+    {
+      if (us.bucket_count() < buckets)
+        grow_ok = false;
+      buckets = us.bucket_count();
+      ++grow_times;
+    }
+  }
+  EXPECT_TRUE(load_ok);
+  EXPECT_TRUE(grow_ok);
+  EXPECT_TRUE(grow_times < 32);
+  EXPECT_EQ(20000u, us.size());
+  size_t found = 0;
+  for (int i = 0; i < 60000; ++i)
+    found += us.count(i);
+  EXPECT_EQ(20000u, found);
+}
+
 void unordered_set_test()
 {
   std::cout << "[===============================================================]" << std::endl;
@@ -58,6 +90,8 @@ void unordered_set_test()
   FUN_VALUE(us1.bucket_size(us1.bucket(5)));
   FUN_AFTER(us1, us1.clear());
   FUN_AFTER(us1, us1.swap(us7));
+  FUN_AFTER(us14, us14.insert(us1.extract(5)));
+  FUN_AFTER(us1, us1.merge(us14));
   FUN_VALUE(*us1.begin());
   std::cout << std::boolalpha;
   FUN_VALUE(us1.empty());
@@ -76,9 +110,13 @@ void unordered_set_test()
   FUN_VALUE(us1.bucket_count());
   FUN_VALUE(us1.count(1));
   FUN_VALUE(*us1.find(3));
-  auto first = *us1.equal_range(3).first;
-  auto second = *us1.equal_range(3).second;
-  std::cout << " us1.equal_range(3) : from " << first << " to " << second << std::endl;
+  auto range = us1.equal_range(3);
+  std::cout << " us1.equal_range(3) : from " << *range.first << " to ";
+  // second 的位置取决于 bucket 的排列，可能是 end()
+  if (range.second != us1.end())
+    std::cout << *range.second << std::endl;
+  else
+    std::cout << "end()" << std::endl;
   FUN_VALUE(us1.load_factor());
   FUN_VALUE(us1.max_load_factor());
   FUN_AFTER(us1, us1.max_load_factor(1.5f));
@@ -142,6 +180,8 @@ void unordered_multiset_test()
   FUN_VALUE(us1.bucket_size(us1.bucket(5)));
   FUN_AFTER(us1, us1.clear());
   FUN_AFTER(us1, us1.swap(us7));
+  FUN_AFTER(us14, us14.insert(us1.extract(5)));
+  FUN_AFTER(us1, us1.merge(us14));
   FUN_VALUE(*us1.begin());
   std::cout << std::boolalpha;
   FUN_VALUE(us1.empty());
@@ -160,9 +200,13 @@ void unordered_multiset_test()
   FUN_VALUE(us1.bucket_count());
   FUN_VALUE(us1.count(1));
   FUN_VALUE(*us1.find(3));
-  auto first = *us1.equal_range(3).first;
-  auto second = *us1.equal_range(3).second;
-  std::cout << " us1.equal_range(3) : from " << first << " to " << second << std::endl;
+  auto range = us1.equal_range(3);
+  std::cout << " us1.equal_range(3) : from " << *range.first << " to ";
+  // second 的位置取决于 bucket 的排列，可能是 end()
+  if (range.second != us1.end())
+    std::cout << *range.second << std::endl;
+  else
+    std::cout << "end()" << std::endl;
   FUN_VALUE(us1.load_factor());
   FUN_VALUE(us1.max_load_factor());
   FUN_AFTER(us1, us1.max_load_factor(1.5f));
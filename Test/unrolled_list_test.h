@@ -0,0 +1,221 @@
+#ifndef MYTINYSTL_UNROLLED_LIST_TEST_H_
+#define MYTINYSTL_UNROLLED_LIST_TEST_H_
+
+// unrolled_list test : 测试 unrolled_list 的接口与 push_back, 遍历相对于 list 的性能
+
+#include "../MyTinySTL/list.h"
+#include "../MyTinySTL/unrolled_list.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace unrolled_list_test
+{
+
+// 一个辅助测试函数
+bool is_odd(int x) { return x & 1; }
+
+// 先 push_back count 个元素，再遍历求和，计时两者之和
+#define UNROLLED_LIST_DO_TEST(con, count) do {               \
+  srand((int)time(0));                                       \
+  clock_t start, end;                                        \
+  char buf[10];                                              \
+  start = clock();                                           \
+  con<int> l;                                                \
+  for (size_t i = 0; i < count; ++i)                         \
+    l.push_back(rand());                                     \
+  long long sum = 0;                                         \
+  for (int r = 0; r < 10; ++r)                               \
+    for (auto& x : l)                                        \
+      sum += x;                                              \
+  end = clock();                                             \
+  volatile long long sink = sum; (void)sink;                 \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+#define UNROLLED_LIST_TEST(len1, len2, len3)                 \
+  TEST_LEN(len1, len2, len3, WIDE);                          \
+  std::cout << "|     mystl::list     |";                    \
+  UNROLLED_LIST_DO_TEST(mystl::list, len1);                  \
+  UNROLLED_LIST_DO_TEST(mystl::list, len2);                  \
+  UNROLLED_LIST_DO_TEST(mystl::list, len3);                  \
+  std::cout << "\n|    unrolled_list    |";                  \
+  UNROLLED_LIST_DO_TEST(mystl::unrolled_list, len1);         \
+  UNROLLED_LIST_DO_TEST(mystl::unrolled_list, len2);         \
+  UNROLLED_LIST_DO_TEST(mystl::unrolled_list, len3);
+
+// 在各个位置插入一段元素，与 vector 比较结果，并检查返回的迭代器指向第一个插入的元素
+template <size_t N>
+void unrolled_list_range_insert_check()
+{
+  mystl::unrolled_list<int, N> ul;
+  mystl::vector<int> v;
+  int next = 0;
+  for (int round = 0; round < 60; ++round)
+  {
+    const size_t len = static_cast<size_t>((round * 7) % 23);
+    mystl::vector<int> src;
+    for (size_t i = 0; i < len; ++i)
+      src.push_back(next++);
+    const size_t at = v.empty() ? 0 : static_cast<size_t>(round * 37) % (v.size() + 1);
+    auto pos = ul.begin();
+    mystl::advance(pos, at);
+    auto r = ul.insert(pos, src.begin(), src.end());
+    v.insert(v.begin() + at, src.begin(), src.end());
+    EXPECT_EQ(v.size(), ul.size());
+    EXPECT_CON_EQ(v, ul);
+    if (len != 0)
+    {
+      EXPECT_EQ(src.front(), *r);
+      EXPECT_EQ(static_cast<ptrdiff_t>(at), mystl::distance(ul.begin(), r));
+    }
+  }
+}
+
+TEST(unrolled_list_range_insert_test)
+{
+  unrolled_list_range_insert_check<2>();
+  unrolled_list_range_insert_check<4>();
+  unrolled_list_range_insert_check<16>();
+  unrolled_list_range_insert_check<mystl::unrolled_list_block_size<int>::value>();
+}
+
+template <size_t N>
+void unrolled_list_fill_insert_check()
+{
+  mystl::unrolled_list<int, N> ul;
+  mystl::vector<int> v;
+  for (int round = 0; round < 60; ++round)
+  {
+    const size_t len = static_cast<size_t>((round * 7) % 23);
+    const size_t at = v.empty() ? 0 : static_cast<size_t>(round * 37) % (v.size() + 1);
+    auto pos = ul.begin();
+    mystl::advance(pos, at);
+    auto r = ul.insert(pos, len, round);
+    v.insert(v.begin() + at, len, round);
+    EXPECT_EQ(v.size(), ul.size());
+    EXPECT_CON_EQ(v, ul);
+    if (len != 0)
+    {
+      EXPECT_EQ(round, *r);
+      EXPECT_EQ(static_cast<ptrdiff_t>(at), mystl::distance(ul.begin(), r));
+    }
+    if (round % 5 == 4 && !v.empty())
+    { // 删除一些元素，让节点不满
+      ul.erase(ul.begin());
+      v.erase(v.begin());
+    }
+  }
+}
+
+TEST(unrolled_list_fill_insert_test)
+{
+  // 节点不满时插在节点中间，返回的迭代器仍要指向第一个新元素
+  mystl::unrolled_list<int, 4> ul{ 1,2,3,4,5,6,7,8 };
+  auto it = ul.begin();
+  mystl::advance(it, 3);
+  ul.erase(it);
+  it = ul.begin();
+  mystl::advance(it, 2);
+  auto r = ul.insert(it, 3, 99);
+  EXPECT_EQ(2, mystl::distance(ul.begin(), r));
+  int expect[] = { 1,2,99,99,99,3,5,6,7,8 };
+  EXPECT_EQ(10u, ul.size());
+  EXPECT_TRUE(mystl::equal(ul.begin(), ul.end(), expect));
+  EXPECT_TRUE(mystl::equal(r, ul.end(), expect + 2));
+
+  unrolled_list_fill_insert_check<2>();
+  unrolled_list_fill_insert_check<4>();
+  unrolled_list_fill_insert_check<16>();
+  unrolled_list_fill_insert_check<mystl::unrolled_list_block_size<int>::value>();
+}
+
+void unrolled_list_test()
+{
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------- Run container test : unrolled_list --------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int a[] = { 1,2,3,4,5 };
+  mystl::unrolled_list<int, 4> l1;
+  mystl::unrolled_list<int, 4> l2(5);
+  mystl::unrolled_list<int, 4> l3(5, 1);
+  mystl::unrolled_list<int, 4> l4(a, a + 5);
+  mystl::unrolled_list<int, 4> l5(l2);
+  mystl::unrolled_list<int, 4> l6(std::move(l2));
+  mystl::unrolled_list<int, 4> l7{ 1,2,3,4,5,6,7,8,9 };
+  mystl::unrolled_list<int, 4> l8;
+  l8 = l3;
+  mystl::unrolled_list<int, 4> l9;
+  l9 = std::move(l3);
+  mystl::unrolled_list<int, 4> l10;
+  l10 = { 1, 2, 2, 3, 5, 6, 7, 8, 9 };
+
+  FUN_AFTER(l1, l1.assign(8, 8));
+  FUN_AFTER(l1, l1.assign(a, a + 5));
+  FUN_AFTER(l1, l1.assign({ 1,2,3,4,5,6 }));
+  FUN_AFTER(l1, l1.insert(l1.end(), 6));
+  FUN_AFTER(l1, l1.insert(l1.begin(), 2, 7));
+  FUN_AFTER(l1, l1.insert(l1.begin(), a, a + 5));
+  FUN_AFTER(l1, l1.insert(l1.end(), { 9, 9 }));
+  FUN_AFTER(l1, l1.push_back(2));
+  FUN_AFTER(l1, l1.push_front(1));
+  FUN_AFTER(l1, l1.emplace(l1.begin(), 1));
+  FUN_AFTER(l1, l1.emplace_front(0));
+  FUN_AFTER(l1, l1.emplace_back(10));
+  FUN_VALUE(l1.size());
+  FUN_AFTER(l1, l1.pop_front());
+  FUN_AFTER(l1, l1.pop_back());
+  FUN_AFTER(l1, l1.erase(l1.begin()));
+  FUN_AFTER(l1, l1.erase(l1.begin(), l1.end()));
+  FUN_VALUE(l1.size());
+  FUN_AFTER(l1, l1.resize(10));
+  FUN_AFTER(l1, l1.resize(5, 1));
+  FUN_AFTER(l1, l1.resize(8, 2));
+  FUN_VALUE(l1.size());
+  FUN_AFTER(l1, l1.splice(l1.end(), l4));
+  FUN_AFTER(l1, l1.splice(++l1.begin(), l7));
+  FUN_AFTER(l1, l1.remove(0));
+  FUN_AFTER(l1, l1.remove_if(is_odd));
+  FUN_VALUE(l1.size());
+  FUN_AFTER(l1, l1.reverse());
+  FUN_AFTER(l1, l1.clear());
+  FUN_AFTER(l1, l1.swap(l9));
+  FUN_VALUE(*l1.begin());
+  FUN_VALUE(*l1.rbegin());
+  FUN_VALUE(l1.front());
+  FUN_VALUE(l1.back());
+  std::cout << std::boolalpha;
+  FUN_VALUE(l1.empty());
+  std::cout << std::noboolalpha;
+  FUN_VALUE(l1.size());
+  FUN_VALUE(l1.max_size());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|  push_back + visit  |";
+#if LARGER_TEST_DATA_ON
+  UNROLLED_LIST_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+  UNROLLED_LIST_TEST(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[------------- End container test : unrolled_list --------------]" << std::endl;
+}
+
+} // namespace unrolled_list_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_UNROLLED_LIST_TEST_H_
+